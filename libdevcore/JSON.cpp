@@ -21,10 +21,12 @@
 
 #include <libdevcore/JSON.h>
 
+#include <libdevcore/Assertions.h>
 #include <libdevcore/CommonIO.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <map>
 #include <memory>
@@ -122,5 +124,219 @@ bool jsonParseFile(string const& _fileName, Json::Value& _json, string *_errs /*
 	return jsonParse(readFileAsString(_fileName), _json, _errs);
 }
 
+// The formatting follows the stream writer of jsoncpp (BuiltStyledStreamWriter) with the
+// settings used by the functions above, which always puts each element of non-empty arrays
+// on a separate line.
+
+JsonWriter::JsonWriter(ostream& _stream, Format _format):
+	m_stream(_stream),
+	m_format(_format)
+{
+	switch (_format)
+	{
+	case Format::Compact:
+		m_colon = ":";
+		break;
+	case Format::Pretty:
+		m_indentation = "  ";
+		// The space is written lazily, see m_pendingSpace.
+		m_colon = ":";
+		break;
+	case Format::Styled:
+		m_indentation = "\t";
+		m_colon = " : ";
+		break;
+	}
+}
+
+void JsonWriter::beginObject()
+{
+	beginScope(true);
+}
+
+void JsonWriter::key(string const& _key)
+{
+	assertThrow(!m_scopes.empty() && m_scopes.back().isObject, Exception, "Key outside of object.");
+	if (m_scopes.back().empty)
+		openScope();
+	else
+		write(",");
+	writeWithIndent(quoted(_key));
+	write(m_colon);
+	if (m_format == Format::Pretty)
+		m_pendingSpace = true;
+}
+
+void JsonWriter::endObject()
+{
+	endScope(true);
+}
+
+void JsonWriter::beginArray()
+{
+	beginScope(false);
+}
+
+void JsonWriter::endArray()
+{
+	endScope(false);
+}
+
+void JsonWriter::value(Json::Value const& _value)
+{
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		beforeValue();
+		write("null");
+		afterValue();
+		break;
+	case Json::intValue:
+		beforeValue();
+		write(to_string(_value.asLargestInt()));
+		afterValue();
+		break;
+	case Json::uintValue:
+		beforeValue();
+		write(to_string(_value.asLargestUInt()));
+		afterValue();
+		break;
+	case Json::realValue:
+		beforeValue();
+		write(Json::valueToString(_value.asDouble()));
+		afterValue();
+		break;
+	case Json::stringValue:
+	{
+		string const& text = _value.asString();
+		auto replacement = m_replacements.find(text);
+		if (replacement != m_replacements.end())
+			replacement->second(*this);
+		else
+		{
+			beforeValue();
+			write(quoted(text));
+			afterValue();
+		}
+		break;
+	}
+	case Json::booleanValue:
+		beforeValue();
+		write(_value.asBool() ? "true" : "false");
+		afterValue();
+		break;
+	case Json::arrayValue:
+		beginArray();
+		for (auto const& element: _value)
+			value(element);
+		endArray();
+		break;
+	case Json::objectValue:
+		beginObject();
+		for (string const& name: _value.getMemberNames())
+		{
+			key(name);
+			value(_value[name]);
+		}
+		endObject();
+		break;
+	}
+}
+
+void JsonWriter::compactValue(string const& _json)
+{
+	assertThrow(m_format == Format::Compact, Exception, "Serialised value in a different format.");
+	beforeValue();
+	write(_json);
+	afterValue();
+}
+
+void JsonWriter::replace(string const& _placeholder, function<void(JsonWriter&)> _writeValue)
+{
+	m_replacements[_placeholder] = move(_writeValue);
+}
+
+void JsonWriter::beginScope(bool _isObject)
+{
+	beforeValue();
+	m_scopes.push_back(Scope{_isObject, true});
+}
+
+void JsonWriter::endScope(bool _isObject)
+{
+	assertThrow(!m_scopes.empty() && m_scopes.back().isObject == _isObject, Exception, "Unbalanced JSON scopes.");
+	if (m_scopes.back().empty)
+		write(_isObject ? "{}" : "[]");
+	else
+	{
+		m_indentString.resize(m_indentString.size() - m_indentation.size());
+		writeWithIndent(_isObject ? "}" : "]");
+	}
+	m_scopes.pop_back();
+	afterValue();
+}
+
+void JsonWriter::openScope()
+{
+	writeWithIndent(m_scopes.back().isObject ? "{" : "[");
+	m_indentString += m_indentation;
+	m_scopes.back().empty = false;
+}
+
+void JsonWriter::beforeValue()
+{
+	if (m_scopes.empty() || m_scopes.back().isObject)
+		return;
+	if (m_scopes.back().empty)
+		openScope();
+	else
+		write(",");
+	if (!m_indented)
+		writeIndent();
+	m_indented = true;
+}
+
+void JsonWriter::afterValue()
+{
+	if (!m_scopes.empty() && !m_scopes.back().isObject)
+		m_indented = false;
+}
+
+void JsonWriter::write(string const& _text)
+{
+	if (m_pendingSpace)
+	{
+		if (_text.empty() || _text.front() != '\n')
+			m_stream << ' ';
+		m_pendingSpace = false;
+	}
+	m_stream << _text;
+}
+
+void JsonWriter::writeIndent()
+{
+	if (!m_indentation.empty())
+		write("\n" + m_indentString);
+}
+
+void JsonWriter::writeWithIndent(string const& _text)
+{
+	if (!m_indented)
+		writeIndent();
+	write(_text);
+	m_indented = false;
+}
+
+string JsonWriter::quoted(string const& _string)
+{
+	bool plain = all_of(_string.begin(), _string.end(), [](char _c) {
+		return static_cast<unsigned char>(_c) >= 0x20 && static_cast<unsigned char>(_c) < 0x80 && _c != '"' && _c != '\\';
+	});
+	if (plain)
+		return "\"" + _string + "\"";
+	// Leave escaping to jsoncpp to produce exactly the same output.
+	return jsonCompactPrint(Json::Value(_string));
+}
+
 
 } // namespace dev
@@ -24,7 +24,11 @@
 
 #include <json/json.h>
 
+#include <functional>
+#include <map>
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace dev {
 
@@ -55,4 +59,79 @@ bool jsonParse(std::string const& _input, Json::Value& _json, std::string* _errs
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseFile(std::string const& _fileName, Json::Value& _json, std::string* _errs = nullptr);
 
+/**
+ * Writes JSON to a stream piece by piece, without building a Json::Value first.
+ * The output is exactly the same as the serialisation of the corresponding Json::Value,
+ * provided that the members of each object are written in the order of their keys.
+ */
+class JsonWriter
+{
+public:
+	enum class Format
+	{
+		Compact, ///< as jsonCompactPrint
+		Pretty, ///< as jsonPrettyPrint
+		Styled ///< as the stream operator of Json::Value
+	};
+
+	JsonWriter(std::ostream& _stream, Format _format);
+	JsonWriter(JsonWriter const&) = delete;
+	JsonWriter& operator=(JsonWriter const&) = delete;
+
+	void beginObject();
+	/// Writes the key of the next member of the current object.
+	void key(std::string const& _key);
+	void endObject();
+	void beginArray();
+	void endArray();
+	/// Writes @a _value as a whole, taking replacements into account.
+	void value(Json::Value const& _value);
+	/// Writes a value that was already serialised in the compact format.
+	/// Only supported if the format of this writer is compact as well.
+	void compactValue(std::string const& _json);
+
+	/// Makes @a value call @a _writeValue instead of writing any string equal to @a _placeholder,
+	/// which has to write exactly one value. This can be used to stream parts of a document
+	/// that is otherwise built as a Json::Value.
+	void replace(std::string const& _placeholder, std::function<void(JsonWriter&)> _writeValue);
+
+private:
+	/// An object or array that is not yet closed.
+	struct Scope
+	{
+		bool isObject;
+		/// Whether no member or element was written yet. The opening bracket is only written
+		/// together with the first member or element because empty objects and arrays
+		/// are formatted differently.
+		bool empty;
+	};
+
+	void beginScope(bool _isObject);
+	void endScope(bool _isObject);
+	/// Writes the opening bracket of the innermost scope if it was empty so far.
+	void openScope();
+	/// Prepares the output for the next value, i.e. the next element of an array.
+	void beforeValue();
+	void afterValue();
+
+	void write(std::string const& _text);
+	void writeIndent();
+	void writeWithIndent(std::string const& _text);
+	static std::string quoted(std::string const& _string);
+
+	std::ostream& m_stream;
+	Format m_format;
+	std::string m_indentation;
+	std::string m_colon;
+	std::string m_indentString;
+	/// Whether the output is at the start of a line already, in which case values are not
+	/// indented again.
+	bool m_indented = true;
+	/// Whether a space is to be written before the next output unless it starts a new line,
+	/// to avoid trailing whitespace in the pretty format.
+	bool m_pendingSpace = false;
+	std::vector<Scope> m_scopes;
+	std::map<std::string, std::function<void(JsonWriter&)>> m_replacements;
+};
+
 }
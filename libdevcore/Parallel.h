@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Helpers for running independent tasks concurrently.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/// Calls @a _function(i) for every i in [0, _count), using at most as many threads as
+/// there are hardware threads available. The calling thread takes part in the work.
+/// The order in which the indices are processed is unspecified, so callers have to write
+/// their results into pre-allocated slots to stay deterministic.
+/// Exceptions thrown by @a _function are re-thrown in the calling thread.
+template <class F>
+void parallelFor(size_t _count, F const& _function)
+{
+	size_t workers = std::min<size_t>(_count, std::max(1u, std::thread::hardware_concurrency()));
+	if (workers <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_function(i);
+		return;
+	}
+
+	std::atomic<size_t> next{0};
+	auto work = [&]()
+	{
+		try
+		{
+			for (size_t i = next++; i < _count; i = next++)
+				_function(i);
+		}
+		catch (...)
+		{
+			// Stop handing out further work to the other threads.
+			next = _count;
+			throw;
+		}
+	};
+	std::vector<std::future<void>> helpers;
+	for (size_t i = 1; i < workers; ++i)
+		helpers.emplace_back(std::async(std::launch::async, work));
+	// Make sure the helpers are finished before an exception leaves this frame.
+	std::exception_ptr error;
+	try
+	{
+		work();
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+	for (auto& helper: helpers)
+		try
+		{
+			helper.get();
+		}
+		catch (...)
+		{
+			if (!error)
+				error = std::current_exception();
+		}
+	if (error)
+		std::rethrow_exception(error);
+}
+
+}
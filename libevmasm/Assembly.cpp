@@ -26,6 +26,7 @@
 #include <libevmasm/PeepholeOptimiser.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/BlockLayoutOptimiser.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
 
@@ -96,28 +97,106 @@ void Assembly::injectStart(AssemblyItem const& _i)
 
 unsigned Assembly::bytesRequired(unsigned subTagSize) const
 {
+	// Only references to tags, data and subs depend on the tag size, so the size of all other
+	// items is summed up once and not for every candidate tag size.
+	unsigned fixedSize = 1;
+	unsigned addressReferences = 0;
+	for (auto const& i: m_data)
+		fixedSize += i.second.size();
+
+	for (AssemblyItem const& i: m_items)
+		if (i.type() == PushTag || i.type() == PushData || i.type() == PushSub)
+			++addressReferences;
+		else
+			fixedSize += i.bytesRequired(0);
+
 	for (unsigned tagSize = subTagSize; true; ++tagSize)
 	{
-		unsigned ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
-
-		for (AssemblyItem const& i: m_items)
-			ret += i.bytesRequired(tagSize);
+		unsigned ret = fixedSize + addressReferences * (1 + tagSize);
 		if (dev::bytesRequired(ret) <= tagSize)
 			return ret;
 	}
 }
 
+vector<unsigned> Assembly::relaxedTagWidths(unsigned _bytesPerTag, unsigned _bytesPerDataRef) const
+{
+	// Start from the layout where every tag reference uses the common width and shrink
+	// each reference to what its target needs. Shrinking only moves tags towards the
+	// beginning, so all references still fit after every round and the widths can only
+	// decrease. This terminates after very few linear passes.
+	vector<unsigned> widths;
+	for (AssemblyItem const& i: m_items)
+		if (i.type() == PushTag)
+			widths.push_back(_bytesPerTag);
+
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		vector<size_t> tagPositions(m_usedTags, size_t(-1));
+		size_t position = 0;
+		size_t pushTagIndex = 0;
+		for (AssemblyItem const& i: m_items)
+		{
+			if (i.type() != Tag && tagPositions[0] == size_t(-1))
+				tagPositions[0] = position;
+			switch (i.type())
+			{
+			case Tag:
+				tagPositions[size_t(i.data())] = position;
+				position += 1;
+				break;
+			case PushTag:
+				position += 1 + widths[pushTagIndex++];
+				break;
+			case PushData:
+			case PushSub:
+			case PushProgramSize:
+				position += 1 + _bytesPerDataRef;
+				break;
+			case PushSubSize:
+				position += 1 + max<unsigned>(1, dev::bytesRequired(m_subs.at(size_t(i.data()))->assemble().bytecode.size()));
+				break;
+			default:
+				position += i.bytesRequired(0);
+				break;
+			}
+		}
+
+		pushTagIndex = 0;
+		for (AssemblyItem const& i: m_items)
+			if (i.type() == PushTag)
+			{
+				size_t subId;
+				size_t tagId;
+				tie(subId, tagId) = i.splitForeignPushTag();
+				std::vector<size_t> const& positions =
+					subId == size_t(-1) ?
+					tagPositions :
+					m_subs.at(subId)->m_tagPositionsInBytecode;
+				assertThrow(tagId < positions.size(), AssemblyException, "Reference to non-existing tag.");
+				assertThrow(positions[tagId] != size_t(-1), AssemblyException, "Reference to tag without position.");
+				unsigned width = max<unsigned>(1, dev::bytesRequired(positions[tagId]));
+				assertThrow(width <= widths[pushTagIndex], AssemblyException, "Tag width relaxation did not converge.");
+				if (width < widths[pushTagIndex])
+				{
+					widths[pushTagIndex] = width;
+					changed = true;
+				}
+				++pushTagIndex;
+			}
+	}
+	return widths;
+}
+
 namespace
 {
 
-string locationFromSources(StringMap const& _sourceCodes, SourceLocation const& _location)
+string locationFromSources(StringMap const& _sourceCodes, CharStream const* _source, SourceLocation const& _location)
 {
-	if (_location.isEmpty() || !_location.source.get() || _sourceCodes.empty() || _location.start >= _location.end || _location.start < 0)
+	if (_location.isEmpty() || !_source || _sourceCodes.empty() || _location.start >= _location.end || _location.start < 0)
 		return "";
 
-	auto it = _sourceCodes.find(_location.source->name());
+	auto it = _sourceCodes.find(_source->name());
 	if (it == _sourceCodes.end())
 		return "";
 
@@ -136,8 +215,8 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 class Functionalizer
 {
 public:
-	Functionalizer (ostream& _out, string const& _prefix, StringMap const& _sourceCodes):
-		m_out(_out), m_prefix(_prefix), m_sourceCodes(_sourceCodes)
+	Functionalizer (ostream& _out, string const& _prefix, StringMap const& _sourceCodes, SourceRegistry const* _sources):
+		m_out(_out), m_prefix(_prefix), m_sourceCodes(_sourceCodes), m_sources(_sources)
 	{}
 
 	void feed(AssemblyItem const& _item)
@@ -186,14 +265,15 @@ public:
 
 	void printLocation()
 	{
-		if (!m_location.source && m_location.isEmpty())
+		CharStream const* source = m_sources ? m_sources->charStream(m_location) : nullptr;
+		if (!source && m_location.isEmpty())
 			return;
 		m_out << m_prefix << "    /*";
-		if (m_location.source)
-			m_out << " \"" + m_location.source->name() + "\"";
+		if (source)
+			m_out << " \"" + source->name() + "\"";
 		if (!m_location.isEmpty())
 			m_out << ":" << to_string(m_location.start) + ":" + to_string(m_location.end);
-		m_out << "  " << locationFromSources(m_sourceCodes, m_location);
+		m_out << "  " << locationFromSources(m_sourceCodes, source, m_location);
 		m_out << " */" << endl;
 	}
 
@@ -204,13 +284,19 @@ private:
 	ostream& m_out;
 	string const& m_prefix;
 	StringMap const& m_sourceCodes;
+	SourceRegistry const* m_sources;
 };
 
 }
 
-void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap const& _sourceCodes) const
+void Assembly::assemblyStream(
+	ostream& _out,
+	string const& _prefix,
+	StringMap const& _sourceCodes,
+	SourceRegistry const* _sources
+) const
 {
-	Functionalizer f(_out, _prefix, _sourceCodes);
+	Functionalizer f(_out, _prefix, _sourceCodes, _sources);
 
 	for (auto const& i: m_items)
 		f.feed(i);
@@ -226,7 +312,7 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 		for (size_t i = 0; i < m_subs.size(); ++i)
 		{
 			_out << endl << _prefix << "sub_" << i << ": assembly {\n";
-			m_subs[i]->assemblyStream(_out, _prefix + "    ", _sourceCodes);
+			m_subs[i]->assemblyStream(_out, _prefix + "    ", _sourceCodes, _sources);
 			_out << _prefix << "}" << endl;
 		}
 	}
@@ -235,10 +321,10 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 		_out << endl << _prefix << "auxdata: 0x" << toHex(m_auxiliaryData) << endl;
 }
 
-string Assembly::assemblyString(StringMap const& _sourceCodes) const
+string Assembly::assemblyString(StringMap const& _sourceCodes, SourceRegistry const* _sources) const
 {
 	ostringstream tmp;
-	assemblyStream(tmp, "", _sourceCodes);
+	assemblyStream(tmp, "", _sourceCodes, _sources);
 	return tmp.str();
 }
 
@@ -456,6 +542,13 @@ map<u256, u256> Assembly::optimiseInternal(
 			}
 		}
 
+		if (_settings.runBlockLayout)
+		{
+			BlockLayoutOptimiser layoutOpt{m_items, _settings.isCreation, _settings.expectedExecutionsPerDeployment};
+			if (layoutOpt.optimise(_tagsReferencedFromOutside))
+				count++;
+		}
+
 		if (_settings.runCSE)
 		{
 			// Control flow graph optimization has been here before but is disabled because it
@@ -511,9 +604,12 @@ map<u256, u256> Assembly::optimiseInternal(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
-			*this
+			*this,
+			_settings.constantOptimiserMaxSteps
 		);
 
+	m_relaxTagWidths = _settings.runTagRelaxation;
+
 	return tagReplacements;
 }
 
@@ -535,7 +631,7 @@ LinkerObject const& Assembly::assemble() const
 
 	size_t bytesRequiredForCode = bytesRequired(subTagSize);
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, -1);
-	map<size_t, pair<size_t, size_t>> tagRef;
+	map<size_t, tuple<size_t, size_t, unsigned>> tagRef;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
@@ -550,6 +646,11 @@ LinkerObject const& Assembly::assemble() const
 	uint8_t dataRefPush = (uint8_t)Instruction::PUSH1 - 1 + bytesPerDataRef;
 	ret.bytecode.reserve(bytesRequiredIncludingData);
 
+	vector<unsigned> tagWidths;
+	if (m_relaxTagWidths)
+		tagWidths = relaxedTagWidths(bytesPerTag, bytesPerDataRef);
+	size_t pushTagIndex = 0;
+
 	for (AssemblyItem const& i: m_items)
 	{
 		// store position of the invalid jump destination
@@ -585,9 +686,11 @@ LinkerObject const& Assembly::assemble() const
 		}
 		case PushTag:
 		{
-			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
-			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
+			unsigned width = m_relaxTagWidths ? tagWidths.at(pushTagIndex++) : bytesPerTag;
+			ret.bytecode.push_back(m_relaxTagWidths ? (uint8_t)Instruction::PUSH1 - 1 + width : tagPush);
+			auto tag = i.splitForeignPushTag();
+			tagRef[ret.bytecode.size()] = make_tuple(tag.first, tag.second, width);
+			ret.bytecode.resize(ret.bytecode.size() + width);
 			break;
 		}
 		case PushData:
@@ -660,7 +763,8 @@ LinkerObject const& Assembly::assemble() const
 	{
 		size_t subId;
 		size_t tagId;
-		tie(subId, tagId) = i.second;
+		unsigned width;
+		tie(subId, tagId, width) = i.second;
 		assertThrow(subId == size_t(-1) || subId < m_subs.size(), AssemblyException, "Invalid sub id");
 		std::vector<size_t> const& tagPositions =
 			subId == size_t(-1) ?
@@ -669,8 +773,8 @@ LinkerObject const& Assembly::assemble() const
 		assertThrow(tagId < tagPositions.size(), AssemblyException, "Reference to non-existing tag.");
 		size_t pos = tagPositions[tagId];
 		assertThrow(pos != size_t(-1), AssemblyException, "Reference to tag without position.");
-		assertThrow(dev::bytesRequired(pos) <= bytesPerTag, AssemblyException, "Tag too large for reserved space.");
-		bytesRef r(ret.bytecode.data() + i.first, bytesPerTag);
+		assertThrow(dev::bytesRequired(pos) <= width, AssemblyException, "Tag too large for reserved space.");
+		bytesRef r(ret.bytecode.data() + i.first, width);
 		toBigEndian(pos, r);
 	}
 	for (auto const& dataItem: m_data)
@@ -24,6 +24,7 @@
 #include <libevmasm/Exceptions.h>
 
 #include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceRegistry.h>
 
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
@@ -107,10 +108,17 @@ public:
 		bool runDeduplicate = false;
 		bool runCSE = false;
 		bool runConstantOptimiser = false;
+		/// Thread jumps and re-order basic blocks to replace jumps by fall-through.
+		bool runBlockLayout = false;
+		/// Choose the width of each pushed tag separately based on its final position
+		/// instead of using one width for the whole assembly.
+		bool runTagRelaxation = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Maximum number of decompositions the constant optimiser tries for each constant.
+		size_t constantOptimiserMaxSteps = 10000;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -125,13 +133,17 @@ public:
 	Assembly& optimise(bool _enable, langutil::EVMVersion _evmVersion, bool _isCreation, size_t _runs);
 
 	/// Create a text representation of the assembly.
+	/// The names of the sources are looked up in @a _sources, if given, and the code
+	/// of the sources that are named in @a _sourceCodes is printed next to the locations.
 	std::string assemblyString(
-		StringMap const& _sourceCodes = StringMap()
+		StringMap const& _sourceCodes = StringMap(),
+		langutil::SourceRegistry const* _sources = nullptr
 	) const;
 	void assemblyStream(
 		std::ostream& _out,
 		std::string const& _prefix = "",
-		StringMap const& _sourceCodes = StringMap()
+		StringMap const& _sourceCodes = StringMap(),
+		langutil::SourceRegistry const* _sources = nullptr
 	) const;
 
 	/// Create a JSON representation of the assembly.
@@ -158,6 +170,9 @@ protected:
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
 
 	unsigned bytesRequired(unsigned subTagSize) const;
+	/// @returns the number of bytes to use for each PushTag item (in order of appearance),
+	/// such that every reference is as small as possible given the final tag positions.
+	std::vector<unsigned> relaxedTagWidths(unsigned _bytesPerTag, unsigned _bytesPerDataRef) const;
 
 private:
 	static Json::Value createJsonValue(std::string _name, int _begin, int _end, std::string _value = std::string(), std::string _jumpType = std::string());
@@ -175,6 +190,9 @@ protected:
 	std::map<h256, std::string> m_strings;
 	std::map<h256, std::string> m_libraries; ///< Identifiers of libraries to be linked.
 
+	/// If true, the push width of each tag reference is chosen separately during assembly.
+	bool m_relaxTagWidths = false;
+
 	mutable LinkerObject m_assembledObject;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
 
@@ -0,0 +1,308 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser step that threads jumps and re-orders basic blocks such that
+ * jumps can be replaced by falling through to the next block.
+ */
+
+#include <libevmasm/BlockLayoutOptimiser.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+
+/// Factor by which code inside a loop is assumed to be executed more often than the code around it.
+size_t const c_loopWeight = 10;
+/// Loops nested deeper than this are not distinguished anymore.
+int const c_maxLoopDepth = 4;
+/// Push width assumed for tags when estimating code size.
+unsigned const c_tagSize = 2;
+
+bool isLocalPushTag(AssemblyItem const& _item)
+{
+	return _item.type() == PushTag && _item.splitForeignPushTag().first == size_t(-1);
+}
+
+bool isJump(AssemblyItem const& _item)
+{
+	return _item == Instruction::JUMP || _item == Instruction::JUMPI;
+}
+
+}
+
+bool BlockLayoutOptimiser::optimise(set<size_t> const& _tagsReferencedFromOutside)
+{
+	bool changed = threadJumps();
+
+	vector<Chain> chains = this->chains();
+
+	// The first chain is the entry point and cannot be moved. The same is true for a chain
+	// that runs until the end of the code, because it has to stay at the end.
+	map<size_t, size_t> chainByHeadTag;
+	for (size_t i = 1; i < chains.size(); ++i)
+	{
+		size_t tag = headTag(chains[i]);
+		AssemblyItem const& lastItem = m_items[chains[i].end - 1];
+		if (tag != size_t(-1) && SemanticInformation::altersControlFlow(lastItem) && lastItem != Instruction::JUMPI)
+			chainByHeadTag[tag] = i;
+	}
+
+	map<size_t, size_t> references;
+	for (auto const& item: m_items)
+		if (isLocalPushTag(item))
+			references[item.splitForeignPushTag().second]++;
+
+	vector<size_t> weights = executionWeights();
+	vector<pair<size_t, size_t>> candidates;
+	for (size_t i = 0; i < chains.size(); ++i)
+	{
+		size_t target = tailJumpTarget(chains[i]);
+		if (chainByHeadTag.count(target) && chainByHeadTag.at(target) != i)
+			candidates.emplace_back(weights[chains[i].end - 1], i);
+	}
+	// Most frequently executed jumps first, otherwise keep the order of the code.
+	stable_sort(candidates.begin(), candidates.end(), [](pair<size_t, size_t> const& _a, pair<size_t, size_t> const& _b)
+	{
+		return _a.first > _b.first;
+	});
+
+	vector<size_t> next(chains.size(), size_t(-1));
+	vector<size_t> prev(chains.size(), size_t(-1));
+	bool reordered = false;
+	for (auto const& candidate: candidates)
+	{
+		size_t source = candidate.second;
+		size_t tag = tailJumpTarget(chains[source]);
+		size_t target = chainByHeadTag.at(tag);
+		if (prev[target] != size_t(-1))
+			continue;
+		size_t first = source;
+		while (prev[first] != size_t(-1))
+			first = prev[first];
+		// Appending the target to its own group would create a cycle.
+		if (first == target)
+			continue;
+		next[source] = target;
+		prev[target] = source;
+		references[tag]--;
+		reordered = true;
+	}
+
+	vector<bool> duplicate(chains.size(), false);
+	for (size_t i = 0; i < chains.size(); ++i)
+	{
+		size_t tag = tailJumpTarget(chains[i]);
+		if (next[i] != size_t(-1) || !chainByHeadTag.count(tag))
+			continue;
+		Chain const& target = chains[chainByHeadTag.at(tag)];
+		if (isDuplicable(target) && shouldDuplicate(target))
+		{
+			duplicate[i] = true;
+			references[tag]--;
+			reordered = true;
+		}
+	}
+
+	if (!reordered)
+		return changed;
+
+	AssemblyItems optimisedItems;
+	optimisedItems.reserve(m_items.size());
+	for (size_t i = 0; i < chains.size(); ++i)
+		if (prev[i] == size_t(-1))
+			for (size_t chainIndex = i; chainIndex != size_t(-1); chainIndex = next[chainIndex])
+			{
+				Chain const& chain = chains[chainIndex];
+				size_t begin = chain.begin;
+				size_t end = chain.end;
+				if (prev[chainIndex] != size_t(-1))
+				{
+					size_t tag = headTag(chain);
+					if (!references[tag] && !_tagsReferencedFromOutside.count(tag))
+						++begin;
+				}
+				if (next[chainIndex] != size_t(-1) || duplicate[chainIndex])
+					end -= 2;
+				copy(m_items.begin() + begin, m_items.begin() + end, back_inserter(optimisedItems));
+				if (duplicate[chainIndex])
+				{
+					Chain const& target = chains[chainByHeadTag.at(tailJumpTarget(chain))];
+					copy(m_items.begin() + target.begin + 1, m_items.begin() + target.end, back_inserter(optimisedItems));
+				}
+			}
+	m_items = move(optimisedItems);
+	return true;
+}
+
+bool BlockLayoutOptimiser::threadJumps()
+{
+	map<size_t, size_t> positions = tagPositions();
+	// @returns the tag the block starting at @a _tag unconditionally jumps to
+	// if this is all it does, -1 otherwise.
+	auto jumpOnlyTarget = [&](size_t _tag) -> size_t
+	{
+		auto it = positions.find(_tag);
+		if (it == positions.end())
+			return size_t(-1);
+		size_t position = it->second;
+		if (
+			position + 2 < m_items.size() &&
+			isLocalPushTag(m_items[position + 1]) &&
+			m_items[position + 2] == Instruction::JUMP
+		)
+			return m_items[position + 1].splitForeignPushTag().second;
+		return size_t(-1);
+	};
+
+	bool changed = false;
+	for (size_t i = 0; i + 1 < m_items.size(); ++i)
+	{
+		if (!isLocalPushTag(m_items[i]) || !isJump(m_items[i + 1]))
+			continue;
+		size_t tag = m_items[i].splitForeignPushTag().second;
+		set<size_t> visited{tag};
+		size_t target = tag;
+		bool cycle = false;
+		for (size_t nextTarget = jumpOnlyTarget(tag); nextTarget != size_t(-1); nextTarget = jumpOnlyTarget(nextTarget))
+		{
+			if (!visited.insert(nextTarget).second)
+			{
+				// Endless loop, leave it alone so that the result does not oscillate.
+				cycle = true;
+				break;
+			}
+			target = nextTarget;
+		}
+		if (!cycle && target != tag)
+		{
+			m_items[i].setData(target);
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+vector<BlockLayoutOptimiser::Chain> BlockLayoutOptimiser::chains() const
+{
+	vector<Chain> chains;
+	Chain chain;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (SemanticInformation::altersControlFlow(m_items[i]) && m_items[i] != Instruction::JUMPI)
+		{
+			chain.end = i + 1;
+			chains.push_back(chain);
+			chain.begin = i + 1;
+		}
+	if (chain.begin < m_items.size())
+	{
+		chain.end = m_items.size();
+		chains.push_back(chain);
+	}
+	return chains;
+}
+
+vector<size_t> BlockLayoutOptimiser::executionWeights() const
+{
+	// Every jump backwards is treated as the end of a loop starting at its target.
+	map<size_t, size_t> positions = tagPositions();
+	vector<int> depthChange(m_items.size() + 1, 0);
+	for (size_t i = 0; i + 1 < m_items.size(); ++i)
+		if (isLocalPushTag(m_items[i]) && isJump(m_items[i + 1]))
+		{
+			auto it = positions.find(m_items[i].splitForeignPushTag().second);
+			if (it != positions.end() && it->second <= i)
+			{
+				depthChange[it->second]++;
+				depthChange[i + 2]--;
+			}
+		}
+
+	vector<size_t> weights(m_items.size(), 1);
+	int depth = 0;
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		depth += depthChange[i];
+		for (int j = 0; j < min(depth, c_maxLoopDepth); ++j)
+			weights[i] *= c_loopWeight;
+	}
+	return weights;
+}
+
+size_t BlockLayoutOptimiser::tailJumpTarget(Chain const& _chain) const
+{
+	if (
+		_chain.end - _chain.begin >= 2 &&
+		m_items[_chain.end - 1] == Instruction::JUMP &&
+		isLocalPushTag(m_items[_chain.end - 2])
+	)
+		return m_items[_chain.end - 2].splitForeignPushTag().second;
+	return size_t(-1);
+}
+
+size_t BlockLayoutOptimiser::headTag(Chain const& _chain) const
+{
+	if (_chain.begin < _chain.end && m_items[_chain.begin].type() == Tag)
+	{
+		auto subAndTag = m_items[_chain.begin].splitForeignPushTag();
+		assertThrow(subAndTag.first == size_t(-1), OptimizerException, "Sub-assembly tag used as label.");
+		return subAndTag.second;
+	}
+	return size_t(-1);
+}
+
+bool BlockLayoutOptimiser::isDuplicable(Chain const& _chain) const
+{
+	if (headTag(_chain) == size_t(-1) || !SemanticInformation::terminatesControlFlow(m_items[_chain.end - 1]))
+		return false;
+	for (size_t i = _chain.begin + 1; i < _chain.end; ++i)
+		if (m_items[i].type() == Tag || m_items[i].type() == PushTag)
+			return false;
+	return true;
+}
+
+bool BlockLayoutOptimiser::shouldDuplicate(Chain const& _chain) const
+{
+	// A terminating block is executed at most once per call, so only the number of runs matters.
+	bigint addedBytes = -bigint(1 + c_tagSize + 1);
+	for (size_t i = _chain.begin + 1; i < _chain.end; ++i)
+		addedBytes += m_items[i].bytesRequired(c_tagSize);
+	if (addedBytes <= 0)
+		return true;
+	bigint savedGas =
+		GasMeter::runGas(Instruction::PUSH1) +
+		GasMeter::runGas(Instruction::JUMP) +
+		GasCosts::jumpdestGas;
+	return bigint(m_runs) * savedGas > addedBytes * GasCosts::createDataGas;
+}
+
+map<size_t, size_t> BlockLayoutOptimiser::tagPositions() const
+{
+	map<size_t, size_t> positions;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (m_items[i].type() == Tag)
+			positions[m_items[i].splitForeignPushTag().second] = i;
+	return positions;
+}
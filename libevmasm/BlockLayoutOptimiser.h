@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser step that threads jumps and re-orders basic blocks such that
+ * jumps can be replaced by falling through to the next block.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Optimizer class that changes the order of basic blocks. Modifies the passed vector in place.
+ *
+ * The code is split into chains of basic blocks that have to stay consecutive because
+ * control flow falls through from one block to the next. The following steps are performed:
+ *  - Jump threading: "PUSH tag_a JUMP(I)" is replaced by "PUSH tag_b JUMP(I)" if tag_a only
+ *    consists of "tag_a: PUSH tag_b JUMP".
+ *  - Placement: a chain ending in "PUSH tag_a JUMP" is followed by the chain starting at tag_a,
+ *    removing the jump. If this was the only reference to tag_a, the JUMPDEST is removed as well.
+ *    If several chains jump to the same chain, the most frequently executed one is chosen,
+ *    where blocks inside loops are assumed to be executed more often.
+ *  - Tail duplication: a jump to a small terminating block is replaced by a copy of the
+ *    block if this is cheaper given the expected number of executions per deployment.
+ *
+ * Only jumps that directly follow the push of their target tag are considered, i.e. tags that
+ * are pushed elsewhere (return addresses, function pointers) keep all their predecessors.
+ */
+class BlockLayoutOptimiser
+{
+public:
+	BlockLayoutOptimiser(AssemblyItems& _items, bool _isCreation, size_t _runs):
+		m_items(_items),
+		m_runs(_isCreation ? 1 : _runs)
+	{}
+
+	/// Performs the optimisation. Tags in @a _tagsReferencedFromOutside are never removed.
+	/// @returns true if something was changed.
+	bool optimise(std::set<size_t> const& _tagsReferencedFromOutside);
+
+private:
+	/// Range of items that is not entered by falling through from the code before it
+	/// and does not fall through into the code after it.
+	struct Chain
+	{
+		size_t begin = 0;
+		size_t end = 0;
+	};
+
+	/// Re-targets jumps to blocks that only consist of a jump.
+	/// @returns true if something was changed.
+	bool threadJumps();
+	/// Splits the code into chains.
+	std::vector<Chain> chains() const;
+	/// @returns a weight for each item that approximates how often it is executed relative to
+	/// the rest of the code.
+	std::vector<size_t> executionWeights() const;
+	/// @returns the tag that is unconditionally jumped to at the end of the chain or -1.
+	size_t tailJumpTarget(Chain const& _chain) const;
+	/// @returns the tag at the start of the chain or -1.
+	size_t headTag(Chain const& _chain) const;
+	/// @returns true if the chain can be copied in place of a jump to its head tag.
+	bool isDuplicable(Chain const& _chain) const;
+	/// @returns true if replacing a jump to @a _chain by a copy of it is worth it.
+	bool shouldDuplicate(Chain const& _chain) const;
+
+	/// @returns a map from tag to its position in the code.
+	std::map<size_t, size_t> tagPositions() const;
+
+	AssemblyItems& m_items;
+	size_t m_runs;
+};
+
+}
+}
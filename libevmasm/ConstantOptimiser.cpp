@@ -22,6 +22,12 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+
+#include <libdevcore/Parallel.h>
+
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
@@ -30,7 +36,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
 	langutil::EVMVersion _evmVersion,
-	Assembly& _assembly
+	Assembly& _assembly,
+	size_t _maxSteps
 )
 {
 	// TODO: design the optimiser in a way this is not needed
@@ -41,36 +48,60 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	for (AssemblyItem const& item: _items)
 		if (item.type() == Push)
 			pushes[item]++;
-	map<u256, AssemblyItems> pendingReplacements;
-	for (auto it: pushes)
+
+	struct Candidate
 	{
-		AssemblyItem const& item = it.first;
-		if (item.data() < 0x100)
+		AssemblyItem const* item;
+		Params params;
+		bigint literalGas;
+		bigint copyGas;
+		bigint computeGas;
+		AssemblyItems computeRoutine;
+	};
+	vector<Candidate> candidates;
+	for (auto const& it: pushes)
+	{
+		if (it.first.data() < 0x100)
 			continue;
 		Params params;
 		params.multiplicity = it.second;
 		params.isCreation = _isCreation;
 		params.runs = _runs;
 		params.evmVersion = _evmVersion;
-		LiteralMethod lit(params, item.data());
-		bigint literalGas = lit.gasNeeded();
-		CodeCopyMethod copy(params, item.data());
-		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
-		bigint computeGas = compute.gasNeeded();
+		params.maxSteps = _maxSteps;
+		candidates.push_back(Candidate{&it.first, params, 0, 0, 0, {}});
+	}
+
+	// The evaluation of the methods does not modify the assembly and the constants are
+	// independent of each other, so they are evaluated concurrently. The replacements are
+	// applied afterwards in the original order to keep the output deterministic.
+	parallelFor(candidates.size(), [&](size_t _index)
+	{
+		Candidate& candidate = candidates[_index];
+		u256 const& value = candidate.item->data();
+		candidate.literalGas = LiteralMethod(candidate.params, value).gasNeeded();
+		candidate.copyGas = CodeCopyMethod(candidate.params, value).gasNeeded();
+		ComputeMethod compute(candidate.params, value);
+		candidate.computeGas = compute.gasNeeded();
+		candidate.computeRoutine = compute.execute(_assembly);
+	});
+
+	map<u256, AssemblyItems> pendingReplacements;
+	for (Candidate const& candidate: candidates)
+	{
 		AssemblyItems replacement;
-		if (copyGas < literalGas && copyGas < computeGas)
+		if (candidate.copyGas < candidate.literalGas && candidate.copyGas < candidate.computeGas)
 		{
-			replacement = copy.execute(_assembly);
+			replacement = CodeCopyMethod(candidate.params, candidate.item->data()).execute(_assembly);
 			optimisations++;
 		}
-		else if (computeGas < literalGas && computeGas <= copyGas)
+		else if (candidate.computeGas < candidate.literalGas && candidate.computeGas <= candidate.copyGas)
 		{
-			replacement = compute.execute(_assembly);
+			replacement = candidate.computeRoutine;
 			optimisations++;
 		}
 		if (!replacement.empty())
-			pendingReplacements[item.data()] = replacement;
+			pendingReplacements[candidate.item->data()] = replacement;
 	}
 	if (!pendingReplacements.empty())
 		replaceConstants(_items, pendingReplacements);
@@ -185,6 +216,24 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+AssemblyItems ComputeMethod::cachedRepresentation(u256 const& _value)
+{
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion, size_t>;
+	static map<Key, AssemblyItems> cache;
+	static mutex cacheMutex;
+
+	Key key{_value, m_params.isCreation, m_params.runs, m_params.multiplicity, m_params.evmVersion, m_maxSteps};
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		auto it = cache.find(key);
+		if (it != cache.end())
+			return it->second;
+	}
+	AssemblyItems routine = findRepresentation(_value);
+	lock_guard<mutex> lock(cacheMutex);
+	return cache.emplace(move(key), move(routine)).first->second;
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -48,12 +48,15 @@ class ConstantOptimisationMethod
 public:
 	/// Tries to optimised how constants are represented in the source code and modifies
 	/// @a _assembly.
+	/// @a _maxSteps limits the number of decompositions tried per constant by the compute method.
+	/// The candidates for the different constants are evaluated concurrently.
 	/// @returns zero if no optimisations could be performed.
 	static unsigned optimiseConstants(
 		bool _isCreation,
 		size_t _runs,
 		langutil::EVMVersion _evmVersion,
-		Assembly& _assembly
+		Assembly& _assembly,
+		size_t _maxSteps = 10000
 	);
 
 protected:
@@ -65,6 +68,7 @@ protected:
 		size_t runs; ///< Estimated number of calls per opcode oven the lifetime of the contract.
 		size_t multiplicity; ///< Number of times the constant appears in the code.
 		langutil::EVMVersion evmVersion; ///< Version of the EVM
+		size_t maxSteps; ///< Maximum number of decompositions tried by the compute method.
 	};
 
 	explicit ConstantOptimisationMethod(Params const& _params, u256 const& _value):
@@ -135,9 +139,10 @@ class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
 	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
+		ConstantOptimisationMethod(_params, _value),
+		m_maxSteps(_params.maxSteps)
 	{
-		m_routine = findRepresentation(m_value);
+		m_routine = cachedRepresentation(m_value);
 		assertThrow(
 			checkRepresentation(m_value, m_routine),
 			OptimizerException,
@@ -152,6 +157,10 @@ public:
 	}
 
 protected:
+	/// Returns the representation of @a _value from the process-wide cache or
+	/// finds it and stores it there. The cache is keyed by the value and all parameters
+	/// that influence the search, so it can be shared across assemblies and compiler runs.
+	AssemblyItems cachedRepresentation(u256 const& _value);
 	/// Tries to recursively find a way to compute @a _value.
 	AssemblyItems findRepresentation(u256 const& _value);
 	/// Recomputes the value from the calculated representation and checks for correctness.
@@ -159,7 +168,7 @@ protected:
 	bigint gasNeeded(AssemblyItems const& _routine) const;
 
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
-	size_t m_maxSteps = 10000;
+	size_t m_maxSteps;
 	AssemblyItems m_routine;
 };
 
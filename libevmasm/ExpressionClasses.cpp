@@ -27,6 +27,7 @@
 #include <functional>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/functional/hash.hpp>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
@@ -55,6 +56,37 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
 }
 
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
+{
+	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	if (item->type() != _other.item->type())
+		return false;
+	else if (item->type() == Operation)
+	{
+		auto instr = item->instruction();
+		auto otherInstr = _other.item->instruction();
+		return std::tie(instr, arguments, sequenceNumber) ==
+			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
+	}
+	else
+		return std::tie(item->data(), arguments, sequenceNumber) ==
+			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+}
+
+size_t ExpressionClasses::ExpressionHash::operator()(ExpressionClasses::Expression const& _expression) const
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	size_t seed = 0;
+	boost::hash_combine(seed, unsigned(_expression.item->type()));
+	if (_expression.item->type() == Operation)
+		boost::hash_combine(seed, unsigned(_expression.item->instruction()));
+	else
+		boost::hash_combine(seed, _expression.item->data());
+	boost::hash_range(seed, _expression.arguments.begin(), _expression.arguments.end());
+	boost::hash_combine(seed, _expression.sequenceNumber);
+	return seed;
+}
+
 ExpressionClasses::Id ExpressionClasses::find(
 	AssemblyItem const& _item,
 	Ids const& _arguments,
@@ -183,7 +215,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules keep the match groups of the current match, so every thread needs its own copy.
+	static thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
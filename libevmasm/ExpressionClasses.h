@@ -29,7 +29,7 @@
 #include <vector>
 #include <map>
 #include <memory>
-#include <set>
+#include <unordered_set>
 
 namespace langutil
 {
@@ -63,6 +63,14 @@ public:
 		unsigned sequenceNumber = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
 		bool operator<(Expression const& _other) const;
+		/// Equality consistent with operator<, i.e. ignoring the id.
+		bool operator==(Expression const& _other) const;
+	};
+
+	/// Hash over the same tuple that is used by Expression::operator==.
+	struct ExpressionHash
+	{
+		std::size_t operator()(Expression const& _expression) const;
 	};
 
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
@@ -122,8 +130,8 @@ private:
 
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
-	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
+	/// All expression ever encountered, hash-consed for fast lookup.
+	std::unordered_set<Expression, ExpressionHash> m_expressions;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
 };
 
@@ -26,6 +26,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <tuple>
 #include <memory>
 #include <ostream>
@@ -36,6 +37,7 @@
 #endif // defined(__clang__)
 
 #include <boost/bimap.hpp>
+#include <boost/functional/hash.hpp>
 
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -174,7 +176,8 @@ private:
 	/// and are not contained here if they are not completely known.
 	std::map<Id, Id> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed.
-	std::map<std::vector<Id>, Id> m_knownKeccak256Hashes;
+	/// Only used for lookups, so the iteration order does not matter.
+	std::unordered_map<std::vector<Id>, Id, boost::hash<std::vector<Id>>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
@@ -23,12 +23,14 @@
 #include <libevmasm/KnownState.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion, size_t _maxSteps):
+	m_items(_items), m_evmVersion(_evmVersion), m_remainingSteps(_maxSteps)
 {
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
@@ -81,9 +83,17 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		// return the current gas value.
 		return gas;
 
+	if (subsumedByExploredPath(*path))
+		return gas;
+
 	set<u256> jumpTags;
 	for (; index < m_items.size() && !gas.isInfinite; ++index)
 	{
+		// Give up in a deterministic way if the exploration takes too long.
+		if (m_remainingSteps == 0)
+			return GasMeter::GasConsumption::infinite();
+		--m_remainingSteps;
+
 		bool branchStops = false;
 		jumpTags.clear();
 		AssemblyItem const& item = m_items.at(index);
@@ -137,3 +147,29 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 
 	return gas;
 }
+
+bool PathGasMeter::subsumedByExploredPath(GasPath const& _path)
+{
+	vector<GasPath>& explored = m_exploredPaths[_path.index];
+	for (GasPath const& other: explored)
+		if (
+			other.largestMemoryAccess == _path.largestMemoryAccess &&
+			!(other.gas < _path.gas) &&
+			other.state->stackHeight() == _path.state->stackHeight() &&
+			*other.state == *_path.state &&
+			includes(
+				other.visitedJumpdests.begin(), other.visitedJumpdests.end(),
+				_path.visitedJumpdests.begin(), _path.visitedJumpdests.end()
+			)
+		)
+			return true;
+
+	GasPath snapshot;
+	snapshot.index = _path.index;
+	snapshot.state = _path.state->copy();
+	snapshot.largestMemoryAccess = _path.largestMemoryAccess;
+	snapshot.gas = _path.gas;
+	snapshot.visitedJumpdests = _path.visitedJumpdests;
+	explored.push_back(move(snapshot));
+	return false;
+}
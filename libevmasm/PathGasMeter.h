@@ -53,7 +53,13 @@ struct GasPath
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	/// @param _maxSteps number of assembly items that are visited (summed over all paths)
+	/// before giving up and returning an infinite estimate.
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _maxSteps = defaultMaxSteps
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
@@ -67,6 +73,8 @@ public:
 		return PathGasMeter(_items, _evmVersion).estimateMax(_startIndex, _state);
 	}
 
+	static size_t const defaultMaxSteps = 1000000;
+
 private:
 	/// Adds a new path item to the queue, but only if we do not already have
 	/// a higher gas usage at that point.
@@ -74,14 +82,24 @@ private:
 	/// point in time, but it greatly reduces computational overhead.
 	void queue(std::unique_ptr<GasPath>&& _newPath);
 	GasMeter::GasConsumption handleQueueItem();
+	/// @returns true if a path that starts at the same jumpdest and already covers all
+	/// continuations of @a _path has been explored before. Otherwise records @a _path.
+	/// An explored path covers @a _path if it has the same knowledge about the state and
+	/// the same largest memory access, used at least as much gas and visited at least
+	/// the same jumpdests (visiting more jumpdests can only make the estimate infinite).
+	bool subsumedByExploredPath(GasPath const& _path);
 
 	/// Map of jumpdest -> gas path, so not really a queue. We only have one queued up
 	/// item per jumpdest, because of the behaviour of `queue` above.
 	std::map<size_t, std::unique_ptr<GasPath>> m_queue;
 	std::map<size_t, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
+	/// Map of jumpdest -> snapshots of the paths that were explored starting there.
+	std::map<size_t, std::vector<GasPath>> m_exploredPaths;
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	/// Remaining number of items that can be visited before the estimate is infinite.
+	size_t m_remainingSteps;
 };
 
 }
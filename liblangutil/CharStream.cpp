@@ -53,9 +53,145 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libdevcore/CommonIO.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 using namespace langutil;
 
+struct CharStream::Contents
+{
+	/// Owned contents or a copy of the mapped contents, created on first use of source().
+	string text;
+	boost::interprocess::mapped_region region;
+	mutable once_flag copied;
+	/// Offsets of the starts of all lines, built on first use.
+	mutable vector<size_t> lineStarts;
+	mutable once_flag lineStartsBuilt;
+};
+
+namespace
+{
+
+int newSourceId()
+{
+	static atomic<int> nextSourceId{0};
+	return nextSourceId++;
+}
+
+inline bool isWhiteSpaceChar(char _c)
+{
+	return _c == ' ' || _c == '\n' || _c == '\t' || _c == '\r';
+}
+
+inline bool isIdentifierChar(char _c)
+{
+	return
+		_c == '_' || _c == '$' ||
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9');
+}
+
+inline bool isLineBreakStart(char _c)
+{
+	return (0x0a <= _c && _c <= 0x0d) || uint8_t(_c) == 0xc2 || uint8_t(_c) == 0xe2;
+}
+
+#if defined(__SSE2__)
+
+/// @returns a mask of the bytes in @a _chunk that are in the range [_low, _high].
+/// Only valid for ranges that do not contain bytes with the highest bit set.
+inline __m128i inRange(__m128i _chunk, char _low, char _high)
+{
+	return _mm_and_si128(
+		_mm_cmpgt_epi8(_chunk, _mm_set1_epi8(char(_low - 1))),
+		_mm_cmplt_epi8(_chunk, _mm_set1_epi8(char(_high + 1)))
+	);
+}
+
+inline __m128i equalTo(__m128i _chunk, char _c)
+{
+	return _mm_cmpeq_epi8(_chunk, _mm_set1_epi8(_c));
+}
+
+/// Calls @a _matches on blocks of 16 characters starting at @a _position until it returns a
+/// non-zero mask, and @returns the position of the first matching character, or the position of
+/// the first block that does not fit into the input anymore.
+template <class Matches>
+inline size_t findInBlocks(char const* _data, size_t _position, size_t _size, Matches const& _matches)
+{
+	for (; _position + 16 <= _size; _position += 16)
+	{
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_data + _position));
+		unsigned mask = unsigned(_mm_movemask_epi8(_matches(chunk)));
+		if (mask)
+			return _position + size_t(__builtin_ctz(mask));
+	}
+	return _position;
+}
+
+#endif
+
+}
+
+CharStream::CharStream(string _source, string const& name):
+	m_name(name),
+	m_sourceId(newSourceId())
+{
+	auto contents = make_shared<Contents>();
+	contents->text = std::move(_source);
+	m_data = contents->text.data();
+	m_size = contents->text.size();
+	m_contents = std::move(contents);
+}
+
+CharStream CharStream::fromFile(string const& _path, string const& _name)
+{
+	try
+	{
+		boost::interprocess::file_mapping file(_path.c_str(), boost::interprocess::read_only);
+		auto contents = make_shared<Contents>();
+		contents->region = boost::interprocess::mapped_region(file, boost::interprocess::read_only);
+		CharStream stream;
+		stream.m_name = _name;
+		stream.m_sourceId = newSourceId();
+		stream.m_data = static_cast<char const*>(contents->region.get_address());
+		stream.m_size = contents->region.get_size();
+		stream.m_contents = std::move(contents);
+		return stream;
+	}
+	catch (boost::interprocess::interprocess_exception const&)
+	{
+		// Empty files cannot be mapped.
+		return CharStream(dev::readFileAsString(_path), _name);
+	}
+}
+
+string const& CharStream::source() const
+{
+	static string const empty;
+	if (!m_contents)
+		return empty;
+	if (m_contents->region.get_address())
+		call_once(m_contents->copied, [&]()
+		{
+			const_cast<Contents&>(*m_contents).text.assign(m_data, m_size);
+		});
+	return m_contents->text;
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -63,7 +199,7 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return m_data[m_position];
 }
 
 char CharStream::rollback(size_t _amount)
@@ -75,41 +211,146 @@ char CharStream::rollback(size_t _amount)
 
 char CharStream::setPosition(size_t _location)
 {
-	solAssert(_location <= m_source.size(), "Attempting to set position past end of source.");
+	solAssert(_location <= m_size, "Attempting to set position past end of source.");
 	m_position = _location;
 	return get();
 }
 
+char CharStream::advancePastWhitespace()
+{
+#if defined(__SSE2__)
+	m_position = findInBlocks(m_data, m_position, m_size, [](__m128i _chunk)
+	{
+		__m128i whitespace = _mm_or_si128(
+			_mm_or_si128(equalTo(_chunk, ' '), equalTo(_chunk, '\n')),
+			_mm_or_si128(equalTo(_chunk, '\t'), equalTo(_chunk, '\r'))
+		);
+		return _mm_andnot_si128(whitespace, _mm_set1_epi8(char(0xff)));
+	});
+#endif
+	while (m_position < m_size && isWhiteSpaceChar(m_data[m_position]))
+		m_position++;
+	return get();
+}
+
+char CharStream::advancePastIdentifierPart()
+{
+#if defined(__SSE2__)
+	m_position = findInBlocks(m_data, m_position, m_size, [](__m128i _chunk)
+	{
+		__m128i identifier = _mm_or_si128(
+			_mm_or_si128(inRange(_chunk, 'a', 'z'), inRange(_chunk, 'A', 'Z')),
+			_mm_or_si128(
+				inRange(_chunk, '0', '9'),
+				_mm_or_si128(equalTo(_chunk, '_'), equalTo(_chunk, '$'))
+			)
+		);
+		return _mm_andnot_si128(identifier, _mm_set1_epi8(char(0xff)));
+	});
+#endif
+	while (m_position < m_size && isIdentifierChar(m_data[m_position]))
+		m_position++;
+	return get();
+}
+
+char CharStream::advanceTo(char _c)
+{
+	if (m_position < m_size)
+	{
+		// memchr is vectorized by all major C libraries.
+		void const* found = memchr(m_data + m_position, _c, m_size - m_position);
+		m_position = found ? size_t(static_cast<char const*>(found) - m_data) : m_size;
+	}
+	return get();
+}
+
+char CharStream::advanceToLineBreakOr(char _c1, char _c2)
+{
+#if defined(__SSE2__)
+	m_position = findInBlocks(m_data, m_position, m_size, [&](__m128i _chunk)
+	{
+		return _mm_or_si128(
+			_mm_or_si128(equalTo(_chunk, _c1), equalTo(_chunk, _c2)),
+			_mm_or_si128(
+				inRange(_chunk, 0x0a, 0x0d),
+				_mm_or_si128(equalTo(_chunk, char(0xc2)), equalTo(_chunk, char(0xe2)))
+			)
+		);
+	});
+#endif
+	while (m_position < m_size)
+	{
+		char c = m_data[m_position];
+		if (c == _c1 || c == _c2 || isLineBreakStart(c))
+			break;
+		m_position++;
+	}
+	return get();
+}
+
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
+	size_t searchStart = min<size_t>(m_size, size_t(max(_position, 0)));
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	return m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	vector<size_t> const& starts = lineStarts();
+	size_t line = lineIndex(min(searchStart + 1, m_size));
+	size_t lineStart = starts[line];
+	size_t lineEnd = line + 1 < starts.size() ? starts[line + 1] - 1 : m_size;
+	return string(m_data + lineStart, m_data + lineEnd);
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	size_t searchPosition = min<size_t>(m_size, size_t(max(_position, 0)));
+	size_t line = lineIndex(searchPosition);
+	return tuple<int, int>(int(line), int(searchPosition - lineStarts()[line]));
+}
+
+vector<tuple<int, int>> CharStream::translatePositionsToLineColumns(vector<int> const& _positions) const
+{
+	vector<size_t> const& starts = lineStarts();
+	vector<tuple<int, int>> result;
+	result.reserve(_positions.size());
+	size_t line = 0;
+	size_t previousPosition = 0;
+	for (int position: _positions)
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+		size_t searchPosition = min<size_t>(m_size, size_t(max(position, 0)));
+		if (searchPosition < previousPosition)
+			line = lineIndex(searchPosition);
+		else
+			while (line + 1 < starts.size() && starts[line + 1] <= searchPosition)
+				line++;
+		previousPosition = searchPosition;
+		result.emplace_back(int(line), int(searchPosition - starts[line]));
 	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	return result;
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	static vector<size_t> const emptyLineStarts{0};
+	if (!m_contents)
+		return emptyLineStarts;
+	call_once(m_contents->lineStartsBuilt, [&]()
+	{
+		vector<size_t>& starts = m_contents->lineStarts;
+		starts.push_back(0);
+		char const* end = m_data + m_size;
+		for (
+			char const* newline = static_cast<char const*>(memchr(m_data, '\n', m_size));
+			newline;
+			newline = static_cast<char const*>(memchr(newline + 1, '\n', size_t(end - newline - 1)))
+		)
+			starts.push_back(size_t(newline - m_data) + 1);
+	});
+	return m_contents->lineStarts;
+}
+
+size_t CharStream::lineIndex(size_t _position) const
+{
+	vector<size_t> const& starts = lineStarts();
+	return size_t(upper_bound(starts.begin(), starts.end(), _position) - starts.begin()) - 1;
 }
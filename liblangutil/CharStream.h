@@ -53,8 +53,10 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace langutil
 {
@@ -63,18 +65,29 @@ namespace langutil
  * Bidirectional stream of characters.
  *
  * This CharStream is used by lexical analyzers as the source.
+ * The contents are immutable and shared between copies of the stream. They are either owned
+ * by the stream or read directly from a memory-mapped file.
+ * Every stream that is not default-constructed gets an ID that is unique within the process
+ * and is shared by its copies. Source locations refer to their source by this ID.
  */
 class CharStream
 {
 public:
 	CharStream() = default;
-	explicit CharStream(std::string const& _source, std::string const& name):
-		m_source(_source), m_name(name) {}
+	explicit CharStream(std::string _source, std::string const& name);
+
+	/// Creates a stream that reads the contents of the file at @a _path directly from a read-only
+	/// memory mapping instead of copying them. The file must not be modified while the stream
+	/// or one of its copies exists. Falls back to reading the file if it cannot be mapped.
+	static CharStream fromFile(std::string const& _path, std::string const& _name);
 
 	int position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_size; }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	char get(size_t _charsForward = 0) const
+	{
+		return m_position + _charsForward < m_size ? m_data[m_position + _charsForward] : 0;
+	}
 	char advanceAndGet(size_t _chars = 1);
 	/// Sets scanner position to @ _amount characters backwards in source text.
 	/// @returns The character of the current location after update is returned.
@@ -84,22 +97,59 @@ public:
 	/// @returns The character of the current location after update is returned.
 	char setPosition(size_t _location);
 
+	///@{
+	///@name Bulk scanning helpers
+	/// These functions advance the position over a run of characters at once, starting at the
+	/// current position, and use vector instructions where available.
+	/// @returns the character at the new position or zero at the end of the input.
+
+	/// Advances to the first character that is not whitespace.
+	char advancePastWhitespace();
+	/// Advances to the first character that cannot be part of an identifier.
+	char advancePastIdentifierPart();
+	/// Advances to the next occurrence of @a _c.
+	char advanceTo(char _c);
+	/// Advances to the next character that is @a _c1, @a _c2 or might start a line break,
+	/// i.e. is in the range 0x0a-0x0d or the first byte of the UTF-8 encoding of NEL, LS or PS.
+	char advanceToLineBreakOr(char _c1, char _c2);
+	///@}
+
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	/// @returns the contents of the stream. For memory-mapped streams, this creates a copy
+	/// of the contents on first use, prefer data() and size() where possible.
+	std::string const& source() const;
 	std::string const& name() const noexcept { return m_name; }
+	int sourceId() const noexcept { return m_sourceId; }
+
+	char const* data() const noexcept { return m_data; }
+	size_t size() const noexcept { return m_size; }
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call builds an index of the line starts, later calls take logarithmic time.
 	std::string lineAtPosition(int _position) const;
+	/// @returns the zero-based line and column of @a _position.
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
+	/// Translates all of @a _positions at once, in linear time if they are sorted.
+	std::vector<std::tuple<int, int>> translatePositionsToLineColumns(std::vector<int> const& _positions) const;
 	///@}
 
 private:
-	std::string m_source;
+	struct Contents;
+
+	/// @returns the offsets at which the lines of the source start, in ascending order.
+	std::vector<size_t> const& lineStarts() const;
+	/// @returns the index of the line that contains the offset @a _position.
+	size_t lineIndex(size_t _position) const;
+
+	/// Keeps the memory referenced by m_data alive.
+	std::shared_ptr<Contents const> m_contents;
+	char const* m_data = "";
+	size_t m_size = 0;
 	std::string m_name;
+	int m_sourceId = -1;
 	size_t m_position{0};
 };
 
@@ -50,6 +50,11 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Appends the errors of @a _errorList as if they were reported here, i.e. they
+	/// count towards the limits on the number of errors and warnings.
+	/// Used to combine the results of reporters of concurrent tasks.
+	void merge(ErrorList const& _errorList);
+
 	void warning(std::string const& _description);
 
 	void warning(SourceLocation const& _location, std::string const& _description);
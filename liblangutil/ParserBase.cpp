@@ -101,7 +101,7 @@ void ParserBase::expectTokenOrConsumeUntil(Token _value, string const& _currentN
 	if (tok != _value)
 	{
 		int startPosition = position();
-		SourceLocation errorLoc = SourceLocation{startPosition, endPosition(), source()};
+		SourceLocation errorLoc = SourceLocation{startPosition, endPosition(), sourceId()};
 		while (m_scanner->currentToken() != _value && m_scanner->currentToken() != Token::EOS)
 			m_scanner->next();
 
@@ -149,7 +149,7 @@ void ParserBase::decreaseRecursionDepth()
 
 void ParserBase::parserWarning(string const& _description)
 {
-	m_errorReporter.warning(SourceLocation{position(), endPosition(), source()}, _description);
+	m_errorReporter.warning(SourceLocation{position(), endPosition(), sourceId()}, _description);
 }
 
 void ParserBase::parserError(SourceLocation const& _location, string const& _description)
@@ -159,12 +159,12 @@ void ParserBase::parserError(SourceLocation const& _location, string const& _des
 
 void ParserBase::parserError(string const& _description)
 {
-	parserError(SourceLocation{position(), endPosition(), source()}, _description);
+	parserError(SourceLocation{position(), endPosition(), sourceId()}, _description);
 }
 
 void ParserBase::fatalParserError(string const& _description)
 {
-	fatalParserError(SourceLocation{position(), endPosition(), source()}, _description);
+	fatalParserError(SourceLocation{position(), endPosition(), sourceId()}, _description);
 }
 
 void ParserBase::fatalParserError(SourceLocation const& _location, string const& _description)
@@ -45,7 +45,8 @@ public:
 		m_parserErrorRecovery = _parserErrorRecovery;
 	}
 
-	std::shared_ptr<CharStream> source() const { return m_scanner->charStream(); }
+	/// @returns the ID of the source that is being parsed.
+	int sourceId() const { return m_scanner->sourceId(); }
 
 protected:
 	/// Utility class that creates an error and throws an exception if the
@@ -258,8 +258,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	int const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
+	if (isWhiteSpace(m_char))
+	{
+		// m_char is not necessarily the character at the current position
+		// (see skipMultiLineComment), so consume it separately.
 		advance();
+		m_char = m_source->advancePastWhitespace();
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -275,7 +280,12 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	while (!isUnicodeLinebreak())
+	{
+		m_char = m_source->advanceToLineBreakOr('\n', '\n');
+		if (isSourcePastEndOfInput() || isUnicodeLinebreak())
+			break;
 		if (!advance()) break;
+	}
 
 	return Token::Whitespace;
 }
@@ -321,6 +331,12 @@ Token Scanner::skipMultiLineComment()
 	advance();
 	while (!isSourcePastEndOfInput())
 	{
+		if (m_char != '*')
+		{
+			m_char = m_source->advanceTo('*');
+			if (isSourcePastEndOfInput())
+				break;
+		}
 		char ch = m_char;
 		advance();
 
@@ -737,6 +753,15 @@ Token Scanner::scanString()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		if (m_char != '\\')
+		{
+			// Copy the run of characters that need no special treatment at once.
+			int const runStart = sourcePos();
+			m_char = m_source->advanceToLineBreakOr(quote, '\\');
+			m_nextToken.literal.append(m_source->data() + runStart, sourcePos() - runStart);
+			if (m_char == quote || isSourcePastEndOfInput() || isUnicodeLinebreak())
+				break;
+		}
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -889,10 +914,17 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_supportPeriodInIdentifier))
-		addLiteralCharAndAdvance();
+	while (true)
+	{
+		// Scan the identifier characters up to the next period at once.
+		int const runStart = sourcePos();
+		m_char = m_source->advancePastIdentifierPart();
+		m_nextToken.literal.append(m_source->data() + runStart, sourcePos() - runStart);
+		if (m_char == '.' && m_supportPeriodInIdentifier)
+			addLiteralCharAndAdvance();
+		else
+			break;
+	}
 	literal.complete();
 	return TokenTraits::fromIdentifierOrKeyword(m_nextToken.literal);
 }
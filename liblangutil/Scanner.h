@@ -96,6 +96,8 @@ public:
 	std::string const& source() const noexcept { return m_source->source(); }
 
 	std::shared_ptr<CharStream> charStream() noexcept { return m_source; }
+	/// @returns the ID of the underlying character stream, used to refer to it from source locations.
+	int sourceId() const noexcept { return m_source->sourceId(); }
 
 	/// Resets the scanner as if newly constructed with _source as input.
 	void reset(CharStream _source);
@@ -160,14 +162,17 @@ public:
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
 	std::string lineAtPosition(int _position) const { return m_source->lineAtPosition(_position); }
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const { return m_source->translatePositionToLineColumn(_position); }
+	std::vector<std::tuple<int, int>> translatePositionsToLineColumns(std::vector<int> const& _positions) const
+	{
+		return m_source->translatePositionsToLineColumns(_positions);
+	}
 	std::string sourceAt(SourceLocation const& _location) const
 	{
 		solAssert(!_location.isEmpty(), "");
-		solAssert(m_source.get() == _location.source.get(), "CharStream memory locations must match.");
-		return m_source->source().substr(_location.start, _location.end - _location.start);
+		solAssert(m_source->sourceId() == _location.sourceId, "Source IDs must match.");
+		return std::string(m_source->data() + _location.start, m_source->data() + _location.end);
 	}
 	///@}
 
@@ -23,9 +23,6 @@
 #pragma once
 
 #include <libdevcore/Common.h> // defines noexcept macro for MSVC
-#include <liblangutil/CharStream.h>
-#include <memory>
-#include <string>
 #include <ostream>
 #include <tuple>
 
@@ -35,12 +32,14 @@ namespace langutil
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
+ * The source is referred to by the ID of its CharStream, use a SourceRegistry to
+ * look up its name and contents. A negative ID means that the source is unknown.
  */
 struct SourceLocation
 {
 	bool operator==(SourceLocation const& _other) const
 	{
-		return source.get() == _other.source.get() && start == _other.start && end == _other.end;
+		return sourceId == _other.sourceId && start == _other.start && end == _other.end;
 	}
 	bool operator!=(SourceLocation const& _other) const { return !operator==(_other); }
 	inline bool operator<(SourceLocation const& _other) const;
@@ -48,6 +47,7 @@ struct SourceLocation
 	inline bool intersects(SourceLocation const& _other) const;
 
 	bool isEmpty() const { return start == -1 && end == -1; }
+	bool hasSource() const { return sourceId >= 0; }
 
 	/// @returns the smallest SourceLocation that contains both @param _a and @param _b.
 	/// Assumes that @param _a and @param _b refer to the same source (exception: if the source of either one
@@ -56,8 +56,8 @@ struct SourceLocation
 	/// @param _b, then start resp. end of the result will be -1 as well).
 	static SourceLocation smallestCovering(SourceLocation _a, SourceLocation const& _b)
 	{
-		if (!_a.source)
-			_a.source = _b.source;
+		if (!_a.hasSource())
+			_a.sourceId = _b.sourceId;
 
 		if (_a.start < 0)
 			_a.start = _b.start;
@@ -71,7 +71,7 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<CharStream> source;
+	int sourceId = -1;
 };
 
 /// Stream output for Location (used e.g. in boost exceptions).
@@ -80,8 +80,8 @@ inline std::ostream& operator<<(std::ostream& _out, SourceLocation const& _locat
 	if (_location.isEmpty())
 		return _out << "NO_LOCATION_SPECIFIED";
 
-	if (_location.source)
-		_out << _location.source->name();
+	if (_location.hasSource())
+		_out << "#" << _location.sourceId;
 
 	_out << "[" << _location.start << "," << _location.end << ")";
 
@@ -90,22 +90,19 @@ inline std::ostream& operator<<(std::ostream& _out, SourceLocation const& _locat
 
 bool SourceLocation::operator<(SourceLocation const& _other) const
 {
-	if (!source|| !_other.source)
-		return std::make_tuple(int(!!source), start, end) < std::make_tuple(int(!!_other.source), _other.start, _other.end);
-	else
-		return std::make_tuple(source->name(), start, end) < std::make_tuple(_other.source->name(), _other.start, _other.end);
+	return std::make_tuple(sourceId, start, end) < std::make_tuple(_other.sourceId, _other.start, _other.end);
 }
 
 bool SourceLocation::contains(SourceLocation const& _other) const
 {
-	if (isEmpty() || _other.isEmpty() || source.get() != _other.source.get())
+	if (isEmpty() || _other.isEmpty() || sourceId != _other.sourceId)
 		return false;
 	return start <= _other.start && _other.end <= end;
 }
 
 bool SourceLocation::intersects(SourceLocation const& _other) const
 {
-	if (isEmpty() || _other.isEmpty() || source.get() != _other.source.get())
+	if (isEmpty() || _other.isEmpty() || sourceId != _other.sourceId)
 		return false;
 	return _other.start < end && start < _other.end;
 }
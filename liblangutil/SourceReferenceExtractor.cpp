@@ -17,6 +17,7 @@
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceRegistry.h>
 
 #include <cmath>
 #include <iomanip>
@@ -25,32 +26,40 @@ using namespace std;
 using namespace dev;
 using namespace langutil;
 
-SourceReferenceExtractor::Message SourceReferenceExtractor::extract(Exception const& _exception, string _category)
+SourceReferenceExtractor::Message SourceReferenceExtractor::extract(
+	Exception const& _exception,
+	string _category,
+	SourceRegistry const& _sources
+)
 {
 	SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_exception);
 
 	string const* message = boost::get_error_info<errinfo_comment>(_exception);
-	SourceReference primary = extract(location, message ? *message : "");
+	SourceReference primary = extract(location, _sources, message ? *message : "");
 
 	std::vector<SourceReference> secondary;
 	auto secondaryLocation = boost::get_error_info<errinfo_secondarySourceLocation>(_exception);
 	if (secondaryLocation && !secondaryLocation->infos.empty())
 		for (auto const& info: secondaryLocation->infos)
-			secondary.emplace_back(extract(&info.second, info.first));
+			secondary.emplace_back(extract(&info.second, _sources, info.first));
 
 	return Message{std::move(primary), _category, std::move(secondary)};
 }
 
-SourceReference SourceReferenceExtractor::extract(SourceLocation const* _location, std::string message)
+SourceReference SourceReferenceExtractor::extract(
+	SourceLocation const* _location,
+	SourceRegistry const& _sources,
+	std::string message
+)
 {
-	if (!_location || !_location->source.get()) // Nothing we can extract here
+	CharStream const* source = _location ? _sources.charStream(*_location) : nullptr;
+	if (!source) // Nothing we can extract here
 		return SourceReference::MessageOnly(std::move(message));
 
-	shared_ptr<CharStream> const& source = _location->source;
-
-	LineColumn const interest = source->translatePositionToLineColumn(_location->start);
+	auto const lineColumns = source->translatePositionsToLineColumns({_location->start, _location->end});
+	LineColumn const interest = lineColumns[0];
 	LineColumn start = interest;
-	LineColumn end = source->translatePositionToLineColumn(_location->end);
+	LineColumn end = lineColumns[1];
 	bool const isMultiline = start.line != end.line;
 
 	string line = source->lineAtPosition(_location->start);
@@ -58,6 +58,7 @@ struct SourceReference
 };
 
 struct SourceLocation;
+class SourceRegistry;
 
 namespace SourceReferenceExtractor
 {
@@ -68,8 +69,10 @@ namespace SourceReferenceExtractor
 		std::vector<SourceReference> secondary;
 	};
 
-	Message extract(dev::Exception const& _exception, std::string _category);
-	SourceReference extract(SourceLocation const* _location, std::string message = "");
+	/// Looks up the sources the locations refer to in @a _sources. Locations of sources
+	/// that are not registered result in references that only contain the message.
+	Message extract(dev::Exception const& _exception, std::string _category, SourceRegistry const& _sources);
+	SourceReference extract(SourceLocation const* _location, SourceRegistry const& _sources, std::string message = "");
 }
 
 }
@@ -30,7 +30,7 @@ using namespace langutil;
 
 void SourceReferenceFormatter::printSourceLocation(SourceLocation const* _location)
 {
-	printSourceLocation(SourceReferenceExtractor::extract(_location));
+	printSourceLocation(SourceReferenceExtractor::extract(_location, m_sources));
 }
 
 void SourceReferenceFormatter::printSourceLocation(SourceReference const& _ref)
@@ -72,7 +72,7 @@ void SourceReferenceFormatter::printSourceName(SourceReference const& _ref)
 
 void SourceReferenceFormatter::printExceptionInformation(dev::Exception const& _exception, std::string const& _category)
 {
-	printExceptionInformation(SourceReferenceExtractor::extract(_exception, _category));
+	printExceptionInformation(SourceReferenceExtractor::extract(_exception, _category, m_sources));
 }
 
 void SourceReferenceFormatter::printErrorInformation(Error const& _error)
@@ -27,6 +27,7 @@
 #include <functional>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceReferenceExtractor.h>
+#include <liblangutil/SourceRegistry.h>
 
 namespace dev
 {
@@ -36,13 +37,14 @@ struct Exception; // forward
 namespace langutil
 {
 struct SourceLocation;
-class Scanner;
 
 class SourceReferenceFormatter
 {
 public:
-	explicit SourceReferenceFormatter(std::ostream& _stream):
-		m_stream(_stream)
+	/// @param _sources provides the names and contents of the sources the printed locations refer to.
+	SourceReferenceFormatter(std::ostream& _stream, SourceRegistry const& _sources):
+		m_stream(_stream),
+		m_sources(_sources)
 	{}
 
 	virtual ~SourceReferenceFormatter() = default;
@@ -55,22 +57,24 @@ public:
 	virtual void printExceptionInformation(dev::Exception const& _exception, std::string const& _category);
 	virtual void printErrorInformation(Error const& _error);
 
-	static std::string formatErrorInformation(Error const& _error)
+	static std::string formatErrorInformation(Error const& _error, SourceRegistry const& _sources)
 	{
 		return formatExceptionInformation(
 			_error,
-			(_error.type() == Error::Type::Warning) ? "Warning" : "Error"
+			(_error.type() == Error::Type::Warning) ? "Warning" : "Error",
+			_sources
 		);
 	}
 
 	static std::string formatExceptionInformation(
 		dev::Exception const& _exception,
-		std::string const& _name
+		std::string const& _name,
+		SourceRegistry const& _sources
 	)
 	{
 		std::ostringstream errorOutput;
 
-		SourceReferenceFormatter formatter(errorOutput);
+		SourceReferenceFormatter formatter(errorOutput, _sources);
 		formatter.printExceptionInformation(_exception, _name);
 		return errorOutput.str();
 	}
@@ -80,6 +84,7 @@ protected:
 	void printSourceName(SourceReference const& _ref);
 
 	std::ostream& m_stream;
+	SourceRegistry const& m_sources;
 };
 
 }
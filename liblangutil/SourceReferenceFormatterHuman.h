@@ -43,8 +43,8 @@ struct SourceReference;
 class SourceReferenceFormatterHuman: public SourceReferenceFormatter
 {
 public:
-	SourceReferenceFormatterHuman(std::ostream& _stream, bool colored):
-		SourceReferenceFormatter{_stream}, m_colored{colored}
+	SourceReferenceFormatterHuman(std::ostream& _stream, SourceRegistry const& _sources, bool colored):
+		SourceReferenceFormatter{_stream, _sources}, m_colored{colored}
 	{}
 
 	void printSourceLocation(SourceReference const& _ref) override;
@@ -54,12 +54,13 @@ public:
 	static std::string formatExceptionInformation(
 		dev::Exception const& _exception,
 		std::string const& _name,
+		SourceRegistry const& _sources,
 		bool colored = false
 	)
 	{
 		std::ostringstream errorOutput;
 
-		SourceReferenceFormatterHuman formatter(errorOutput, colored);
+		SourceReferenceFormatterHuman formatter(errorOutput, _sources, colored);
 		formatter.printExceptionInformation(_exception, _name);
 		return errorOutput.str();
 	}
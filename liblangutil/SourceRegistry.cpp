@@ -0,0 +1,58 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Maps the source IDs used in source locations to character streams.
+ */
+
+#include <liblangutil/SourceRegistry.h>
+
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceLocation.h>
+
+using namespace std;
+using namespace langutil;
+
+void SourceRegistry::add(shared_ptr<CharStream> _source)
+{
+	solAssert(_source && _source->sourceId() >= 0, "Source without ID registered.");
+	int sourceId = _source->sourceId();
+	m_sources[sourceId] = std::move(_source);
+}
+
+void SourceRegistry::add(SourceRegistry const& _other)
+{
+	for (auto const& source: _other.m_sources)
+		m_sources[source.first] = source.second;
+}
+
+CharStream const* SourceRegistry::charStream(int _sourceId) const
+{
+	auto it = m_sources.find(_sourceId);
+	return it == m_sources.end() ? nullptr : it->second.get();
+}
+
+CharStream const* SourceRegistry::charStream(SourceLocation const& _location) const
+{
+	return charStream(_location.sourceId);
+}
+
+string const& SourceRegistry::name(int _sourceId) const
+{
+	static string const empty;
+	CharStream const* stream = charStream(_sourceId);
+	return stream ? stream->name() : empty;
+}
@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Maps the source IDs used in source locations to character streams.
+ */
+
+#pragma once
+
+#include <liblangutil/CharStream.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace langutil
+{
+
+struct SourceLocation;
+
+/**
+ * Owns the character streams of a compilation and provides their names and contents
+ * to everything that has to turn a SourceLocation into something human-readable.
+ */
+class SourceRegistry
+{
+public:
+	SourceRegistry() = default;
+	/// Convenience constructor for a registry that only contains @a _source.
+	explicit SourceRegistry(std::shared_ptr<CharStream> _source) { add(std::move(_source)); }
+
+	/// Registers @a _source under its ID, replacing a stream with the same ID.
+	void add(std::shared_ptr<CharStream> _source);
+	/// Registers all streams of @a _other.
+	void add(SourceRegistry const& _other);
+	void clear() { m_sources.clear(); }
+
+	/// @returns the stream with the given ID or nullptr if it is not registered.
+	CharStream const* charStream(int _sourceId) const;
+	/// @returns the stream the location refers to or nullptr if it is not registered.
+	CharStream const* charStream(SourceLocation const& _location) const;
+	/// @returns the name of the source with the given ID or an empty string if it is not registered.
+	std::string const& name(int _sourceId) const;
+
+private:
+	std::map<int, std::shared_ptr<CharStream>> m_sources;
+};
+
+}
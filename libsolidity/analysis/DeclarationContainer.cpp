@@ -26,6 +26,8 @@
 #include <libsolidity/ast/Types.h>
 #include <libdevcore/StringUtils.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
@@ -39,10 +41,12 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	auto visible = m_declarations.find(*_name);
+	if (visible != m_declarations.end())
+		declarations += visible->second;
+	auto invisible = m_invisibleDeclarations.find(*_name);
+	if (invisible != m_invisibleDeclarations.end())
+		declarations += invisible->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -80,15 +84,34 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 	return nullptr;
 }
 
+map<ASTString, vector<Declaration const*>> DeclarationContainer::declarations() const
+{
+	return map<ASTString, vector<Declaration const*>>(m_declarations.begin(), m_declarations.end());
+}
+
+vector<pair<ASTString const*, Declaration const*>> DeclarationContainer::declarationsInScope(ASTNode const* _scope) const
+{
+	vector<pair<ASTString const*, Declaration const*>> result;
+	for (auto const& nameAndDeclarations: m_declarations)
+		for (Declaration const* declaration: nameAndDeclarations.second)
+			if (declaration->scope() == _scope)
+				result.emplace_back(&nameAndDeclarations.first, declaration);
+	// Keep the order of the declarations with the same name.
+	stable_sort(result.begin(), result.end(), [](auto const& _a, auto const& _b) { return *_a.first < *_b.first; });
+	return result;
+}
+
 void DeclarationContainer::activateVariable(ASTString const& _name)
 {
+	auto invisible = m_invisibleDeclarations.find(_name);
 	solAssert(
-		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
+		invisible != m_invisibleDeclarations.end() && invisible->second.size() == 1,
 		"Tried to activate a non-inactive variable or multiple inactive variables with the same name."
 	);
-	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
-	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
-	m_invisibleDeclarations.erase(_name);
+	vector<Declaration const*>& declarations = m_declarations[_name];
+	solAssert(declarations.empty(), "");
+	declarations.emplace_back(invisible->second.front());
+	m_invisibleDeclarations.erase(invisible);
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
@@ -127,12 +150,22 @@ vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _n
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	vector<Declaration const*> result;
-	if (m_declarations.count(_name))
-		result = m_declarations.at(_name);
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
-		result += m_invisibleDeclarations.at(_name);
-	if (result.empty() && _recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible);
+	for (
+		DeclarationContainer const* container = this;
+		container && result.empty();
+		container = _recursive ? container->m_enclosingContainer : nullptr
+	)
+	{
+		auto visible = container->m_declarations.find(_name);
+		if (visible != container->m_declarations.end())
+			result = visible->second;
+		if (_alsoInvisible)
+		{
+			auto invisible = container->m_invisibleDeclarations.find(_name);
+			if (invisible != container->m_invisibleDeclarations.end())
+				result += invisible->second;
+		}
+	}
 	return result;
 }
 
@@ -145,17 +178,17 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 
 	vector<ASTString> similar;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
+	for (auto const* declarations: {&m_declarations, &m_invisibleDeclarations})
 	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
-	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		// Sort the names of each table to keep the suggestions independent of the hash order.
+		size_t begin = similar.size();
+		for (auto const& declaration: *declarations)
+		{
+			string const& declarationName = declaration.first;
+			if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+				similar.push_back(declarationName);
+		}
+		sort(similar.begin() + begin, similar.end());
 	}
 
 	if (m_enclosingContainer)
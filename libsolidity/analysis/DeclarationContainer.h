@@ -26,6 +26,7 @@
 #include <boost/noncopyable.hpp>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 namespace dev
 {
@@ -35,6 +36,9 @@ namespace solidity
 /**
  * Container that stores mappings between names and declarations. It also contains a link to the
  * enclosing scope.
+ * Names are stored in hash tables, since they are looked up for every identifier. The scopes of
+ * contracts also contain the declarations inherited from their bases, so resolving a name only
+ * walks the scopes that are lexically enclosing it.
  */
 class DeclarationContainer
 {
@@ -53,7 +57,10 @@ public:
 	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false, bool _alsoInvisible = false) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations sorted by name.
+	std::map<ASTString, std::vector<Declaration const*>> declarations() const;
+	/// @returns the visible declarations whose scope is @a _scope, sorted by name.
+	std::vector<std::pair<ASTString const*, Declaration const*>> declarationsInScope(ASTNode const* _scope) const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -71,8 +78,8 @@ public:
 private:
 	ASTNode const* m_enclosingNode;
 	DeclarationContainer const* m_enclosingContainer;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_declarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
 };
 
 }
@@ -38,7 +38,7 @@ namespace solidity
 
 NameAndTypeResolver::NameAndTypeResolver(
 	GlobalContext& _globalContext,
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
 	ErrorReporter& _errorReporter
 ) :
 	m_scopes(_scopes),
@@ -332,42 +332,45 @@ void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
 {
 	auto iterator = m_scopes.find(&_base);
 	solAssert(iterator != end(m_scopes), "");
-	for (auto const& nameAndDeclaration: iterator->second->declarations())
-		for (auto const& declaration: nameAndDeclaration.second)
-			// Import if it was declared in the base, is not the constructor and is visible in derived classes
-			if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
-				if (!m_currentScope->registerDeclaration(*declaration))
-				{
-					SourceLocation firstDeclarationLocation;
-					SourceLocation secondDeclarationLocation;
-					Declaration const* conflictingDeclaration = m_currentScope->conflictingDeclaration(*declaration);
-					solAssert(conflictingDeclaration, "");
-
-					// Usual shadowing is not an error
-					if (dynamic_cast<VariableDeclaration const*>(declaration) && dynamic_cast<VariableDeclaration const*>(conflictingDeclaration))
-						continue;
+	// Only the declarations of the base itself are considered, its own bases are imported separately.
+	for (auto const& nameAndDeclaration: iterator->second->declarationsInScope(&_base))
+	{
+		Declaration const* declaration = nameAndDeclaration.second;
+		// Import if it is not the constructor and is visible in derived classes
+		if (declaration->isVisibleInDerivedContracts())
+			if (!m_currentScope->registerDeclaration(*declaration))
+			{
+				SourceLocation firstDeclarationLocation;
+				SourceLocation secondDeclarationLocation;
+				Declaration const* conflictingDeclaration = m_currentScope->conflictingDeclaration(*declaration);
+				solAssert(conflictingDeclaration, "");
 
-					// Usual shadowing is not an error
-					if (dynamic_cast<ModifierDefinition const*>(declaration) && dynamic_cast<ModifierDefinition const*>(conflictingDeclaration))
-						continue;
+				// Usual shadowing is not an error
+				if (dynamic_cast<VariableDeclaration const*>(declaration) && dynamic_cast<VariableDeclaration const*>(conflictingDeclaration))
+					continue;
 
-					if (declaration->location().start < conflictingDeclaration->location().start)
-					{
-						firstDeclarationLocation = declaration->location();
-						secondDeclarationLocation = conflictingDeclaration->location();
-					}
-					else
-					{
-						firstDeclarationLocation = conflictingDeclaration->location();
-						secondDeclarationLocation = declaration->location();
-					}
+				// Usual shadowing is not an error
+				if (dynamic_cast<ModifierDefinition const*>(declaration) && dynamic_cast<ModifierDefinition const*>(conflictingDeclaration))
+					continue;
 
-					m_errorReporter.declarationError(
-						secondDeclarationLocation,
-						SecondarySourceLocation().append("The previous declaration is here:", firstDeclarationLocation),
-						"Identifier already declared."
-					);
+				if (declaration->location().start < conflictingDeclaration->location().start)
+				{
+					firstDeclarationLocation = declaration->location();
+					secondDeclarationLocation = conflictingDeclaration->location();
+				}
+				else
+				{
+					firstDeclarationLocation = conflictingDeclaration->location();
+					secondDeclarationLocation = declaration->location();
 				}
+
+				m_errorReporter.declarationError(
+					secondDeclarationLocation,
+					SecondarySourceLocation().append("The previous declaration is here:", firstDeclarationLocation),
+					"Identifier already declared."
+				);
+			}
+	}
 }
 
 void NameAndTypeResolver::linearizeBaseContracts(ContractDefinition& _contract)
@@ -454,7 +457,7 @@ string NameAndTypeResolver::similarNameSuggestions(ASTString const& _name) const
 }
 
 DeclarationRegistrationHelper::DeclarationRegistrationHelper(
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
 	ASTNode& _astRoot,
 	ErrorReporter& _errorReporter,
 	GlobalContext& _globalContext,
@@ -498,9 +501,8 @@ bool DeclarationRegistrationHelper::registerDeclaration(
 		Declaration const* conflictingDeclaration = _container.conflictingDeclaration(_declaration, _name);
 		solAssert(conflictingDeclaration, "");
 		bool const comparable =
-			_errorLocation->source &&
-			conflictingDeclaration->location().source &&
-			_errorLocation->source->name() == conflictingDeclaration->location().source->name();
+			_errorLocation->hasSource() &&
+			_errorLocation->sourceId == conflictingDeclaration->location().sourceId;
 		if (comparable && _errorLocation->start < conflictingDeclaration->location().start)
 		{
 			firstDeclarationLocation = *_errorLocation;
@@ -701,7 +703,7 @@ void DeclarationRegistrationHelper::endVisit(EventDefinition&)
 
 void DeclarationRegistrationHelper::enterNewSubScope(ASTNode& _subScope)
 {
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>::iterator iter;
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>::iterator iter;
 	bool newlyAdded;
 	shared_ptr<DeclarationContainer> container(new DeclarationContainer(m_currentScope, m_scopes[m_currentScope].get()));
 	tie(iter, newlyAdded) = m_scopes.emplace(&_subScope, move(container));
@@ -38,6 +38,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 using namespace std;
@@ -137,7 +138,7 @@ TypePointers TypeChecker::typeCheckABIDecodeAndRetrieveReturnType(FunctionCall c
 
 	if (arguments.size() >= 1)
 	{
-		BoolResult result = type(*arguments.front())->isImplicitlyConvertibleTo(*TypeProvider::bytesMemory());
+		BoolResult result = TypeProvider::isImplicitlyConvertible(*type(*arguments.front()), *TypeProvider::bytesMemory());
 
 		if (!result)
 			m_errorReporter.typeErrorConcatenateDescriptions(
@@ -265,7 +266,7 @@ void TypeChecker::endVisit(InheritanceSpecifier const& _inheritance)
 		}
 		for (size_t i = 0; i < std::min(arguments->size(), parameterTypes.size()); ++i)
 		{
-			BoolResult result = type(*(*arguments)[i])->isImplicitlyConvertibleTo(*parameterTypes[i]);
+			BoolResult result = TypeProvider::isImplicitlyConvertible(*type(*(*arguments)[i]), *parameterTypes[i]);
 			if (!result)
 				m_errorReporter.typeErrorConcatenateDescriptions(
 					(*arguments)[i]->location(),
@@ -559,7 +560,7 @@ void TypeChecker::visitManually(
 	}
 	for (size_t i = 0; i < arguments.size(); ++i)
 	{
-		BoolResult result = type(*arguments[i])->isImplicitlyConvertibleTo(*type(*(*parameters)[i]));
+		BoolResult result = TypeProvider::isImplicitlyConvertible(*type(*arguments[i]), *type(*(*parameters)[i]));
 		if (!result)
 			m_errorReporter.typeErrorConcatenateDescriptions(
 				arguments[i]->location(),
@@ -724,6 +725,10 @@ bool TypeChecker::visit(InlineAssembly const& _inlineAssembly)
 	};
 	solAssert(!_inlineAssembly.annotation().analysisInfo, "");
 	_inlineAssembly.annotation().analysisInfo = make_shared<yul::AsmAnalysisInfo>();
+	// The Yul analysis uses process-wide state (the YulString repository), so the assembly
+	// blocks of contracts that are checked concurrently are analysed one at a time.
+	static mutex yulAnalysisMutex;
+	lock_guard<mutex> lock(yulAnalysisMutex);
 	yul::AsmAnalyzer analyzer(
 		*_inlineAssembly.annotation().analysisInfo,
 		m_errorReporter,
@@ -804,7 +809,7 @@ void TypeChecker::endVisit(Return const& _return)
 	else
 	{
 		TypePointer const& expected = type(*params->parameters().front());
-		BoolResult result = type(*_return.expression())->isImplicitlyConvertibleTo(*expected);
+		BoolResult result = TypeProvider::isImplicitlyConvertible(*type(*_return.expression()), *expected);
 		if (!result)
 			m_errorReporter.typeErrorConcatenateDescriptions(
 				_return.expression()->location(),
@@ -1004,7 +1009,7 @@ bool TypeChecker::visit(VariableDeclarationStatement const& _statement)
 		else
 		{
 			var.accept(*this);
-			BoolResult result = valueComponentType->isImplicitlyConvertibleTo(*var.annotation().type);
+			BoolResult result = TypeProvider::isImplicitlyConvertible(*valueComponentType, *var.annotation().type);
 			if (!result)
 			{
 				auto errorMsg = "Type " +
@@ -1118,7 +1123,7 @@ bool TypeChecker::visit(Conditional const& _conditional)
 		BOOST_THROW_EXCEPTION(FatalError());
 	else if (trueType && falseType)
 	{
-		commonType = Type::commonType(trueType, falseType);
+		commonType = TypeProvider::commonType(trueType, falseType);
 
 		if (!commonType)
 		{
@@ -1212,7 +1217,8 @@ bool TypeChecker::visit(Assignment const& _assignment)
 	{
 		// compound assignment
 		_assignment.rightHandSide().accept(*this);
-		TypePointer resultType = t->binaryOperatorResult(
+		TypePointer resultType = TypeProvider::binaryOperatorResult(
+			*t,
 			TokenTraits::AssignmentToBinaryOp(_assignment.assignmentOperator()),
 			type(_assignment.rightHandSide())
 		);
@@ -1291,7 +1297,7 @@ bool TypeChecker::visit(TupleExpression const& _tuple)
 					if (i == 0)
 						inlineArrayType = types[i]->mobileType();
 					else if (inlineArrayType)
-						inlineArrayType = Type::commonType(inlineArrayType, types[i]);
+						inlineArrayType = TypeProvider::commonType(inlineArrayType, types[i]);
 				}
 				if (!components[i]->annotation().isPure)
 					isPure = false;
@@ -1352,7 +1358,7 @@ void TypeChecker::endVisit(BinaryOperation const& _operation)
 {
 	TypePointer const& leftType = type(_operation.leftExpression());
 	TypePointer const& rightType = type(_operation.rightExpression());
-	TypeResult result = leftType->binaryOperatorResult(_operation.getOperator(), rightType);
+	TypeResult result = TypeProvider::binaryOperatorResult(*leftType, _operation.getOperator(), rightType);
 	TypePointer commonType = result.get();
 	if (!commonType)
 	{
@@ -1789,7 +1795,7 @@ void TypeChecker::typeCheckFunctionGeneralChecks(
 	for (size_t i = 0; i < paramArgMap.size(); ++i)
 	{
 		solAssert(!!paramArgMap[i], "unmapped parameter");
-		if (!type(*paramArgMap[i])->isImplicitlyConvertibleTo(*parameterTypes[i]))
+		if (!TypeProvider::isImplicitlyConvertible(*type(*paramArgMap[i]), *parameterTypes[i]))
 		{
 			string msg =
 				"Invalid type for argument in function call. "
@@ -2145,7 +2151,7 @@ bool TypeChecker::visit(MemberAccess const& _memberAccess)
 
 	if (auto funType = dynamic_cast<FunctionType const*>(annotation.type))
 		solAssert(
-			!funType->bound() || exprType->isImplicitlyConvertibleTo(*funType->selfType()),
+			!funType->bound() || TypeProvider::isImplicitlyConvertible(*exprType, *funType->selfType()),
 			"Function \"" + memberName + "\" cannot be called on an object of type " +
 			exprType->toString() + " (expected " + funType->selfType()->toString() + ")."
 		);
@@ -2477,7 +2483,7 @@ Declaration const& TypeChecker::dereference(UserDefinedTypeName const& _typeName
 bool TypeChecker::expectType(Expression const& _expression, Type const& _expectedType)
 {
 	_expression.accept(*this);
-	if (!type(_expression)->isImplicitlyConvertibleTo(_expectedType))
+	if (!TypeProvider::isImplicitlyConvertible(*type(_expression), _expectedType))
 	{
 		auto errorMsg = "Type " +
 			type(_expression)->toString() +
@@ -134,12 +134,16 @@ private:
 bool ViewPureChecker::check()
 {
 	vector<ContractDefinition const*> contracts;
+	vector<ContractDefinition const*> checkedContracts;
 
 	for (auto const& node: m_ast)
 	{
 		SourceUnit const* source = dynamic_cast<SourceUnit const*>(node.get());
 		solAssert(source, "");
-		contracts += source->filteredNodes<ContractDefinition>(source->nodes());
+		auto sourceContracts = source->filteredNodes<ContractDefinition>(source->nodes());
+		contracts += sourceContracts;
+		if (!m_skippedSources.count(source))
+			checkedContracts += sourceContracts;
 	}
 
 	// Check modifiers first to infer their state mutability.
@@ -147,7 +151,7 @@ bool ViewPureChecker::check()
 		for (ModifierDefinition const* mod: contract->functionModifiers())
 			mod->accept(*this);
 
-	for (auto const& contract: contracts)
+	for (auto const& contract: checkedContracts)
 		contract->accept(*this);
 
 	return !m_errors;
@@ -23,6 +23,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 namespace langutil
 {
@@ -38,8 +39,14 @@ namespace solidity
 class ViewPureChecker: private ASTConstVisitor
 {
 public:
-	ViewPureChecker(std::vector<std::shared_ptr<ASTNode>> const& _ast, langutil::ErrorReporter& _errorReporter):
-		m_ast(_ast), m_errorReporter(_errorReporter) {}
+	/// @param _skippedSources source units from @a _ast that were already checked, only their
+	/// modifiers are visited to infer their state mutability.
+	ViewPureChecker(
+		std::vector<std::shared_ptr<ASTNode>> const& _ast,
+		langutil::ErrorReporter& _errorReporter,
+		std::set<ASTNode const*> _skippedSources = {}
+	):
+		m_ast(_ast), m_errorReporter(_errorReporter), m_skippedSources(std::move(_skippedSources)) {}
 
 	bool check();
 
@@ -72,6 +79,7 @@ private:
 
 	std::vector<std::shared_ptr<ASTNode>> const& m_ast;
 	langutil::ErrorReporter& m_errorReporter;
+	std::set<ASTNode const*> m_skippedSources;
 
 	bool m_errors = false;
 	MutabilityAndLocation m_bestMutabilityAndLocation = MutabilityAndLocation{StateMutability::Payable, langutil::SourceLocation()};
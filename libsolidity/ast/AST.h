@@ -106,12 +106,22 @@ public:
 	///@}
 
 protected:
+	/// @returns the annotation of this node, creating it on first use.
+	/// Has to be called with the same type on every call.
+	template <class T>
+	T& initAnnotation() const;
+
 	size_t const m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
+	/// Allocated in the arena of the node, if there is one.
 	mutable ASTAnnotation* m_annotation = nullptr;
 
 private:
+	friend class ASTArena;
+
 	SourceLocation m_location;
+	/// Arena the node was allocated in or nullptr if it was allocated on the heap.
+	ASTArena* m_arena = nullptr;
 };
 
 template <class _T>
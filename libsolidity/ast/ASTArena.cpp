@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Memory area for the AST nodes of a source unit and their annotations.
+ */
+
+#include <libsolidity/ast/ASTArena.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+/// Size of the blocks the arena allocates from the heap. Larger requests get their own block.
+/// Kept small because most sources are small and the unused rest of the last block is wasted.
+size_t const c_blockSize = 8 * 1024;
+}
+
+ASTArena::~ASTArena()
+{
+	// Release the strings before the blocks, nodes referring to them are already gone.
+	m_strings.clear();
+}
+
+ASTPointer<ASTString> ASTArena::intern(string const& _string)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_strings.find(boost::string_view(_string));
+	if (it != m_strings.end())
+		return it->second;
+	auto interned = make_shared<ASTString>(_string);
+	m_strings.emplace(boost::string_view(*interned), interned);
+	return interned;
+}
+
+void* ASTArena::allocate(size_t _size, size_t _alignment)
+{
+	solAssert(_alignment > 0 && (_alignment & (_alignment - 1)) == 0, "Invalid alignment.");
+	lock_guard<mutex> lock(m_mutex);
+	auto aligned = [&](char* _pointer) {
+		uintptr_t address = reinterpret_cast<uintptr_t>(_pointer);
+		return _pointer + ((_alignment - address % _alignment) % _alignment);
+	};
+	char* start = m_next ? aligned(m_next) : nullptr;
+	if (!start || start + _size > m_end)
+	{
+		size_t blockSize = max(c_blockSize, _size + _alignment);
+		m_blocks.emplace_back(new char[blockSize]);
+		m_bytesReserved += blockSize;
+		start = aligned(m_blocks.back().get());
+		// Keep allocating from the previous block if the new one was only made for this request.
+		if (blockSize == c_blockSize || !m_next)
+			m_end = m_blocks.back().get() + blockSize;
+		else
+		{
+			m_bytesUsed += _size;
+			return start;
+		}
+	}
+	m_next = start + _size;
+	m_bytesUsed += _size;
+	return start;
+}
+
+size_t ASTArena::StringViewHash::operator()(boost::string_view const& _string) const
+{
+	return boost::hash_range(_string.begin(), _string.end());
+}
@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Memory area for the AST nodes of a source unit and their annotations.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Allocates AST nodes (including their reference count) and annotations in large blocks
+ * that are only released together, when the arena is destroyed. Every node keeps a
+ * reference to its arena, so the arena lives as long as any of its nodes is used.
+ * Destructors of nodes and annotations are still run as usual.
+ *
+ * Also interns identifiers and literals, so that every distinct string is stored only once.
+ *
+ * Allocation is thread-safe because annotations are created lazily during analysis.
+ */
+class ASTArena: public std::enable_shared_from_this<ASTArena>, private boost::noncopyable
+{
+public:
+	/// Allocator for std::allocate_shared that places objects in the arena and keeps it alive.
+	/// Deallocation is a no-op, the memory is released together with the arena.
+	template <class T>
+	class Allocator
+	{
+	public:
+		using value_type = T;
+
+		explicit Allocator(std::shared_ptr<ASTArena> _arena): m_arena(std::move(_arena)) {}
+		template <class U>
+		Allocator(Allocator<U> const& _other): m_arena(_other.arena()) {}
+
+		T* allocate(size_t _count)
+		{
+			return static_cast<T*>(m_arena->allocate(sizeof(T) * _count, alignof(T)));
+		}
+		void deallocate(T*, size_t) noexcept {}
+
+		std::shared_ptr<ASTArena> const& arena() const { return m_arena; }
+
+		template <class U>
+		bool operator==(Allocator<U> const& _other) const { return m_arena == _other.arena(); }
+		template <class U>
+		bool operator!=(Allocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+	private:
+		std::shared_ptr<ASTArena> m_arena;
+	};
+
+	static std::shared_ptr<ASTArena> create() { return std::shared_ptr<ASTArena>(new ASTArena()); }
+	~ASTArena();
+
+	/// Creates an AST node in the arena. The node keeps the arena alive and allocates
+	/// its annotation in the arena as well.
+	template <class NodeType, typename... Args>
+	ASTPointer<NodeType> createNode(Args&& ... _args)
+	{
+		ASTPointer<NodeType> node = std::allocate_shared<NodeType>(
+			Allocator<NodeType>(shared_from_this()),
+			std::forward<Args>(_args)...
+		);
+		node->m_arena = this;
+		return node;
+	}
+
+	/// Creates an object in the arena that is not reference counted.
+	/// It has to be destroyed explicitly, but its memory is not reclaimed before the
+	/// arena is destroyed.
+	template <class T, typename... Args>
+	T* createUnowned(Args&& ... _args)
+	{
+		return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(_args)...);
+	}
+
+	/// @returns a shared string equal to @a _string. Repeated calls with equal
+	/// strings return the same object.
+	ASTPointer<ASTString> intern(std::string const& _string);
+
+	/// @returns a pointer to @a _size bytes of memory with the given alignment.
+	void* allocate(size_t _size, size_t _alignment);
+
+	/// @returns the number of bytes handed out by the arena so far.
+	size_t bytesUsed() const { return m_bytesUsed; }
+	/// @returns the number of bytes reserved by the arena in its blocks.
+	size_t bytesReserved() const { return m_bytesReserved; }
+
+private:
+	ASTArena() = default;
+
+	struct StringViewHash
+	{
+		size_t operator()(boost::string_view const& _string) const;
+	};
+
+	std::mutex m_mutex;
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	char* m_next = nullptr;
+	char* m_end = nullptr;
+	size_t m_bytesUsed = 0;
+	size_t m_bytesReserved = 0;
+	/// Interned strings, the keys point into the values.
+	std::unordered_map<boost::string_view, ASTPointer<ASTString>, StringViewHash> m_strings;
+};
+
+}
+}
@@ -33,6 +33,7 @@ namespace dev
 namespace solidity
 {
 
+class ASTArena;
 class ASTNode;
 class SourceUnit;
 class PragmaDirective;
@@ -90,9 +91,8 @@ class Literal;
 
 class VariableScope;
 
-// Used as pointers to AST nodes, to be replaced by more clever pointers, e.g. pointers which do
-// not do reference counting but point to a special memory area that is completely released
-// explicitly.
+// Used as pointers to AST nodes. Nodes created by the parser (and their reference counts)
+// live in an ASTArena that is released as a whole once the last of its nodes is gone.
 template <class T>
 using ASTPointer = std::shared_ptr<T>;
 
@@ -24,6 +24,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libyul/AsmData.h>
 #include <libyul/AsmPrinter.h>
+#include <libdevcore/JSON.h>
 #include <libdevcore/UTF8.h>
 #include <boost/algorithm/string/join.hpp>
 
@@ -35,96 +36,230 @@ namespace dev
 namespace solidity
 {
 
-ASTJsonConverter::ASTJsonConverter(bool _legacy, map<string, unsigned> _sourceIndices):
+ASTJsonConverter::ASTJsonConverter(bool _legacy, map<int, unsigned> _sourceIndices):
 	m_legacy(_legacy),
 	m_sourceIndices(_sourceIndices)
 {
 }
 
 
+ASTJsonConverter::AttributeValue ASTJsonConverter::AttributeValue::node(ASTNode const* _node)
+{
+	AttributeValue value(Kind::Node);
+	value.m_nodes.push_back(_node);
+	return value;
+}
+
 void ASTJsonConverter::setJsonNode(
 	ASTNode const& _node,
 	string const& _nodeName,
-	initializer_list<pair<string, Json::Value>>&& _attributes
+	initializer_list<pair<string, AttributeValue>>&& _attributes
 )
 {
 	ASTJsonConverter::setJsonNode(
 		_node,
 		_nodeName,
-		std::vector<pair<string, Json::Value>>(std::move(_attributes))
+		Attributes(std::move(_attributes))
 	);
 }
 
 void ASTJsonConverter::setJsonNode(
 	ASTNode const& _node,
 	string const& _nodeType,
-	std::vector<pair<string, Json::Value>>&& _attributes
+	Attributes&& _attributes
 )
 {
-	m_currentValue = Json::objectValue;
-	m_currentValue["id"] = nodeId(_node);
-	m_currentValue["src"] = sourceLocationToString(_node.location());
+	AttributeValue node = AttributeValue::object();
+	node.m_members.emplace("id", nodeId(_node));
+	node.m_members.emplace("src", sourceLocationToString(_node.location()));
 	if (!m_legacy)
 	{
-		m_currentValue["nodeType"] = _nodeType;
+		node.m_members.emplace("nodeType", _nodeType);
 		for (auto& e: _attributes)
-			m_currentValue[e.first] = std::move(e.second);
+		{
+			node.m_members.erase(e.first);
+			node.m_members.emplace(e.first, std::move(e.second));
+		}
+		output(std::move(node));
 	}
 	else
-	{
-		m_currentValue["name"] = _nodeType;
-		Json::Value attrs(Json::objectValue);
-		if (
-			//these nodeTypes need to have a children-node even if it is empty
-			(_nodeType == "VariableDeclaration") ||
-			(_nodeType == "ParameterList") ||
-			(_nodeType == "Block") ||
-			(_nodeType == "InlineAssembly") ||
-			(_nodeType == "Throw")
-		)
-			m_currentValue["children"] = Json::arrayValue;
+		output(legacyNode(_nodeType, std::move(node), std::move(_attributes)));
+}
 
-		for (auto& e: _attributes)
+ASTJsonConverter::AttributeValue ASTJsonConverter::legacyNode(
+	string const& _nodeType,
+	AttributeValue&& _node,
+	Attributes&& _attributes
+)
+{
+	_node.m_members.emplace("name", _nodeType);
+	AttributeValue attrs = AttributeValue::object();
+	AttributeValue children = AttributeValue::array();
+	bool hasChildren =
+		//these nodeTypes need to have a children-node even if it is empty
+		(_nodeType == "VariableDeclaration") ||
+		(_nodeType == "ParameterList") ||
+		(_nodeType == "Block") ||
+		(_nodeType == "InlineAssembly") ||
+		(_nodeType == "Throw");
+
+	for (auto& e: _attributes)
+	{
+		AttributeValue& value = e.second;
+		bool isChild = false;
+		switch (value.m_kind)
 		{
-			if ((!e.second.isNull()) && (
-				(e.second.isObject() && e.second.isMember("name")) ||
-				(e.second.isArray() && e.second[0].isObject() && e.second[0].isMember("name")) ||
+		case AttributeValue::Kind::Json:
+		{
+			Json::Value& json = value.m_json;
+			// Note that indexing an empty array appends null to it.
+			isChild = (!json.isNull()) && (
+				(json.isObject() && json.isMember("name")) ||
+				(json.isArray() && json[0].isObject() && json[0].isMember("name")) ||
 				(e.first == "declarations") // (in the case (_,x)= ... there's a nullpointer at [0]
-			))
+			);
+			break;
+		}
+		case AttributeValue::Kind::Node:
+			isChild = value.m_nodes.front();
+			break;
+		case AttributeValue::Kind::Nodes:
+			// Converted nodes are objects with a member "name", see above.
+			isChild = (!value.m_nodes.empty() && value.m_nodes.front()) || e.first == "declarations";
+			if (!isChild && value.m_nodes.empty())
 			{
-				if (e.second.isObject())
-				{
-					if (!m_currentValue["children"].isArray())
-						m_currentValue["children"] = Json::arrayValue;
-					appendMove(m_currentValue["children"], std::move(e.second));
-				}
-				if (e.second.isArray())
-					for (auto& child: e.second)
-						if (!child.isNull())
-						{
-							if (!m_currentValue["children"].isArray())
-								m_currentValue["children"] = Json::arrayValue;
-							appendMove(m_currentValue["children"], std::move(child));
-						}
+				Json::Value array(Json::arrayValue);
+				array.append(Json::nullValue);
+				value = std::move(array);
 			}
-			else
+			break;
+		default:
+			solAssert(false, "");
+		}
+
+		if (isChild)
+		{
+			hasChildren = true;
+			if (value.m_kind == AttributeValue::Kind::Json && value.m_json.isObject())
+				children.m_elements.emplace_back(std::move(value.m_json));
+			else if (value.m_kind == AttributeValue::Kind::Json)
 			{
-				if (e.first == "typeDescriptions")
-					attrs["type"] = Json::Value(e.second["typeString"]);
-				else
-					attrs[e.first] = std::move(e.second);
+				for (auto& child: value.m_json)
+					if (!child.isNull())
+						children.m_elements.emplace_back(std::move(child));
 			}
+			else
+				for (ASTNode const* child: value.m_nodes)
+					if (child)
+						children.m_elements.emplace_back(AttributeValue::node(child));
+		}
+		else
+		{
+			string name = e.first == "typeDescriptions" ? "type" : e.first;
+			attrs.m_members.erase(name);
+			if (e.first == "typeDescriptions")
+				attrs.m_members.emplace(name, Json::Value(value.m_json["typeString"]));
+			else
+				attrs.m_members.emplace(name, std::move(value));
+		}
+	}
+	if (hasChildren)
+		_node.m_members.emplace("children", std::move(children));
+	if (!attrs.m_members.empty())
+		_node.m_members.emplace("attributes", std::move(attrs));
+	return std::move(_node);
+}
+
+void ASTJsonConverter::output(AttributeValue&& _value)
+{
+	if (m_writer)
+		write(_value);
+	else
+		m_currentValue = toJson(std::move(_value));
+}
+
+Json::Value ASTJsonConverter::toJson(AttributeValue&& _value)
+{
+	switch (_value.m_kind)
+	{
+	case AttributeValue::Kind::Json:
+		return std::move(_value.m_json);
+	case AttributeValue::Kind::Node:
+		return _value.m_nodes.front() ? Json::Value(toJson(*_value.m_nodes.front())) : Json::nullValue;
+	case AttributeValue::Kind::Nodes:
+	{
+		Json::Value nodes(Json::arrayValue);
+		for (ASTNode const* node: _value.m_nodes)
+			if (node)
+				appendMove(nodes, toJson(*node));
+			else
+				nodes.append(Json::nullValue);
+		return nodes;
+	}
+	case AttributeValue::Kind::Object:
+	{
+		Json::Value object(Json::objectValue);
+		for (auto& member: _value.m_members)
+			object[member.first] = toJson(std::move(member.second));
+		return object;
+	}
+	case AttributeValue::Kind::Array:
+	{
+		Json::Value array(Json::arrayValue);
+		for (auto& element: _value.m_elements)
+			appendMove(array, toJson(std::move(element)));
+		return array;
+	}
+	}
+	solAssert(false, "");
+	return Json::nullValue;
+}
+
+void ASTJsonConverter::write(AttributeValue const& _value)
+{
+	switch (_value.m_kind)
+	{
+	case AttributeValue::Kind::Json:
+		m_writer->value(_value.m_json);
+		break;
+	case AttributeValue::Kind::Node:
+		if (_value.m_nodes.front())
+			_value.m_nodes.front()->accept(*this);
+		else
+			m_writer->value(Json::nullValue);
+		break;
+	case AttributeValue::Kind::Nodes:
+		m_writer->beginArray();
+		for (ASTNode const* node: _value.m_nodes)
+			if (node)
+				node->accept(*this);
+			else
+				m_writer->value(Json::nullValue);
+		m_writer->endArray();
+		break;
+	case AttributeValue::Kind::Object:
+		m_writer->beginObject();
+		for (auto const& member: _value.m_members)
+		{
+			m_writer->key(member.first);
+			write(member.second);
 		}
-		if (!attrs.empty())
-			m_currentValue["attributes"] = std::move(attrs);
+		m_writer->endObject();
+		break;
+	case AttributeValue::Kind::Array:
+		m_writer->beginArray();
+		for (auto const& element: _value.m_elements)
+			write(element);
+		m_writer->endArray();
+		break;
 	}
 }
 
 string ASTJsonConverter::sourceLocationToString(SourceLocation const& _location) const
 {
 	int sourceIndex{-1};
-	if (_location.source && m_sourceIndices.count(_location.source->name()))
-		sourceIndex = m_sourceIndices.at(_location.source->name());
+	if (m_sourceIndices.count(_location.sourceId))
+		sourceIndex = m_sourceIndices.at(_location.sourceId);
 	int length = -1;
 	if (_location.start >= 0 && _location.end >= 0)
 		length = _location.end - _location.start;
@@ -158,19 +293,16 @@ Json::Value ASTJsonConverter::typePointerToJson(boost::optional<FuncCallArgument
 }
 
 void ASTJsonConverter::appendExpressionAttributes(
-	std::vector<pair<string, Json::Value>>& _attributes,
+	Attributes& _attributes,
 	ExpressionAnnotation const& _annotation
 )
 {
-	std::vector<pair<string, Json::Value>> exprAttributes = {
-		make_pair("typeDescriptions", typePointerToJson(_annotation.type)),
-		make_pair("isConstant", _annotation.isConstant),
-		make_pair("isPure", _annotation.isPure),
-		make_pair("isLValue", _annotation.isLValue),
-		make_pair("lValueRequested", _annotation.lValueRequested),
-		make_pair("argumentTypes", typePointerToJson(_annotation.arguments))
-	};
-	_attributes += exprAttributes;
+	_attributes.emplace_back("typeDescriptions", typePointerToJson(_annotation.type));
+	_attributes.emplace_back("isConstant", _annotation.isConstant);
+	_attributes.emplace_back("isPure", _annotation.isPure);
+	_attributes.emplace_back("isLValue", _annotation.isLValue);
+	_attributes.emplace_back("lValueRequested", _annotation.lValueRequested);
+	_attributes.emplace_back("argumentTypes", typePointerToJson(_annotation.arguments));
 }
 
 Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifier const* ,InlineAssemblyAnnotation::ExternalIdentifierInfo> _info) const
@@ -186,7 +318,16 @@ Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifie
 
 void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 {
-	_stream << toJson(_node);
+	JsonWriter writer(_stream, JsonWriter::Format::Styled);
+	write(writer, _node);
+}
+
+void ASTJsonConverter::write(JsonWriter& _writer, ASTNode const& _node)
+{
+	solAssert(!m_writer, "");
+	m_writer = &_writer;
+	_node.accept(*this);
+	m_writer = nullptr;
 }
 
 Json::Value&& ASTJsonConverter::toJson(ASTNode const& _node)
@@ -210,7 +351,7 @@ bool ASTJsonConverter::visit(SourceUnit const& _node)
 		{
 			make_pair("absolutePath", _node.annotation().path),
 			make_pair("exportedSymbols", move(exportedSymbols)),
-			make_pair("nodes", toJson(_node.nodes()))
+			make_pair("nodes", AttributeValue::nodes(_node.nodes()))
 		}
 	);
 	return false;
@@ -229,7 +370,7 @@ bool ASTJsonConverter::visit(PragmaDirective const& _node)
 
 bool ASTJsonConverter::visit(ImportDirective const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("file", _node.path()),
 		make_pair("absolutePath", _node.annotation().absolutePath),
 		make_pair(m_legacy ? "SourceUnit" : "sourceUnit", nodeId(*_node.annotation().sourceUnit)),
@@ -258,9 +399,9 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("contractKind", contractKind(_node.contractKind())),
 		make_pair("fullyImplemented", _node.annotation().unimplementedFunctions.empty()),
 		make_pair("linearizedBaseContracts", getContainerIds(_node.annotation().linearizedBaseContracts)),
-		make_pair("baseContracts", toJson(_node.baseContracts())),
+		make_pair("baseContracts", AttributeValue::nodes(_node.baseContracts())),
 		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies)),
-		make_pair("nodes", toJson(_node.subNodes())),
+		make_pair("nodes", AttributeValue::nodes(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	});
 	return false;
@@ -269,8 +410,8 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 bool ASTJsonConverter::visit(InheritanceSpecifier const& _node)
 {
 	setJsonNode(_node, "InheritanceSpecifier", {
-		make_pair("baseName", toJson(_node.name())),
-		make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json::nullValue)
+		make_pair("baseName", AttributeValue::node(&_node.name())),
+		make_pair("arguments", optionalNodes(_node.arguments()))
 	});
 	return false;
 }
@@ -278,8 +419,8 @@ bool ASTJsonConverter::visit(InheritanceSpecifier const& _node)
 bool ASTJsonConverter::visit(UsingForDirective const& _node)
 {
 	setJsonNode(_node, "UsingForDirective", {
-		make_pair("libraryName", toJson(_node.libraryName())),
-		make_pair("typeName", _node.typeName() ? toJson(*_node.typeName()) : Json::nullValue)
+		make_pair("libraryName", AttributeValue::node(&_node.libraryName())),
+		make_pair("typeName", AttributeValue::node(_node.typeName()))
 	});
 	return false;
 }
@@ -290,7 +431,7 @@ bool ASTJsonConverter::visit(StructDefinition const& _node)
 		make_pair("name", _node.name()),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
 		make_pair("canonicalName", _node.annotation().canonicalName),
-		make_pair("members", toJson(_node.members())),
+		make_pair("members", AttributeValue::nodes(_node.members())),
 		make_pair("scope", idOrNull(_node.scope()))
 	});
 	return false;
@@ -301,7 +442,7 @@ bool ASTJsonConverter::visit(EnumDefinition const& _node)
 	setJsonNode(_node, "EnumDefinition", {
 		make_pair("name", _node.name()),
 		make_pair("canonicalName", _node.annotation().canonicalName),
-		make_pair("members", toJson(_node.members()))
+		make_pair("members", AttributeValue::nodes(_node.members()))
 	});
 	return false;
 }
@@ -317,24 +458,24 @@ bool ASTJsonConverter::visit(EnumValue const& _node)
 bool ASTJsonConverter::visit(ParameterList const& _node)
 {
 	setJsonNode(_node, "ParameterList", {
-		make_pair("parameters", toJson(_node.parameters()))
+		make_pair("parameters", AttributeValue::nodes(_node.parameters()))
 	});
 	return false;
 }
 
 bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("name", _node.name()),
 		make_pair("documentation", _node.documentation() ? Json::Value(*_node.documentation()) : Json::nullValue),
 		make_pair("kind", _node.isConstructor() ? "constructor" : (_node.isFallback() ? "fallback" : "function")),
 		make_pair("stateMutability", stateMutabilityToString(_node.stateMutability())),
 		make_pair("superFunction", idOrNull(_node.annotation().superFunction)),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		make_pair("parameters", toJson(_node.parameterList())),
-		make_pair("returnParameters", toJson(*_node.returnParameterList())),
-		make_pair("modifiers", toJson(_node.modifiers())),
-		make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json::nullValue),
+		make_pair("parameters", AttributeValue::node(&_node.parameterList())),
+		make_pair("returnParameters", AttributeValue::node(_node.returnParameterList())),
+		make_pair("modifiers", AttributeValue::nodes(_node.modifiers())),
+		make_pair("body", AttributeValue::node(_node.isImplemented() ? &_node.body() : nullptr)),
 		make_pair("implemented", _node.isImplemented()),
 		make_pair("scope", idOrNull(_node.scope()))
 	};
@@ -346,14 +487,14 @@ bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 
 bool ASTJsonConverter::visit(VariableDeclaration const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("name", _node.name()),
-		make_pair("typeName", toJsonOrNull(_node.typeName())),
+		make_pair("typeName", AttributeValue::node(_node.typeName())),
 		make_pair("constant", _node.isConstant()),
 		make_pair("stateVariable", _node.isStateVariable()),
 		make_pair("storageLocation", location(_node.referenceLocation())),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		make_pair("value", _node.value() ? toJson(*_node.value()) : Json::nullValue),
+		make_pair("value", AttributeValue::node(_node.value())),
 		make_pair("scope", idOrNull(_node.scope())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	};
@@ -369,8 +510,8 @@ bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 		make_pair("name", _node.name()),
 		make_pair("documentation", _node.documentation() ? Json::Value(*_node.documentation()) : Json::nullValue),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		make_pair("parameters", toJson(_node.parameterList())),
-		make_pair("body", toJson(_node.body()))
+		make_pair("parameters", AttributeValue::node(&_node.parameterList())),
+		make_pair("body", AttributeValue::node(&_node.body()))
 	});
 	return false;
 }
@@ -378,8 +519,8 @@ bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 bool ASTJsonConverter::visit(ModifierInvocation const& _node)
 {
 	setJsonNode(_node, "ModifierInvocation", {
-		make_pair("modifierName", toJson(*_node.name())),
-		make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json::nullValue)
+		make_pair("modifierName", AttributeValue::node(_node.name())),
+		make_pair("arguments", optionalNodes(_node.arguments()))
 	});
 	return false;
 }
@@ -390,7 +531,7 @@ bool ASTJsonConverter::visit(EventDefinition const& _node)
 	setJsonNode(_node, "EventDefinition", {
 		make_pair("name", _node.name()),
 		make_pair("documentation", _node.documentation() ? Json::Value(*_node.documentation()) : Json::nullValue),
-		make_pair("parameters", toJson(_node.parameterList())),
+		make_pair("parameters", AttributeValue::node(&_node.parameterList())),
 		make_pair("anonymous", _node.isAnonymous())
 	});
 	return false;
@@ -398,7 +539,7 @@ bool ASTJsonConverter::visit(EventDefinition const& _node)
 
 bool ASTJsonConverter::visit(ElementaryTypeName const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("name", _node.typeName().toString()),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	};
@@ -426,8 +567,8 @@ bool ASTJsonConverter::visit(FunctionTypeName const& _node)
 	setJsonNode(_node, "FunctionTypeName", {
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
 		make_pair("stateMutability", stateMutabilityToString(_node.stateMutability())),
-		make_pair("parameterTypes", toJson(*_node.parameterTypeList())),
-		make_pair("returnParameterTypes", toJson(*_node.returnParameterTypeList())),
+		make_pair("parameterTypes", AttributeValue::node(_node.parameterTypeList())),
+		make_pair("returnParameterTypes", AttributeValue::node(_node.returnParameterTypeList())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -436,8 +577,8 @@ bool ASTJsonConverter::visit(FunctionTypeName const& _node)
 bool ASTJsonConverter::visit(Mapping const& _node)
 {
 	setJsonNode(_node, "Mapping", {
-		make_pair("keyType", toJson(_node.keyType())),
-		make_pair("valueType", toJson(_node.valueType())),
+		make_pair("keyType", AttributeValue::node(&_node.keyType())),
+		make_pair("valueType", AttributeValue::node(&_node.valueType())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -446,8 +587,8 @@ bool ASTJsonConverter::visit(Mapping const& _node)
 bool ASTJsonConverter::visit(ArrayTypeName const& _node)
 {
 	setJsonNode(_node, "ArrayTypeName", {
-		make_pair("baseType", toJson(_node.baseType())),
-		make_pair("length", toJsonOrNull(_node.length())),
+		make_pair("baseType", AttributeValue::node(&_node.baseType())),
+		make_pair("length", AttributeValue::node(_node.length())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -473,7 +614,7 @@ bool ASTJsonConverter::visit(InlineAssembly const& _node)
 bool ASTJsonConverter::visit(Block const& _node)
 {
 	setJsonNode(_node, "Block", {
-		make_pair("statements", toJson(_node.statements()))
+		make_pair("statements", AttributeValue::nodes(_node.statements()))
 	});
 	return false;
 }
@@ -487,9 +628,9 @@ bool ASTJsonConverter::visit(PlaceholderStatement const& _node)
 bool ASTJsonConverter::visit(IfStatement const& _node)
 {
 	setJsonNode(_node, "IfStatement", {
-		make_pair("condition", toJson(_node.condition())),
-		make_pair("trueBody", toJson(_node.trueStatement())),
-		make_pair("falseBody", toJsonOrNull(_node.falseStatement()))
+		make_pair("condition", AttributeValue::node(&_node.condition())),
+		make_pair("trueBody", AttributeValue::node(&_node.trueStatement())),
+		make_pair("falseBody", AttributeValue::node(_node.falseStatement()))
 	});
 	return false;
 }
@@ -500,8 +641,8 @@ bool ASTJsonConverter::visit(WhileStatement const& _node)
 		_node,
 		_node.isDoWhile() ? "DoWhileStatement" : "WhileStatement",
 		{
-			make_pair("condition", toJson(_node.condition())),
-			make_pair("body", toJson(_node.body()))
+			make_pair("condition", AttributeValue::node(&_node.condition())),
+			make_pair("body", AttributeValue::node(&_node.body()))
 		}
 	);
 	return false;
@@ -510,10 +651,10 @@ bool ASTJsonConverter::visit(WhileStatement const& _node)
 bool ASTJsonConverter::visit(ForStatement const& _node)
 {
 	setJsonNode(_node, "ForStatement", {
-		make_pair("initializationExpression", toJsonOrNull(_node.initializationExpression())),
-		make_pair("condition", toJsonOrNull(_node.condition())),
-		make_pair("loopExpression", toJsonOrNull(_node.loopExpression())),
-		make_pair("body", toJson(_node.body()))
+		make_pair("initializationExpression", AttributeValue::node(_node.initializationExpression())),
+		make_pair("condition", AttributeValue::node(_node.condition())),
+		make_pair("loopExpression", AttributeValue::node(_node.loopExpression())),
+		make_pair("body", AttributeValue::node(&_node.body()))
 	});
 	return false;
 }
@@ -533,7 +674,7 @@ bool ASTJsonConverter::visit(Break const& _node)
 bool ASTJsonConverter::visit(Return const& _node)
 {
 	setJsonNode(_node, "Return", {
-		make_pair("expression", toJsonOrNull(_node.expression())),
+		make_pair("expression", AttributeValue::node(_node.expression())),
 		make_pair("functionReturnParameters", idOrNull(_node.annotation().functionReturnParameters))
 	});
 	return false;
@@ -548,7 +689,7 @@ bool ASTJsonConverter::visit(Throw const& _node)
 bool ASTJsonConverter::visit(EmitStatement const& _node)
 {
 	setJsonNode(_node, "EmitStatement", {
-		make_pair("eventCall", toJson(_node.eventCall()))
+		make_pair("eventCall", AttributeValue::node(&_node.eventCall()))
 	});
 	return false;
 }
@@ -560,8 +701,8 @@ bool ASTJsonConverter::visit(VariableDeclarationStatement const& _node)
 		appendMove(varDecs, idOrNull(v.get()));
 	setJsonNode(_node, "VariableDeclarationStatement", {
 		make_pair("assignments", std::move(varDecs)),
-		make_pair("declarations", toJson(_node.declarations())),
-		make_pair("initialValue", toJsonOrNull(_node.initialValue()))
+		make_pair("declarations", AttributeValue::nodes(_node.declarations())),
+		make_pair("initialValue", AttributeValue::node(_node.initialValue()))
 	});
 	return false;
 }
@@ -569,17 +710,17 @@ bool ASTJsonConverter::visit(VariableDeclarationStatement const& _node)
 bool ASTJsonConverter::visit(ExpressionStatement const& _node)
 {
 	setJsonNode(_node, "ExpressionStatement", {
-		make_pair("expression", toJson(_node.expression()))
+		make_pair("expression", AttributeValue::node(&_node.expression()))
 	});
 	return false;
 }
 
 bool ASTJsonConverter::visit(Conditional const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
-		make_pair("condition", toJson(_node.condition())),
-		make_pair("trueExpression", toJson(_node.trueExpression())),
-		make_pair("falseExpression", toJson(_node.falseExpression()))
+	Attributes attributes = {
+		make_pair("condition", AttributeValue::node(&_node.condition())),
+		make_pair("trueExpression", AttributeValue::node(&_node.trueExpression())),
+		make_pair("falseExpression", AttributeValue::node(&_node.falseExpression()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Conditional", std::move(attributes));
@@ -588,10 +729,10 @@ bool ASTJsonConverter::visit(Conditional const& _node)
 
 bool ASTJsonConverter::visit(Assignment const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("operator", TokenTraits::toString(_node.assignmentOperator())),
-		make_pair("leftHandSide", toJson(_node.leftHandSide())),
-		make_pair("rightHandSide", toJson(_node.rightHandSide()))
+		make_pair("leftHandSide", AttributeValue::node(&_node.leftHandSide())),
+		make_pair("rightHandSide", AttributeValue::node(&_node.rightHandSide()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode( _node, "Assignment", std::move(attributes));
@@ -600,9 +741,9 @@ bool ASTJsonConverter::visit(Assignment const& _node)
 
 bool ASTJsonConverter::visit(TupleExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("isInlineArray", Json::Value(_node.isInlineArray())),
-		make_pair("components", toJson(_node.components())),
+		make_pair("components", AttributeValue::nodes(_node.components())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "TupleExpression", std::move(attributes));
@@ -611,10 +752,10 @@ bool ASTJsonConverter::visit(TupleExpression const& _node)
 
 bool ASTJsonConverter::visit(UnaryOperation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("prefix", _node.isPrefixOperation()),
 		make_pair("operator", TokenTraits::toString(_node.getOperator())),
-		make_pair("subExpression", toJson(_node.subExpression()))
+		make_pair("subExpression", AttributeValue::node(&_node.subExpression()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "UnaryOperation", std::move(attributes));
@@ -623,10 +764,10 @@ bool ASTJsonConverter::visit(UnaryOperation const& _node)
 
 bool ASTJsonConverter::visit(BinaryOperation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("operator", TokenTraits::toString(_node.getOperator())),
-		make_pair("leftExpression", toJson(_node.leftExpression())),
-		make_pair("rightExpression", toJson(_node.rightExpression())),
+		make_pair("leftExpression", AttributeValue::node(&_node.leftExpression())),
+		make_pair("rightExpression", AttributeValue::node(&_node.rightExpression())),
 		make_pair("commonType", typePointerToJson(_node.annotation().commonType)),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
@@ -639,10 +780,10 @@ bool ASTJsonConverter::visit(FunctionCall const& _node)
 	Json::Value names(Json::arrayValue);
 	for (auto const& name: _node.names())
 		names.append(Json::Value(*name));
-	std::vector<pair<string, Json::Value>> attributes = {
-		make_pair("expression", toJson(_node.expression())),
+	Attributes attributes = {
+		make_pair("expression", AttributeValue::node(&_node.expression())),
 		make_pair("names", std::move(names)),
-		make_pair("arguments", toJson(_node.arguments()))
+		make_pair("arguments", AttributeValue::nodes(_node.arguments()))
 	};
 	if (m_legacy)
 	{
@@ -658,8 +799,8 @@ bool ASTJsonConverter::visit(FunctionCall const& _node)
 
 bool ASTJsonConverter::visit(NewExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
-		make_pair("typeName", toJson(_node.typeName()))
+	Attributes attributes = {
+		make_pair("typeName", AttributeValue::node(&_node.typeName()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "NewExpression", std::move(attributes));
@@ -668,9 +809,9 @@ bool ASTJsonConverter::visit(NewExpression const& _node)
 
 bool ASTJsonConverter::visit(MemberAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair(m_legacy ? "member_name" : "memberName", _node.memberName()),
-		make_pair("expression", toJson(_node.expression())),
+		make_pair("expression", AttributeValue::node(&_node.expression())),
 		make_pair("referencedDeclaration", idOrNull(_node.annotation().referencedDeclaration)),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
@@ -680,9 +821,9 @@ bool ASTJsonConverter::visit(MemberAccess const& _node)
 
 bool ASTJsonConverter::visit(IndexAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
-		make_pair("baseExpression", toJson(_node.baseExpression())),
-		make_pair("indexExpression", toJsonOrNull(_node.indexExpression())),
+	Attributes attributes = {
+		make_pair("baseExpression", AttributeValue::node(&_node.baseExpression())),
+		make_pair("indexExpression", AttributeValue::node(_node.indexExpression())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexAccess", std::move(attributes));
@@ -706,7 +847,7 @@ bool ASTJsonConverter::visit(Identifier const& _node)
 
 bool ASTJsonConverter::visit(ElementaryTypeNameExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair(m_legacy ? "value" : "typeName", _node.typeName().toString())
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
@@ -720,7 +861,7 @@ bool ASTJsonConverter::visit(Literal const& _node)
 	if (!dev::validateUTF8(_node.value()))
 		value = Json::nullValue;
 	Token subdenomination = Token(_node.subDenomination());
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair(m_legacy ? "token" : "kind", literalTokenKind(_node.token())),
 		make_pair("value", value),
 		make_pair(m_legacy ? "hexvalue" : "hexValue", toHex(asBytes(_node.value()))),
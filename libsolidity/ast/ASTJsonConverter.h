@@ -27,8 +27,11 @@
 #include <liblangutil/Exceptions.h>
 
 #include <json/json.h>
+#include <map>
 #include <ostream>
 #include <stack>
+#include <type_traits>
+#include <vector>
 
 namespace langutil
 {
@@ -37,24 +40,30 @@ struct SourceLocation;
 
 namespace dev
 {
+class JsonWriter;
+
 namespace solidity
 {
 
 /**
- * Converter of the AST into JSON format
+ * Converter of the AST into JSON format, either as a Json::Value or written directly
+ * to a stream.
  */
 class ASTJsonConverter: public ASTConstVisitor
 {
 public:
 	/// Create a converter to JSON for the given abstract syntax tree.
 	/// @a _legacy if true, use legacy format
-	/// @a _sourceIndices is used to abbreviate source names in source locations.
+	/// @a _sourceIndices maps the source IDs of source locations to the indices
+	/// that are used to abbreviate the sources in the output.
 	explicit ASTJsonConverter(
 		bool _legacy,
-		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
+		std::map<int, unsigned> _sourceIndices = std::map<int, unsigned>()
 	);
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node);
+	/// Writes the json representation of the AST as the next value of @a _writer.
+	void write(JsonWriter& _writer, ASTNode const& _node);
 	Json::Value&& toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -116,25 +125,68 @@ public:
 	void endVisit(EventDefinition const&) override;
 
 private:
+	/// JSON value of an attribute. Nodes are only converted when the value is output,
+	/// which allows writing them to a stream directly.
+	class AttributeValue
+	{
+	public:
+		enum class Kind { Json, Node, Nodes, Object, Array };
+
+		template <class T, class = typename std::enable_if<std::is_constructible<Json::Value, T>::value>::type>
+		AttributeValue(T&& _json): m_json(std::forward<T>(_json)) {}
+		/// @returns the value of @a _node, or null if it is nullptr.
+		static AttributeValue node(ASTNode const* _node);
+		template <class T>
+		static AttributeValue node(ASTPointer<T> const& _node) { return node(_node.get()); }
+		template <class T>
+		static AttributeValue nodes(std::vector<ASTPointer<T>> const& _nodes)
+		{
+			AttributeValue value(Json::nullValue);
+			value.m_kind = Kind::Nodes;
+			for (auto const& node: _nodes)
+				value.m_nodes.push_back(node.get());
+			return value;
+		}
+		static AttributeValue object() { return AttributeValue(Kind::Object); }
+		static AttributeValue array() { return AttributeValue(Kind::Array); }
+
+		Kind m_kind = Kind::Json;
+		Json::Value m_json;
+		/// Nodes of kind Node (one node or nullptr) and Nodes.
+		std::vector<ASTNode const*> m_nodes;
+		std::map<std::string, AttributeValue> m_members;
+		std::vector<AttributeValue> m_elements;
+
+	private:
+		explicit AttributeValue(Kind _kind): m_kind(_kind) {}
+	};
+	using Attributes = std::vector<std::pair<std::string, AttributeValue>>;
+
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::initializer_list<std::pair<std::string, Json::Value>>&& _attributes
+		std::initializer_list<std::pair<std::string, AttributeValue>>&& _attributes
 	);
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::vector<std::pair<std::string, Json::Value>>&& _attributes
+		Attributes&& _attributes
 	);
+	/// @returns the node in the legacy format.
+	AttributeValue legacyNode(std::string const& _nodeType, AttributeValue&& _node, Attributes&& _attributes);
+	/// Sets m_currentValue to @a _value or writes it to m_writer.
+	void output(AttributeValue&& _value);
+	Json::Value toJson(AttributeValue&& _value);
+	void write(AttributeValue const& _value);
 	std::string sourceLocationToString(langutil::SourceLocation const& _location) const;
 	static std::string namePathToString(std::vector<ASTString> const& _namePath);
 	static Json::Value idOrNull(ASTNode const* _pt)
 	{
 		return _pt ? Json::Value(nodeId(*_pt)) : Json::nullValue;
 	}
-	Json::Value toJsonOrNull(ASTNode const* _node)
+	static AttributeValue optionalNodes(std::vector<ASTPointer<Expression>> const* _nodes)
 	{
-		return _node ? toJson(*_node) : Json::nullValue;
+		return _nodes ? AttributeValue::nodes(*_nodes) : AttributeValue(Json::nullValue);
 	}
 	Json::Value inlineAssemblyIdentifierToJson(std::pair<yul::Identifier const* , InlineAssemblyAnnotation::ExternalIdentifierInfo> _info) const;
 	static std::string location(VariableDeclaration::Location _location);
@@ -161,7 +213,7 @@ private:
 	static Json::Value typePointerToJson(TypePointer _tp, bool _short = false);
 	static Json::Value typePointerToJson(boost::optional<FuncCallArguments> const& _tps);
 	void appendExpressionAttributes(
-		std::vector<std::pair<std::string, Json::Value>> &_attributes,
+		Attributes& _attributes,
 		ExpressionAnnotation const& _annotation
 	);
 	static void appendMove(Json::Value& _array, Json::Value&& _value)
@@ -173,7 +225,9 @@ private:
 	bool m_legacy = false; ///< if true, use legacy format
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
-	std::map<std::string, unsigned> m_sourceIndices;
+	/// Writer the nodes are written to, if they are not converted to Json::Value.
+	JsonWriter* m_writer = nullptr;
+	std::map<int, unsigned> m_sourceIndices;
 };
 
 }
@@ -0,0 +1,1986 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Binary snapshots of analysed source units.
+ *
+ * A snapshot consists of a header describing the source and its dependencies, a string table,
+ * the tree of nodes, a table of the types used in annotations and the annotations of the nodes
+ * in traversal order. It ends with the keccak256 hash of all preceding data.
+ * Integers are encoded as LEB128 (signed integers after zigzag encoding), strings and other
+ * data are prefixed by their length.
+ */
+
+#include <libsolidity/ast/ASTSnapshot.h>
+
+#include <libsolidity/analysis/GlobalContext.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/Version.h>
+
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmData.h>
+#include <libyul/AsmParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Keccak256.h>
+
+#include <map>
+#include <set>
+
+using namespace std;
+using namespace langutil;
+
+namespace dev
+{
+namespace solidity
+{
+
+namespace
+{
+
+string const c_magic = "solast";
+unsigned const c_formatVersion = 1;
+
+/// Kinds of the nodes in the tree, zero is used for nullptr.
+struct NodeKind
+{
+	enum: uint8_t
+	{
+		Null,
+		SourceUnit, PragmaDirective, ImportDirective, ContractDefinition, InheritanceSpecifier,
+		UsingForDirective, StructDefinition, EnumDefinition, EnumValue, ParameterList,
+		FunctionDefinition, VariableDeclaration, ModifierDefinition, ModifierInvocation,
+		EventDefinition, ElementaryTypeName, UserDefinedTypeName, FunctionTypeName, Mapping,
+		ArrayTypeName, InlineAssembly, Block, PlaceholderStatement, IfStatement, WhileStatement,
+		ForStatement, Continue, Break, Return, Throw, EmitStatement, VariableDeclarationStatement,
+		ExpressionStatement, Conditional, Assignment, TupleExpression, UnaryOperation,
+		BinaryOperation, FunctionCall, NewExpression, MemberAccess, IndexAccess, Identifier,
+		ElementaryTypeNameExpression, Literal
+	};
+};
+
+/// Kinds of references to declarations.
+enum class ReferenceKind
+{
+	Null,
+	Node,
+	Global,
+	This,
+	Super
+};
+
+/// Collects the nodes of an AST in traversal order, which is the same for a source unit that
+/// was parsed and one that was loaded from a snapshot.
+class NodeCollector: private ASTConstVisitor
+{
+public:
+	static vector<ASTNode const*> collect(ASTNode const& _root)
+	{
+		NodeCollector collector;
+		_root.accept(collector);
+		return move(collector.m_nodes);
+	}
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		m_nodes.push_back(&_node);
+		return true;
+	}
+
+	vector<ASTNode const*> m_nodes;
+};
+
+void writeUnsigned(bytes& _data, uint64_t _value)
+{
+	do
+	{
+		uint8_t byte = _value & 0x7f;
+		_value >>= 7;
+		if (_value)
+			byte |= 0x80;
+		_data.push_back(byte);
+	}
+	while (_value);
+}
+
+void writeSigned(bytes& _data, int64_t _value)
+{
+	writeUnsigned(_data, (uint64_t(_value) << 1) ^ uint64_t(_value >> 63));
+}
+
+void writeBool(bytes& _data, bool _value)
+{
+	_data.push_back(_value ? 1 : 0);
+}
+
+void writeData(bytes& _data, bytesConstRef _value)
+{
+	writeUnsigned(_data, _value.size());
+	_data += _value.toBytes();
+}
+
+void writeData(bytes& _data, string const& _value)
+{
+	writeData(_data, bytesConstRef(_value));
+}
+
+ASTSnapshotError snapshotError(string const& _message)
+{
+	return ASTSnapshotError() << errinfo_comment(_message);
+}
+
+}
+
+ASTSnapshotWriter::ASTSnapshotWriter(
+	map<string, pair<SourceUnit const*, h256>> _sources,
+	GlobalContext const& _globalContext,
+	EVMVersion _evmVersion
+):
+	m_sources(move(_sources)),
+	m_evmVersion(_evmVersion)
+{
+	for (auto const& source: m_sources)
+		m_sourceNamesByID[source.second.first->location().sourceId] = source.first;
+	for (Declaration const* declaration: _globalContext.declarations())
+		m_globalDeclarations.emplace(declaration, m_globalDeclarations.size());
+}
+
+bytes ASTSnapshotWriter::write(string const& _sourceName)
+{
+	auto source = m_sources.find(_sourceName);
+	solAssert(source != m_sources.end(), "Unknown source: " + _sourceName);
+	SourceUnit const& sourceUnit = *source->second.first;
+
+	m_sourceName = _sourceName;
+	m_sourceIndices = {{_sourceName, 0}};
+	m_stringIndices.clear();
+	m_strings.clear();
+	m_typeIndices.clear();
+	m_typeEntries.clear();
+	m_typeCount = 0;
+	m_types.clear();
+	m_tree.clear();
+	m_annotations.clear();
+
+	map<string, h256> dependencies;
+	for (SourceUnit const* dependency: sourceUnit.referencedSourceUnits(true))
+	{
+		string const& path = dependency->annotation().path;
+		if (path == _sourceName)
+			continue;
+		auto dependencySource = m_sources.find(path);
+		if (dependencySource == m_sources.end())
+			BOOST_THROW_EXCEPTION(snapshotError("Unknown dependency: " + path));
+		dependencies[path] = dependencySource->second.second;
+	}
+	for (auto const& dependency: dependencies)
+		m_sourceIndices.emplace(dependency.first, m_sourceIndices.size());
+
+	writeNode(&sourceUnit);
+	for (ASTNode const* node: NodeCollector::collect(sourceUnit))
+		writeAnnotations(*node);
+
+	bytes snapshot = asBytes(c_magic);
+	writeUnsigned(snapshot, c_formatVersion);
+	writeData(snapshot, VersionString);
+	writeData(snapshot, m_evmVersion.name());
+	writeData(snapshot, _sourceName);
+	writeData(snapshot, source->second.second.ref());
+	writeUnsigned(snapshot, dependencies.size());
+	for (auto const& dependency: dependencies)
+	{
+		writeData(snapshot, dependency.first);
+		writeData(snapshot, dependency.second.ref());
+	}
+	vector<ImportDirective const*> imports = ASTNode::filteredNodes<ImportDirective>(sourceUnit.nodes());
+	writeUnsigned(snapshot, imports.size());
+	for (ImportDirective const* import: imports)
+		writeData(snapshot, import->annotation().absolutePath);
+
+	writeUnsigned(snapshot, m_strings.size());
+	for (string const* str: m_strings)
+		writeData(snapshot, *str);
+	snapshot += m_tree;
+	writeUnsigned(snapshot, m_typeCount);
+	snapshot += m_types;
+	snapshot += m_annotations;
+	snapshot += keccak256(snapshot).asBytes();
+	return snapshot;
+}
+
+bool ASTSnapshotWriter::visit(SourceUnit const& _node)
+{
+	writeHeader(_node, NodeKind::SourceUnit);
+	writeNodes(_node.nodes());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(PragmaDirective const& _node)
+{
+	writeHeader(_node, NodeKind::PragmaDirective);
+	writeUnsigned(m_tree, _node.tokens().size());
+	for (Token token: _node.tokens())
+		writeUnsigned(m_tree, unsigned(token));
+	writeUnsigned(m_tree, _node.literals().size());
+	for (ASTString const& literal: _node.literals())
+		writeString(m_tree, literal);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ImportDirective const& _node)
+{
+	writeHeader(_node, NodeKind::ImportDirective);
+	writeString(m_tree, _node.path());
+	writeString(m_tree, _node.name());
+	writeUnsigned(m_tree, _node.symbolAliases().size());
+	for (auto const& symbolAlias: _node.symbolAliases())
+	{
+		writeNode(symbolAlias.first.get());
+		writeOptionalString(m_tree, symbolAlias.second);
+	}
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ContractDefinition const& _node)
+{
+	writeHeader(_node, NodeKind::ContractDefinition);
+	writeString(m_tree, _node.name());
+	writeOptionalString(m_tree, _node.documentation());
+	writeNodes(_node.baseContracts());
+	writeNodes(_node.subNodes());
+	writeUnsigned(m_tree, unsigned(_node.contractKind()));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(InheritanceSpecifier const& _node)
+{
+	writeHeader(_node, NodeKind::InheritanceSpecifier);
+	writeNode(&_node.name());
+	writeOptionalNodes(_node.arguments());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(UsingForDirective const& _node)
+{
+	writeHeader(_node, NodeKind::UsingForDirective);
+	writeNode(&_node.libraryName());
+	writeNode(_node.typeName());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(StructDefinition const& _node)
+{
+	writeHeader(_node, NodeKind::StructDefinition);
+	writeString(m_tree, _node.name());
+	writeNodes(_node.members());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(EnumDefinition const& _node)
+{
+	writeHeader(_node, NodeKind::EnumDefinition);
+	writeString(m_tree, _node.name());
+	writeNodes(_node.members());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(EnumValue const& _node)
+{
+	writeHeader(_node, NodeKind::EnumValue);
+	writeString(m_tree, _node.name());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ParameterList const& _node)
+{
+	writeHeader(_node, NodeKind::ParameterList);
+	writeNodes(_node.parameters());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(FunctionDefinition const& _node)
+{
+	writeHeader(_node, NodeKind::FunctionDefinition);
+	writeString(m_tree, _node.name());
+	writeUnsigned(m_tree, unsigned(_node.noVisibilitySpecified() ? Declaration::Visibility::Default : _node.visibility()));
+	writeUnsigned(m_tree, unsigned(_node.stateMutability()));
+	writeBool(m_tree, _node.isConstructor());
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(&_node.parameterList());
+	writeNodes(_node.modifiers());
+	writeNode(_node.returnParameterList().get());
+	writeNode(_node.isImplemented() ? &_node.body() : nullptr);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(VariableDeclaration const& _node)
+{
+	writeHeader(_node, NodeKind::VariableDeclaration);
+	writeNode(_node.typeName());
+	writeString(m_tree, _node.name());
+	writeNode(_node.value().get());
+	writeUnsigned(m_tree, unsigned(_node.noVisibilitySpecified() ? Declaration::Visibility::Default : _node.visibility()));
+	writeBool(m_tree, _node.isStateVariable());
+	writeBool(m_tree, _node.isIndexed());
+	writeBool(m_tree, _node.isConstant());
+	writeUnsigned(m_tree, unsigned(_node.referenceLocation()));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ModifierDefinition const& _node)
+{
+	writeHeader(_node, NodeKind::ModifierDefinition);
+	writeString(m_tree, _node.name());
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(&_node.parameterList());
+	writeNode(&_node.body());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ModifierInvocation const& _node)
+{
+	writeHeader(_node, NodeKind::ModifierInvocation);
+	writeNode(_node.name().get());
+	writeOptionalNodes(_node.arguments());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(EventDefinition const& _node)
+{
+	writeHeader(_node, NodeKind::EventDefinition);
+	writeString(m_tree, _node.name());
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(&_node.parameterList());
+	writeBool(m_tree, _node.isAnonymous());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ElementaryTypeName const& _node)
+{
+	writeHeader(_node, NodeKind::ElementaryTypeName);
+	writeUnsigned(m_tree, unsigned(_node.typeName().token()));
+	writeUnsigned(m_tree, _node.typeName().firstNumber());
+	writeUnsigned(m_tree, _node.typeName().secondNumber());
+	writeBool(m_tree, !!_node.stateMutability());
+	if (_node.stateMutability())
+		writeUnsigned(m_tree, unsigned(*_node.stateMutability()));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(UserDefinedTypeName const& _node)
+{
+	writeHeader(_node, NodeKind::UserDefinedTypeName);
+	writeUnsigned(m_tree, _node.namePath().size());
+	for (ASTString const& name: _node.namePath())
+		writeString(m_tree, name);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(FunctionTypeName const& _node)
+{
+	writeHeader(_node, NodeKind::FunctionTypeName);
+	writeNode(_node.parameterTypeList().get());
+	writeNode(_node.returnParameterTypeList().get());
+	writeUnsigned(m_tree, unsigned(_node.visibility()));
+	writeUnsigned(m_tree, unsigned(_node.stateMutability()));
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Mapping const& _node)
+{
+	writeHeader(_node, NodeKind::Mapping);
+	writeNode(&_node.keyType());
+	writeNode(&_node.valueType());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ArrayTypeName const& _node)
+{
+	writeHeader(_node, NodeKind::ArrayTypeName);
+	writeNode(&_node.baseType());
+	writeNode(_node.length());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(InlineAssembly const& _node)
+{
+	// The operations are parsed from the source again when loading.
+	writeHeader(_node, NodeKind::InlineAssembly);
+	writeOptionalString(m_tree, _node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Block const& _node)
+{
+	writeHeader(_node, NodeKind::Block);
+	writeOptionalString(m_tree, _node.documentation());
+	writeNodes(_node.statements());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(PlaceholderStatement const& _node)
+{
+	writeHeader(_node, NodeKind::PlaceholderStatement);
+	writeOptionalString(m_tree, _node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(IfStatement const& _node)
+{
+	writeHeader(_node, NodeKind::IfStatement);
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(&_node.condition());
+	writeNode(&_node.trueStatement());
+	writeNode(_node.falseStatement());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(WhileStatement const& _node)
+{
+	writeHeader(_node, NodeKind::WhileStatement);
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(&_node.condition());
+	writeNode(&_node.body());
+	writeBool(m_tree, _node.isDoWhile());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ForStatement const& _node)
+{
+	writeHeader(_node, NodeKind::ForStatement);
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(_node.initializationExpression());
+	writeNode(_node.condition());
+	writeNode(_node.loopExpression());
+	writeNode(&_node.body());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Continue const& _node)
+{
+	writeHeader(_node, NodeKind::Continue);
+	writeOptionalString(m_tree, _node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Break const& _node)
+{
+	writeHeader(_node, NodeKind::Break);
+	writeOptionalString(m_tree, _node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Return const& _node)
+{
+	writeHeader(_node, NodeKind::Return);
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(_node.expression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Throw const& _node)
+{
+	writeHeader(_node, NodeKind::Throw);
+	writeOptionalString(m_tree, _node.documentation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(EmitStatement const& _node)
+{
+	writeHeader(_node, NodeKind::EmitStatement);
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(&_node.eventCall());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(VariableDeclarationStatement const& _node)
+{
+	writeHeader(_node, NodeKind::VariableDeclarationStatement);
+	writeOptionalString(m_tree, _node.documentation());
+	writeNodes(_node.declarations());
+	writeNode(_node.initialValue());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ExpressionStatement const& _node)
+{
+	writeHeader(_node, NodeKind::ExpressionStatement);
+	writeOptionalString(m_tree, _node.documentation());
+	writeNode(&_node.expression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Conditional const& _node)
+{
+	writeHeader(_node, NodeKind::Conditional);
+	writeNode(&_node.condition());
+	writeNode(&_node.trueExpression());
+	writeNode(&_node.falseExpression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Assignment const& _node)
+{
+	writeHeader(_node, NodeKind::Assignment);
+	writeNode(&_node.leftHandSide());
+	writeUnsigned(m_tree, unsigned(_node.assignmentOperator()));
+	writeNode(&_node.rightHandSide());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(TupleExpression const& _node)
+{
+	writeHeader(_node, NodeKind::TupleExpression);
+	writeNodes(_node.components());
+	writeBool(m_tree, _node.isInlineArray());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(UnaryOperation const& _node)
+{
+	writeHeader(_node, NodeKind::UnaryOperation);
+	writeUnsigned(m_tree, unsigned(_node.getOperator()));
+	writeNode(&_node.subExpression());
+	writeBool(m_tree, _node.isPrefixOperation());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(BinaryOperation const& _node)
+{
+	writeHeader(_node, NodeKind::BinaryOperation);
+	writeNode(&_node.leftExpression());
+	writeUnsigned(m_tree, unsigned(_node.getOperator()));
+	writeNode(&_node.rightExpression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(FunctionCall const& _node)
+{
+	writeHeader(_node, NodeKind::FunctionCall);
+	writeNode(&_node.expression());
+	writeNodes(_node.arguments());
+	writeUnsigned(m_tree, _node.names().size());
+	for (ASTPointer<ASTString> const& name: _node.names())
+		writeString(m_tree, *name);
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(NewExpression const& _node)
+{
+	writeHeader(_node, NodeKind::NewExpression);
+	writeNode(&_node.typeName());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(MemberAccess const& _node)
+{
+	writeHeader(_node, NodeKind::MemberAccess);
+	writeNode(&_node.expression());
+	writeString(m_tree, _node.memberName());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(IndexAccess const& _node)
+{
+	writeHeader(_node, NodeKind::IndexAccess);
+	writeNode(&_node.baseExpression());
+	writeNode(_node.indexExpression());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Identifier const& _node)
+{
+	writeHeader(_node, NodeKind::Identifier);
+	writeString(m_tree, _node.name());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(ElementaryTypeNameExpression const& _node)
+{
+	writeHeader(_node, NodeKind::ElementaryTypeNameExpression);
+	writeUnsigned(m_tree, unsigned(_node.typeName().token()));
+	writeUnsigned(m_tree, _node.typeName().firstNumber());
+	writeUnsigned(m_tree, _node.typeName().secondNumber());
+	return false;
+}
+
+bool ASTSnapshotWriter::visit(Literal const& _node)
+{
+	writeHeader(_node, NodeKind::Literal);
+	writeUnsigned(m_tree, unsigned(_node.token()));
+	writeString(m_tree, _node.value());
+	writeUnsigned(m_tree, unsigned(_node.subDenomination()));
+	return false;
+}
+
+void ASTSnapshotWriter::writeHeader(ASTNode const& _node, uint8_t _kind)
+{
+	m_tree.push_back(_kind);
+	SourceLocation const& location = _node.location();
+	writeSigned(m_tree, location.start);
+	writeSigned(m_tree, location.end);
+	writeBool(m_tree, location.hasSource());
+}
+
+void ASTSnapshotWriter::writeNode(ASTNode const* _node)
+{
+	if (_node)
+		_node->accept(*this);
+	else
+		m_tree.push_back(NodeKind::Null);
+}
+
+template <class T>
+void ASTSnapshotWriter::writeNodes(vector<T> const& _nodes)
+{
+	writeUnsigned(m_tree, _nodes.size());
+	for (T const& node: _nodes)
+		writeNode(node.get());
+}
+
+void ASTSnapshotWriter::writeOptionalNodes(vector<ASTPointer<Expression>> const* _nodes)
+{
+	writeBool(m_tree, !!_nodes);
+	if (_nodes)
+		writeNodes(*_nodes);
+}
+
+void ASTSnapshotWriter::writeAnnotations(ASTNode const& _node)
+{
+	if (auto sourceUnit = dynamic_cast<SourceUnit const*>(&_node))
+	{
+		auto const& features = sourceUnit->annotation().experimentalFeatures;
+		writeUnsigned(m_annotations, features.size());
+		for (ExperimentalFeature feature: features)
+			writeUnsigned(m_annotations, unsigned(feature));
+	}
+	else if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+	{
+		ContractDefinitionAnnotation const& annotation = contract->annotation();
+		writeDocTags(annotation);
+		writeUnsigned(m_annotations, annotation.unimplementedFunctions.size());
+		for (FunctionDefinition const* function: annotation.unimplementedFunctions)
+			writeReference(m_annotations, function);
+		writeUnsigned(m_annotations, annotation.linearizedBaseContracts.size());
+		for (ContractDefinition const* base: annotation.linearizedBaseContracts)
+			writeReference(m_annotations, base);
+		// These are ordered by the addresses of the nodes, the encoded entries are sorted instead
+		// so that snapshots are deterministic.
+		set<bytes> dependencies;
+		for (ContractDefinition const* dependency: annotation.contractDependencies)
+		{
+			bytes entry;
+			writeReference(entry, dependency);
+			dependencies.insert(move(entry));
+		}
+		writeUnsigned(m_annotations, dependencies.size());
+		for (bytes const& entry: dependencies)
+			m_annotations += entry;
+		set<bytes> baseConstructorArguments;
+		for (auto const& arguments: annotation.baseConstructorArguments)
+		{
+			bytes entry;
+			writeReference(entry, arguments.first);
+			writeReference(entry, arguments.second);
+			baseConstructorArguments.insert(move(entry));
+		}
+		writeUnsigned(m_annotations, baseConstructorArguments.size());
+		for (bytes const& entry: baseConstructorArguments)
+			m_annotations += entry;
+	}
+	else if (auto function = dynamic_cast<FunctionDefinition const*>(&_node))
+	{
+		writeDocTags(function->annotation());
+		writeReference(m_annotations, function->annotation().superFunction);
+	}
+	else if (auto event = dynamic_cast<EventDefinition const*>(&_node))
+		writeDocTags(event->annotation());
+	else if (auto modifier = dynamic_cast<ModifierDefinition const*>(&_node))
+		writeDocTags(modifier->annotation());
+	else if (auto variable = dynamic_cast<VariableDeclaration const*>(&_node))
+		writeType(m_annotations, variable->annotation().type);
+	else if (auto inlineAssembly = dynamic_cast<InlineAssembly const*>(&_node))
+	{
+		InlineAssemblyAnnotation const& annotation = inlineAssembly->annotation();
+		writeDocTags(annotation);
+		// The identifiers are recreated when loading, so they are referred to by their location.
+		map<int, InlineAssemblyAnnotation::ExternalIdentifierInfo const*> references;
+		for (auto const& reference: annotation.externalReferences)
+			references[reference.first->location.start] = &reference.second;
+		writeUnsigned(m_annotations, references.size());
+		for (auto const& reference: references)
+		{
+			writeSigned(m_annotations, reference.first);
+			writeReference(m_annotations, reference.second->declaration);
+			writeBool(m_annotations, reference.second->isSlot);
+			writeBool(m_annotations, reference.second->isOffset);
+			writeUnsigned(m_annotations, reference.second->valueSize + 1);
+		}
+	}
+	else if (auto returnStatement = dynamic_cast<Return const*>(&_node))
+	{
+		writeDocTags(returnStatement->annotation());
+		writeReference(m_annotations, returnStatement->annotation().functionReturnParameters);
+	}
+	else if (auto statement = dynamic_cast<Statement const*>(&_node))
+		writeDocTags(statement->annotation());
+	else if (auto typeName = dynamic_cast<UserDefinedTypeName const*>(&_node))
+	{
+		UserDefinedTypeNameAnnotation const& annotation = typeName->annotation();
+		writeType(m_annotations, annotation.type);
+		writeReference(m_annotations, annotation.referencedDeclaration);
+		writeReference(m_annotations, annotation.contractScope);
+	}
+	else if (auto typeName = dynamic_cast<TypeName const*>(&_node))
+		writeType(m_annotations, typeName->annotation().type);
+	else if (auto expression = dynamic_cast<Expression const*>(&_node))
+	{
+		ExpressionAnnotation const& annotation = expression->annotation();
+		writeType(m_annotations, annotation.type);
+		writeBool(m_annotations, annotation.isConstant);
+		writeBool(m_annotations, annotation.isPure);
+		writeBool(m_annotations, annotation.isLValue);
+		writeBool(m_annotations, annotation.lValueRequested);
+		writeBool(m_annotations, !!annotation.arguments);
+		if (annotation.arguments)
+		{
+			writeUnsigned(m_annotations, annotation.arguments->types.size());
+			for (Type const* type: annotation.arguments->types)
+				writeType(m_annotations, type);
+			writeUnsigned(m_annotations, annotation.arguments->names.size());
+			for (ASTPointer<ASTString> const& name: annotation.arguments->names)
+				writeString(m_annotations, *name);
+		}
+		if (auto identifier = dynamic_cast<Identifier const*>(&_node))
+		{
+			writeReference(m_annotations, identifier->annotation().referencedDeclaration);
+			writeUnsigned(m_annotations, identifier->annotation().overloadedDeclarations.size());
+			for (Declaration const* declaration: identifier->annotation().overloadedDeclarations)
+				writeReference(m_annotations, declaration);
+		}
+		else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+			writeReference(m_annotations, memberAccess->annotation().referencedDeclaration);
+		else if (auto binaryOperation = dynamic_cast<BinaryOperation const*>(&_node))
+			writeType(m_annotations, binaryOperation->annotation().commonType);
+		else if (auto functionCall = dynamic_cast<FunctionCall const*>(&_node))
+			writeUnsigned(m_annotations, unsigned(functionCall->annotation().kind));
+	}
+}
+
+void ASTSnapshotWriter::writeDocTags(DocumentedAnnotation const& _annotation)
+{
+	writeUnsigned(m_annotations, _annotation.docTags.size());
+	for (auto const& docTag: _annotation.docTags)
+	{
+		writeString(m_annotations, docTag.first);
+		writeString(m_annotations, docTag.second.content);
+		writeString(m_annotations, docTag.second.paramName);
+	}
+}
+
+void ASTSnapshotWriter::writeString(bytes& _data, string const& _string)
+{
+	auto inserted = m_stringIndices.emplace(_string, m_strings.size());
+	if (inserted.second)
+		m_strings.push_back(&inserted.first->first);
+	writeUnsigned(_data, inserted.first->second);
+}
+
+void ASTSnapshotWriter::writeOptionalString(bytes& _data, ASTPointer<ASTString> const& _string)
+{
+	writeBool(_data, !!_string);
+	if (_string)
+		writeString(_data, *_string);
+}
+
+void ASTSnapshotWriter::writeReference(bytes& _data, ASTNode const* _node)
+{
+	if (!_node)
+	{
+		writeUnsigned(_data, unsigned(ReferenceKind::Null));
+		return;
+	}
+
+	auto globalDeclaration = m_globalDeclarations.find(dynamic_cast<Declaration const*>(_node));
+	if (globalDeclaration != m_globalDeclarations.end())
+	{
+		writeUnsigned(_data, unsigned(ReferenceKind::Global));
+		writeUnsigned(_data, globalDeclaration->second);
+		return;
+	}
+	if (auto magicVariable = dynamic_cast<MagicVariableDeclaration const*>(_node))
+	{
+		// "this" and "super" are created per contract.
+		auto contractType = dynamic_cast<ContractType const*>(magicVariable->type());
+		if (!contractType)
+			BOOST_THROW_EXCEPTION(snapshotError("Unknown global declaration: " + magicVariable->name()));
+		writeUnsigned(_data, unsigned(contractType->isSuper() ? ReferenceKind::Super : ReferenceKind::This));
+		writeReference(_data, &contractType->contractDefinition());
+		return;
+	}
+
+	auto sourceName = m_sourceNamesByID.find(_node->location().sourceId);
+	if (sourceName == m_sourceNamesByID.end())
+		BOOST_THROW_EXCEPTION(snapshotError("Reference to a node of an unknown source."));
+	auto sourceIndex = m_sourceIndices.find(sourceName->second);
+	if (sourceIndex == m_sourceIndices.end())
+		BOOST_THROW_EXCEPTION(snapshotError("Reference to a source that is not imported: " + sourceName->second));
+	auto const& indices = nodeIndices(sourceName->second);
+	auto nodeIndex = indices.find(_node);
+	if (nodeIndex == indices.end())
+		BOOST_THROW_EXCEPTION(snapshotError("Reference to a node outside of the AST."));
+	writeUnsigned(_data, unsigned(ReferenceKind::Node));
+	writeUnsigned(_data, sourceIndex->second);
+	writeUnsigned(_data, nodeIndex->second);
+}
+
+void ASTSnapshotWriter::writeType(bytes& _data, Type const* _type)
+{
+	if (!_type)
+	{
+		writeUnsigned(_data, 0);
+		return;
+	}
+
+	auto typeIndex = m_typeIndices.find(_type);
+	if (typeIndex == m_typeIndices.end())
+	{
+		bytes entry = typeEntry(*_type);
+		auto existingEntry = m_typeEntries.find(entry);
+		if (existingEntry == m_typeEntries.end())
+		{
+			m_types += entry;
+			existingEntry = m_typeEntries.emplace(move(entry), ++m_typeCount).first;
+		}
+		typeIndex = m_typeIndices.emplace(_type, existingEntry->second).first;
+	}
+	writeUnsigned(_data, typeIndex->second);
+}
+
+bytes ASTSnapshotWriter::typeEntry(Type const& _type)
+{
+	bytes entry;
+	writeUnsigned(entry, unsigned(_type.category()));
+	switch (_type.category())
+	{
+	case Type::Category::Address:
+		writeUnsigned(entry, unsigned(dynamic_cast<AddressType const&>(_type).stateMutability()));
+		break;
+	case Type::Category::Integer:
+	{
+		auto const& integerType = dynamic_cast<IntegerType const&>(_type);
+		writeUnsigned(entry, integerType.numBits());
+		writeBool(entry, integerType.isSigned());
+		break;
+	}
+	case Type::Category::RationalNumber:
+	{
+		auto const& rationalType = dynamic_cast<RationalNumberType const&>(_type);
+		writeData(entry, rationalType.value().numerator().str());
+		writeData(entry, rationalType.value().denominator().str());
+		writeType(entry, rationalType.compatibleBytesType());
+		break;
+	}
+	case Type::Category::StringLiteral:
+		writeData(entry, dynamic_cast<StringLiteralType const&>(_type).value());
+		break;
+	case Type::Category::Bool:
+		break;
+	case Type::Category::FixedPoint:
+	{
+		auto const& fixedPointType = dynamic_cast<FixedPointType const&>(_type);
+		writeUnsigned(entry, fixedPointType.numBits());
+		writeUnsigned(entry, fixedPointType.fractionalDigits());
+		writeBool(entry, fixedPointType.isSigned());
+		break;
+	}
+	case Type::Category::Array:
+	{
+		auto const& arrayType = dynamic_cast<ArrayType const&>(_type);
+		writeUnsigned(entry, unsigned(arrayType.location()));
+		writeBool(entry, arrayType.isPointer());
+		writeUnsigned(entry, arrayType.isString() ? 2 : arrayType.isByteArray() ? 1 : 0);
+		if (!arrayType.isByteArray())
+		{
+			writeType(entry, arrayType.baseType());
+			writeBool(entry, arrayType.isDynamicallySized());
+			if (!arrayType.isDynamicallySized())
+			{
+				bytes length = toCompactBigEndian(arrayType.length());
+				writeData(entry, bytesConstRef(&length));
+			}
+		}
+		break;
+	}
+	case Type::Category::FixedBytes:
+		writeUnsigned(entry, dynamic_cast<FixedBytesType const&>(_type).numBytes());
+		break;
+	case Type::Category::Contract:
+	{
+		auto const& contractType = dynamic_cast<ContractType const&>(_type);
+		writeReference(entry, &contractType.contractDefinition());
+		writeBool(entry, contractType.isSuper());
+		break;
+	}
+	case Type::Category::Struct:
+	{
+		auto const& structType = dynamic_cast<StructType const&>(_type);
+		writeReference(entry, &structType.structDefinition());
+		writeUnsigned(entry, unsigned(structType.location()));
+		writeBool(entry, structType.isPointer());
+		break;
+	}
+	case Type::Category::Function:
+	{
+		auto const& functionType = dynamic_cast<FunctionType const&>(_type);
+		writeUnsigned(entry, functionType.parameterTypesIncludingSelf().size());
+		for (Type const* parameterType: functionType.parameterTypesIncludingSelf())
+			writeType(entry, parameterType);
+		writeUnsigned(entry, functionType.returnParameterTypes().size());
+		for (Type const* returnParameterType: functionType.returnParameterTypes())
+			writeType(entry, returnParameterType);
+		writeUnsigned(entry, functionType.parameterNamesIncludingSelf().size());
+		for (string const& name: functionType.parameterNamesIncludingSelf())
+			writeString(entry, name);
+		writeUnsigned(entry, functionType.returnParameterNames().size());
+		for (string const& name: functionType.returnParameterNames())
+			writeString(entry, name);
+		writeUnsigned(entry, unsigned(functionType.kind()));
+		writeBool(entry, functionType.takesArbitraryParameters());
+		writeUnsigned(entry, unsigned(functionType.stateMutability()));
+		writeReference(entry, functionType.hasDeclaration() ? &functionType.declaration() : nullptr);
+		writeBool(entry, functionType.gasSet());
+		writeBool(entry, functionType.valueSet());
+		writeBool(entry, functionType.bound());
+		break;
+	}
+	case Type::Category::Enum:
+		writeReference(entry, &dynamic_cast<EnumType const&>(_type).enumDefinition());
+		break;
+	case Type::Category::Tuple:
+	{
+		auto const& components = dynamic_cast<TupleType const&>(_type).components();
+		writeUnsigned(entry, components.size());
+		for (Type const* component: components)
+			writeType(entry, component);
+		break;
+	}
+	case Type::Category::Mapping:
+	{
+		auto const& mappingType = dynamic_cast<MappingType const&>(_type);
+		writeType(entry, mappingType.keyType());
+		writeType(entry, mappingType.valueType());
+		break;
+	}
+	case Type::Category::TypeType:
+		writeType(entry, dynamic_cast<TypeType const&>(_type).actualType());
+		break;
+	case Type::Category::Modifier:
+		writeReference(entry, &dynamic_cast<ModifierType const&>(_type).modifierDefinition());
+		break;
+	case Type::Category::Magic:
+	{
+		auto const& magicType = dynamic_cast<MagicType const&>(_type);
+		writeUnsigned(entry, unsigned(magicType.kind()));
+		if (magicType.kind() == MagicType::Kind::MetaType)
+			writeType(entry, magicType.typeArgument());
+		break;
+	}
+	case Type::Category::Module:
+		writeReference(entry, &dynamic_cast<ModuleType const&>(_type).sourceUnit());
+		break;
+	case Type::Category::InaccessibleDynamic:
+		break;
+	}
+	return entry;
+}
+
+map<ASTNode const*, size_t> const& ASTSnapshotWriter::nodeIndices(string const& _sourceName)
+{
+	auto indices = m_nodeIndices.find(_sourceName);
+	if (indices == m_nodeIndices.end())
+	{
+		indices = m_nodeIndices.emplace(_sourceName, map<ASTNode const*, size_t>{}).first;
+		for (ASTNode const* node: NodeCollector::collect(*m_sources.at(_sourceName).first))
+			indices->second.emplace(node, indices->second.size());
+	}
+	return indices->second;
+}
+
+ASTSnapshotReader::ASTSnapshotReader(bytes _snapshot):
+	m_snapshot(move(_snapshot))
+{
+	if (m_snapshot.size() < c_magic.size() + h256::size)
+		BOOST_THROW_EXCEPTION(snapshotError("Snapshot too short."));
+	size_t contentSize = m_snapshot.size() - h256::size;
+	h256 checksum(bytesConstRef(m_snapshot.data() + contentSize, h256::size));
+	m_snapshot.resize(contentSize);
+	if (keccak256(m_snapshot) != checksum)
+		BOOST_THROW_EXCEPTION(snapshotError("Invalid checksum."));
+	if (!equal(c_magic.begin(), c_magic.end(), m_snapshot.begin()))
+		BOOST_THROW_EXCEPTION(snapshotError("Not an AST snapshot."));
+	m_position = c_magic.size();
+	if (readUnsigned() != c_formatVersion)
+		BOOST_THROW_EXCEPTION(snapshotError("Unsupported snapshot format version."));
+
+	m_compilerVersion = readData();
+	boost::optional<EVMVersion> evmVersion = EVMVersion::fromString(readData());
+	if (!evmVersion)
+		BOOST_THROW_EXCEPTION(snapshotError("Invalid EVM version."));
+	m_evmVersion = *evmVersion;
+	m_sourceName = readData();
+	string hash = readData();
+	if (hash.size() != h256::size)
+		BOOST_THROW_EXCEPTION(snapshotError("Invalid source hash."));
+	m_sourceHash = h256(asBytes(hash));
+
+	m_sourceNames.push_back(m_sourceName);
+	for (uint64_t dependencies = readUnsigned(); dependencies > 0; --dependencies)
+	{
+		string name = readData();
+		string dependencyHash = readData();
+		if (dependencyHash.size() != h256::size)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid dependency hash."));
+		m_dependencies[name] = h256(asBytes(dependencyHash));
+		m_sourceNames.push_back(name);
+	}
+	for (uint64_t imports = readUnsigned(); imports > 0; --imports)
+		m_importPaths.push_back(readData());
+}
+
+ASTPointer<SourceUnit> ASTSnapshotReader::readAST(shared_ptr<ASTArena> _arena, shared_ptr<CharStream> _source)
+{
+	solAssert(!m_ast, "AST already read.");
+	m_arena = move(_arena);
+	m_source = move(_source);
+
+	for (uint64_t strings = readUnsigned(); strings > 0; --strings)
+	{
+		string str = readData();
+		m_strings.push_back(m_arena ? m_arena->intern(str) : make_shared<ASTString>(move(str)));
+	}
+	m_ast = readNode<SourceUnit>();
+	if (!m_ast)
+		BOOST_THROW_EXCEPTION(snapshotError("Missing source unit."));
+	return m_ast;
+}
+
+void ASTSnapshotReader::readAnnotations(
+	map<string, SourceUnit const*> const& _sourceUnits,
+	GlobalContext& _globalContext
+)
+{
+	solAssert(m_ast, "AST has to be read first.");
+	m_globalContext = &_globalContext;
+	m_globalDeclarations = _globalContext.declarations();
+	for (size_t i = 0; i < m_sourceNames.size(); ++i)
+	{
+		SourceUnit const* sourceUnit = m_ast.get();
+		if (i > 0)
+		{
+			auto dependency = _sourceUnits.find(m_sourceNames[i]);
+			if (dependency == _sourceUnits.end() || !dependency->second)
+				BOOST_THROW_EXCEPTION(snapshotError("Missing dependency: " + m_sourceNames[i]));
+			sourceUnit = dependency->second;
+		}
+		m_nodes.push_back(NodeCollector::collect(*sourceUnit));
+	}
+
+	for (uint64_t types = readUnsigned(); types > 0; --types)
+		m_types.push_back(readTypeEntry());
+	for (ASTNode const* node: m_nodes.front())
+		readAnnotations(*node);
+	if (m_position != m_snapshot.size())
+		BOOST_THROW_EXCEPTION(snapshotError("Unexpected data at the end of the snapshot."));
+}
+
+uint64_t ASTSnapshotReader::readUnsigned()
+{
+	uint64_t value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7)
+	{
+		if (m_position >= m_snapshot.size())
+			BOOST_THROW_EXCEPTION(snapshotError("Unexpected end of snapshot."));
+		uint8_t byte = m_snapshot[m_position++];
+		value |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return value;
+	}
+	BOOST_THROW_EXCEPTION(snapshotError("Integer too large."));
+}
+
+int64_t ASTSnapshotReader::readSigned()
+{
+	uint64_t value = readUnsigned();
+	return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+bool ASTSnapshotReader::readBool()
+{
+	uint64_t value = readUnsigned();
+	if (value > 1)
+		BOOST_THROW_EXCEPTION(snapshotError("Invalid boolean."));
+	return value == 1;
+}
+
+string ASTSnapshotReader::readData()
+{
+	uint64_t size = readUnsigned();
+	if (size > m_snapshot.size() - m_position)
+		BOOST_THROW_EXCEPTION(snapshotError("Unexpected end of snapshot."));
+	string data(m_snapshot.begin() + m_position, m_snapshot.begin() + m_position + size);
+	m_position += size;
+	return data;
+}
+
+template <class E>
+E ASTSnapshotReader::readEnum(E _last)
+{
+	uint64_t value = readUnsigned();
+	if (value > uint64_t(_last))
+		BOOST_THROW_EXCEPTION(snapshotError("Invalid enum value."));
+	return E(value);
+}
+
+ASTPointer<ASTString> const& ASTSnapshotReader::readString()
+{
+	uint64_t index = readUnsigned();
+	if (index >= m_strings.size())
+		BOOST_THROW_EXCEPTION(snapshotError("Invalid string index."));
+	return m_strings[index];
+}
+
+ASTPointer<ASTString> ASTSnapshotReader::readOptionalString()
+{
+	if (!readBool())
+		return nullptr;
+	return readString();
+}
+
+SourceLocation ASTSnapshotReader::readLocation()
+{
+	SourceLocation location;
+	location.start = int(readSigned());
+	location.end = int(readSigned());
+	if (readBool())
+		location.sourceId = m_source->sourceId();
+	return location;
+}
+
+ASTPointer<ASTNode> ASTSnapshotReader::readNode()
+{
+	if (m_position >= m_snapshot.size())
+		BOOST_THROW_EXCEPTION(snapshotError("Unexpected end of snapshot."));
+	uint8_t kind = m_snapshot[m_position++];
+	if (kind == NodeKind::Null)
+		return nullptr;
+
+	// Child nodes are read before the nodes are created, because the order in which
+	// function arguments are evaluated is unspecified.
+	SourceLocation location = readLocation();
+	switch (kind)
+	{
+	case NodeKind::SourceUnit:
+	{
+		auto nodes = readNodes<ASTNode>();
+		return createNode<SourceUnit>(location, nodes);
+	}
+	case NodeKind::PragmaDirective:
+	{
+		vector<Token> tokens;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			tokens.push_back(readEnum(Token::NUM_TOKENS));
+		vector<ASTString> literals;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			literals.push_back(*readString());
+		return createNode<PragmaDirective>(location, tokens, literals);
+	}
+	case NodeKind::ImportDirective:
+	{
+		auto path = readString();
+		auto unitAlias = readString();
+		vector<pair<ASTPointer<Identifier>, ASTPointer<ASTString>>> symbolAliases;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+		{
+			auto symbol = readNode<Identifier>();
+			auto alias = readOptionalString();
+			symbolAliases.emplace_back(symbol, alias);
+		}
+		return createNode<ImportDirective>(location, path, unitAlias, move(symbolAliases));
+	}
+	case NodeKind::ContractDefinition:
+	{
+		auto name = readString();
+		auto documentation = readOptionalString();
+		auto baseContracts = readNodes<InheritanceSpecifier>();
+		auto subNodes = readNodes<ASTNode>();
+		auto contractKind = readEnum(ContractDefinition::ContractKind::Library);
+		return createNode<ContractDefinition>(location, name, documentation, baseContracts, subNodes, contractKind);
+	}
+	case NodeKind::InheritanceSpecifier:
+	{
+		auto baseName = readNode<UserDefinedTypeName>();
+		auto arguments = readOptionalNodes();
+		return createNode<InheritanceSpecifier>(location, baseName, move(arguments));
+	}
+	case NodeKind::UsingForDirective:
+	{
+		auto libraryName = readNode<UserDefinedTypeName>();
+		auto typeName = readNode<TypeName>();
+		return createNode<UsingForDirective>(location, libraryName, typeName);
+	}
+	case NodeKind::StructDefinition:
+	{
+		auto name = readString();
+		auto members = readNodes<VariableDeclaration>();
+		return createNode<StructDefinition>(location, name, members);
+	}
+	case NodeKind::EnumDefinition:
+	{
+		auto name = readString();
+		auto members = readNodes<EnumValue>();
+		return createNode<EnumDefinition>(location, name, members);
+	}
+	case NodeKind::EnumValue:
+		return createNode<EnumValue>(location, readString());
+	case NodeKind::ParameterList:
+		return createNode<ParameterList>(location, readNodes<VariableDeclaration>());
+	case NodeKind::FunctionDefinition:
+	{
+		auto name = readString();
+		auto visibility = readEnum(Declaration::Visibility::External);
+		auto stateMutability = readEnum(StateMutability::Payable);
+		bool isConstructor = readBool();
+		auto documentation = readOptionalString();
+		auto parameters = readNode<ParameterList>();
+		auto modifiers = readNodes<ModifierInvocation>();
+		auto returnParameters = readNode<ParameterList>();
+		auto body = readNode<Block>();
+		return createNode<FunctionDefinition>(
+			location,
+			name,
+			visibility,
+			stateMutability,
+			isConstructor,
+			documentation,
+			parameters,
+			modifiers,
+			returnParameters,
+			body
+		);
+	}
+	case NodeKind::VariableDeclaration:
+	{
+		auto typeName = readNode<TypeName>();
+		auto name = readString();
+		auto value = readNode<Expression>();
+		auto visibility = readEnum(Declaration::Visibility::External);
+		bool isStateVariable = readBool();
+		bool isIndexed = readBool();
+		bool isConstant = readBool();
+		auto referenceLocation = readEnum(VariableDeclaration::Location::CallData);
+		return createNode<VariableDeclaration>(
+			location,
+			typeName,
+			name,
+			value,
+			visibility,
+			isStateVariable,
+			isIndexed,
+			isConstant,
+			referenceLocation
+		);
+	}
+	case NodeKind::ModifierDefinition:
+	{
+		auto name = readString();
+		auto documentation = readOptionalString();
+		auto parameters = readNode<ParameterList>();
+		auto body = readNode<Block>();
+		return createNode<ModifierDefinition>(location, name, documentation, parameters, body);
+	}
+	case NodeKind::ModifierInvocation:
+	{
+		auto name = readNode<Identifier>();
+		auto arguments = readOptionalNodes();
+		return createNode<ModifierInvocation>(location, name, move(arguments));
+	}
+	case NodeKind::EventDefinition:
+	{
+		auto name = readString();
+		auto documentation = readOptionalString();
+		auto parameters = readNode<ParameterList>();
+		bool anonymous = readBool();
+		return createNode<EventDefinition>(location, name, documentation, parameters, anonymous);
+	}
+	case NodeKind::ElementaryTypeName:
+	{
+		Token token = readEnum(Token::NUM_TOKENS);
+		unsigned firstNumber = unsigned(readUnsigned());
+		unsigned secondNumber = unsigned(readUnsigned());
+		boost::optional<StateMutability> stateMutability;
+		if (readBool())
+			stateMutability = readEnum(StateMutability::Payable);
+		return createNode<ElementaryTypeName>(
+			location,
+			ElementaryTypeNameToken(token, firstNumber, secondNumber),
+			stateMutability
+		);
+	}
+	case NodeKind::UserDefinedTypeName:
+	{
+		vector<ASTString> namePath;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			namePath.push_back(*readString());
+		return createNode<UserDefinedTypeName>(location, namePath);
+	}
+	case NodeKind::FunctionTypeName:
+	{
+		auto parameterTypes = readNode<ParameterList>();
+		auto returnTypes = readNode<ParameterList>();
+		auto visibility = readEnum(Declaration::Visibility::External);
+		auto stateMutability = readEnum(StateMutability::Payable);
+		return createNode<FunctionTypeName>(location, parameterTypes, returnTypes, visibility, stateMutability);
+	}
+	case NodeKind::Mapping:
+	{
+		auto keyType = readNode<ElementaryTypeName>();
+		auto valueType = readNode<TypeName>();
+		return createNode<Mapping>(location, keyType, valueType);
+	}
+	case NodeKind::ArrayTypeName:
+	{
+		auto baseType = readNode<TypeName>();
+		auto length = readNode<Expression>();
+		return createNode<ArrayTypeName>(location, baseType, length);
+	}
+	case NodeKind::InlineAssembly:
+	{
+		auto documentation = readOptionalString();
+		return createNode<InlineAssembly>(
+			location,
+			documentation,
+			yul::EVMDialect::looseAssemblyForEVM(m_evmVersion),
+			parseInlineAssembly(location)
+		);
+	}
+	case NodeKind::Block:
+	{
+		auto documentation = readOptionalString();
+		auto statements = readNodes<Statement>();
+		return createNode<Block>(location, documentation, statements);
+	}
+	case NodeKind::PlaceholderStatement:
+		return createNode<PlaceholderStatement>(location, readOptionalString());
+	case NodeKind::IfStatement:
+	{
+		auto documentation = readOptionalString();
+		auto condition = readNode<Expression>();
+		auto trueBody = readNode<Statement>();
+		auto falseBody = readNode<Statement>();
+		return createNode<IfStatement>(location, documentation, condition, trueBody, falseBody);
+	}
+	case NodeKind::WhileStatement:
+	{
+		auto documentation = readOptionalString();
+		auto condition = readNode<Expression>();
+		auto body = readNode<Statement>();
+		bool isDoWhile = readBool();
+		return createNode<WhileStatement>(location, documentation, condition, body, isDoWhile);
+	}
+	case NodeKind::ForStatement:
+	{
+		auto documentation = readOptionalString();
+		auto initExpression = readNode<Statement>();
+		auto conditionExpression = readNode<Expression>();
+		auto loopExpression = readNode<ExpressionStatement>();
+		auto body = readNode<Statement>();
+		return createNode<ForStatement>(location, documentation, initExpression, conditionExpression, loopExpression, body);
+	}
+	case NodeKind::Continue:
+		return createNode<Continue>(location, readOptionalString());
+	case NodeKind::Break:
+		return createNode<Break>(location, readOptionalString());
+	case NodeKind::Return:
+	{
+		auto documentation = readOptionalString();
+		auto expression = readNode<Expression>();
+		return createNode<Return>(location, documentation, expression);
+	}
+	case NodeKind::Throw:
+		return createNode<Throw>(location, readOptionalString());
+	case NodeKind::EmitStatement:
+	{
+		auto documentation = readOptionalString();
+		auto eventCall = readNode<FunctionCall>();
+		return createNode<EmitStatement>(location, documentation, eventCall);
+	}
+	case NodeKind::VariableDeclarationStatement:
+	{
+		auto documentation = readOptionalString();
+		auto variables = readNodes<VariableDeclaration>();
+		auto initialValue = readNode<Expression>();
+		return createNode<VariableDeclarationStatement>(location, documentation, variables, initialValue);
+	}
+	case NodeKind::ExpressionStatement:
+	{
+		auto documentation = readOptionalString();
+		auto expression = readNode<Expression>();
+		return createNode<ExpressionStatement>(location, documentation, expression);
+	}
+	case NodeKind::Conditional:
+	{
+		auto condition = readNode<Expression>();
+		auto trueExpression = readNode<Expression>();
+		auto falseExpression = readNode<Expression>();
+		return createNode<Conditional>(location, condition, trueExpression, falseExpression);
+	}
+	case NodeKind::Assignment:
+	{
+		auto leftHandSide = readNode<Expression>();
+		Token assignmentOperator = readEnum(Token::NUM_TOKENS);
+		auto rightHandSide = readNode<Expression>();
+		return createNode<Assignment>(location, leftHandSide, assignmentOperator, rightHandSide);
+	}
+	case NodeKind::TupleExpression:
+	{
+		auto components = readNodes<Expression>();
+		bool isArray = readBool();
+		return createNode<TupleExpression>(location, components, isArray);
+	}
+	case NodeKind::UnaryOperation:
+	{
+		Token unaryOperator = readEnum(Token::NUM_TOKENS);
+		auto subExpression = readNode<Expression>();
+		bool isPrefix = readBool();
+		return createNode<UnaryOperation>(location, unaryOperator, subExpression, isPrefix);
+	}
+	case NodeKind::BinaryOperation:
+	{
+		auto left = readNode<Expression>();
+		Token binaryOperator = readEnum(Token::NUM_TOKENS);
+		auto right = readNode<Expression>();
+		return createNode<BinaryOperation>(location, left, binaryOperator, right);
+	}
+	case NodeKind::FunctionCall:
+	{
+		auto expression = readNode<Expression>();
+		auto arguments = readNodes<Expression>();
+		vector<ASTPointer<ASTString>> names;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			names.push_back(readString());
+		return createNode<FunctionCall>(location, expression, arguments, names);
+	}
+	case NodeKind::NewExpression:
+		return createNode<NewExpression>(location, readNode<TypeName>());
+	case NodeKind::MemberAccess:
+	{
+		auto expression = readNode<Expression>();
+		auto memberName = readString();
+		return createNode<MemberAccess>(location, expression, memberName);
+	}
+	case NodeKind::IndexAccess:
+	{
+		auto base = readNode<Expression>();
+		auto index = readNode<Expression>();
+		return createNode<IndexAccess>(location, base, index);
+	}
+	case NodeKind::Identifier:
+		return createNode<Identifier>(location, readString());
+	case NodeKind::ElementaryTypeNameExpression:
+	{
+		Token token = readEnum(Token::NUM_TOKENS);
+		unsigned firstNumber = unsigned(readUnsigned());
+		unsigned secondNumber = unsigned(readUnsigned());
+		return createNode<ElementaryTypeNameExpression>(
+			location,
+			ElementaryTypeNameToken(token, firstNumber, secondNumber)
+		);
+	}
+	case NodeKind::Literal:
+	{
+		Token token = readEnum(Token::NUM_TOKENS);
+		auto value = readString();
+		auto subDenomination = Literal::SubDenomination(readEnum(Token::NUM_TOKENS));
+		return createNode<Literal>(location, token, value, subDenomination);
+	}
+	default:
+		BOOST_THROW_EXCEPTION(snapshotError("Invalid node kind."));
+	}
+}
+
+template <class T>
+ASTPointer<T> ASTSnapshotReader::readNode()
+{
+	ASTPointer<ASTNode> node = readNode();
+	if (!node)
+		return nullptr;
+	ASTPointer<T> typedNode = dynamic_pointer_cast<T>(node);
+	if (!typedNode)
+		BOOST_THROW_EXCEPTION(snapshotError("Unexpected node kind."));
+	return typedNode;
+}
+
+template <class T>
+vector<ASTPointer<T>> ASTSnapshotReader::readNodes()
+{
+	vector<ASTPointer<T>> nodes;
+	for (uint64_t count = readUnsigned(); count > 0; --count)
+		nodes.push_back(readNode<T>());
+	return nodes;
+}
+
+unique_ptr<vector<ASTPointer<Expression>>> ASTSnapshotReader::readOptionalNodes()
+{
+	if (!readBool())
+		return nullptr;
+	return make_unique<vector<ASTPointer<Expression>>>(readNodes<Expression>());
+}
+
+template <class T, class... Args>
+ASTPointer<T> ASTSnapshotReader::createNode(Args&&... _args)
+{
+	if (m_arena)
+		return m_arena->createNode<T>(std::forward<Args>(_args)...);
+	return make_shared<T>(std::forward<Args>(_args)...);
+}
+
+shared_ptr<yul::Block> ASTSnapshotReader::parseInlineAssembly(SourceLocation const& _location)
+{
+	if (!m_scanner)
+		m_scanner = make_shared<Scanner>(m_source);
+	m_scanner->setPosition(size_t(_location.start));
+	if (m_scanner->currentToken() != Token::Assembly)
+		BOOST_THROW_EXCEPTION(snapshotError("Inline assembly not found in the source."));
+	m_scanner->next();
+	if (m_scanner->currentToken() == Token::StringLiteral)
+		m_scanner->next();
+
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	shared_ptr<yul::Block> block;
+	try
+	{
+		block = yul::Parser(errorReporter, yul::EVMDialect::looseAssemblyForEVM(m_evmVersion)).parse(m_scanner, true);
+	}
+	catch (FatalError const&)
+	{
+	}
+	if (!block || block->location.end != _location.end)
+		BOOST_THROW_EXCEPTION(snapshotError("Inline assembly does not match the source."));
+	return block;
+}
+
+void ASTSnapshotReader::readAnnotations(ASTNode const& _node)
+{
+	if (auto sourceUnit = dynamic_cast<SourceUnit const*>(&_node))
+	{
+		auto& features = sourceUnit->annotation().experimentalFeatures;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			features.insert(readEnum(ExperimentalFeature::TestOnlyAnalysis));
+	}
+	else if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+	{
+		ContractDefinitionAnnotation& annotation = contract->annotation();
+		readDocTags(annotation);
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			annotation.unimplementedFunctions.push_back(readReference<FunctionDefinition>());
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			annotation.linearizedBaseContracts.push_back(readReference<ContractDefinition>());
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			annotation.contractDependencies.insert(readReference<ContractDefinition>());
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+		{
+			auto constructor = readReference<FunctionDefinition>();
+			annotation.baseConstructorArguments[constructor] = readReference();
+		}
+	}
+	else if (auto function = dynamic_cast<FunctionDefinition const*>(&_node))
+	{
+		readDocTags(function->annotation());
+		function->annotation().superFunction = readReference<FunctionDefinition>();
+	}
+	else if (auto event = dynamic_cast<EventDefinition const*>(&_node))
+		readDocTags(event->annotation());
+	else if (auto modifier = dynamic_cast<ModifierDefinition const*>(&_node))
+		readDocTags(modifier->annotation());
+	else if (auto variable = dynamic_cast<VariableDeclaration const*>(&_node))
+		variable->annotation().type = readType();
+	else if (auto inlineAssembly = dynamic_cast<InlineAssembly const*>(&_node))
+	{
+		InlineAssemblyAnnotation& annotation = inlineAssembly->annotation();
+		readDocTags(annotation);
+		map<int, InlineAssemblyAnnotation::ExternalIdentifierInfo> references;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+		{
+			int start = int(readSigned());
+			InlineAssemblyAnnotation::ExternalIdentifierInfo& info = references[start];
+			info.declaration = readReference<Declaration>();
+			info.isSlot = readBool();
+			info.isOffset = readBool();
+			info.valueSize = size_t(readUnsigned()) - 1;
+		}
+
+		// Analyse the operations again to attach the references to the new identifiers.
+		yul::ExternalIdentifierAccess::Resolver resolver = [&](
+			yul::Identifier const& _identifier,
+			yul::IdentifierContext,
+			bool
+		)
+		{
+			auto reference = references.find(_identifier.location.start);
+			if (reference == references.end())
+				return size_t(-1);
+			annotation.externalReferences[&_identifier] = reference->second;
+			return reference->second.valueSize;
+		};
+		annotation.analysisInfo = make_shared<yul::AsmAnalysisInfo>();
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		yul::AsmAnalyzer analyzer(
+			*annotation.analysisInfo,
+			errorReporter,
+			Error::Type::SyntaxError,
+			inlineAssembly->dialect(),
+			resolver
+		);
+		if (!analyzer.analyze(inlineAssembly->operations()))
+			BOOST_THROW_EXCEPTION(snapshotError("Inline assembly analysis failed."));
+	}
+	else if (auto returnStatement = dynamic_cast<Return const*>(&_node))
+	{
+		readDocTags(returnStatement->annotation());
+		returnStatement->annotation().functionReturnParameters = readReference<ParameterList>();
+	}
+	else if (auto statement = dynamic_cast<Statement const*>(&_node))
+		readDocTags(statement->annotation());
+	else if (auto typeName = dynamic_cast<UserDefinedTypeName const*>(&_node))
+	{
+		UserDefinedTypeNameAnnotation& annotation = typeName->annotation();
+		annotation.type = readType();
+		annotation.referencedDeclaration = readReference<Declaration>();
+		annotation.contractScope = readReference<ContractDefinition>();
+	}
+	else if (auto typeName = dynamic_cast<TypeName const*>(&_node))
+		typeName->annotation().type = readType();
+	else if (auto expression = dynamic_cast<Expression const*>(&_node))
+	{
+		ExpressionAnnotation& annotation = expression->annotation();
+		annotation.type = readType();
+		annotation.isConstant = readBool();
+		annotation.isPure = readBool();
+		annotation.isLValue = readBool();
+		annotation.lValueRequested = readBool();
+		if (readBool())
+		{
+			FuncCallArguments arguments;
+			for (uint64_t count = readUnsigned(); count > 0; --count)
+				arguments.types.push_back(readType());
+			for (uint64_t count = readUnsigned(); count > 0; --count)
+				arguments.names.push_back(readString());
+			annotation.arguments = move(arguments);
+		}
+		if (auto identifier = dynamic_cast<Identifier const*>(&_node))
+		{
+			identifier->annotation().referencedDeclaration = readReference<Declaration>();
+			for (uint64_t count = readUnsigned(); count > 0; --count)
+				identifier->annotation().overloadedDeclarations.push_back(readReference<Declaration>());
+		}
+		else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+			memberAccess->annotation().referencedDeclaration = readReference<Declaration>();
+		else if (auto binaryOperation = dynamic_cast<BinaryOperation const*>(&_node))
+			binaryOperation->annotation().commonType = readType();
+		else if (auto functionCall = dynamic_cast<FunctionCall const*>(&_node))
+			functionCall->annotation().kind = readEnum(FunctionCallKind::StructConstructorCall);
+	}
+}
+
+void ASTSnapshotReader::readDocTags(DocumentedAnnotation& _annotation)
+{
+	for (uint64_t count = readUnsigned(); count > 0; --count)
+	{
+		string tag = *readString();
+		DocTag docTag;
+		docTag.content = *readString();
+		docTag.paramName = *readString();
+		_annotation.docTags.emplace(move(tag), move(docTag));
+	}
+}
+
+ASTNode const* ASTSnapshotReader::readReference()
+{
+	ReferenceKind kind = readEnum(ReferenceKind::Super);
+	switch (kind)
+	{
+	case ReferenceKind::Null:
+		return nullptr;
+	case ReferenceKind::Node:
+	{
+		uint64_t sourceIndex = readUnsigned();
+		uint64_t nodeIndex = readUnsigned();
+		if (sourceIndex >= m_nodes.size() || nodeIndex >= m_nodes[sourceIndex].size())
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid node reference."));
+		return m_nodes[sourceIndex][nodeIndex];
+	}
+	case ReferenceKind::Global:
+	{
+		uint64_t index = readUnsigned();
+		if (index >= m_globalDeclarations.size())
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid global declaration."));
+		return m_globalDeclarations[index];
+	}
+	case ReferenceKind::This:
+	case ReferenceKind::Super:
+	{
+		auto contract = readReference<ContractDefinition>();
+		if (!contract)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid contract reference."));
+		m_globalContext->setCurrentContract(*contract);
+		if (kind == ReferenceKind::Super)
+			return m_globalContext->currentSuper();
+		return m_globalContext->currentThis();
+	}
+	}
+	solAssert(false, "");
+}
+
+template <class T>
+T const* ASTSnapshotReader::readReference()
+{
+	ASTNode const* node = readReference();
+	if (!node)
+		return nullptr;
+	auto typedNode = dynamic_cast<T const*>(node);
+	if (!typedNode)
+		BOOST_THROW_EXCEPTION(snapshotError("Reference to an unexpected kind of node."));
+	return typedNode;
+}
+
+Type const* ASTSnapshotReader::readType()
+{
+	uint64_t index = readUnsigned();
+	if (index == 0)
+		return nullptr;
+	if (index > m_types.size())
+		BOOST_THROW_EXCEPTION(snapshotError("Invalid type index."));
+	return m_types[index - 1];
+}
+
+Type const* ASTSnapshotReader::readTypeEntry()
+{
+	auto requireType = [this]()
+	{
+		Type const* type = readType();
+		if (!type)
+			BOOST_THROW_EXCEPTION(snapshotError("Missing type."));
+		return type;
+	};
+	auto readTypes = [&]()
+	{
+		TypePointers types;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			types.push_back(requireType());
+		return types;
+	};
+	auto readStrings = [this]()
+	{
+		strings names;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			names.push_back(*readString());
+		return names;
+	};
+
+	switch (readEnum(Type::Category::InaccessibleDynamic))
+	{
+	case Type::Category::Address:
+		if (readEnum(StateMutability::Payable) == StateMutability::Payable)
+			return TypeProvider::payableAddress();
+		return TypeProvider::address();
+	case Type::Category::Integer:
+	{
+		unsigned bits = unsigned(readUnsigned());
+		bool isSigned = readBool();
+		if (bits == 0 || bits > 256 || bits % 8 != 0)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid integer type."));
+		return TypeProvider::integer(bits, isSigned ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned);
+	}
+	case Type::Category::RationalNumber:
+	{
+		bigint numerator(readData());
+		bigint denominator(readData());
+		if (denominator == 0)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid rational number."));
+		Type const* compatibleBytesType = readType();
+		return TypeProvider::rationalNumber(rational(numerator, denominator), compatibleBytesType);
+	}
+	case Type::Category::StringLiteral:
+		return TypeProvider::stringLiteral(readData());
+	case Type::Category::Bool:
+		return TypeProvider::boolean();
+	case Type::Category::FixedPoint:
+	{
+		unsigned bits = unsigned(readUnsigned());
+		unsigned fractionalDigits = unsigned(readUnsigned());
+		bool isSigned = readBool();
+		return TypeProvider::fixedPoint(
+			bits,
+			fractionalDigits,
+			isSigned ? FixedPointType::Modifier::Signed : FixedPointType::Modifier::Unsigned
+		);
+	}
+	case Type::Category::Array:
+	{
+		DataLocation location = readEnum(DataLocation::Memory);
+		bool isPointer = readBool();
+		ArrayType const* arrayType = nullptr;
+		switch (readUnsigned())
+		{
+		case 0:
+		{
+			Type const* baseType = requireType();
+			if (readBool())
+				arrayType = TypeProvider::array(location, baseType);
+			else
+				arrayType = TypeProvider::array(location, baseType, fromBigEndian<u256>(asBytes(readData())));
+			break;
+		}
+		case 1:
+			arrayType = TypeProvider::array(location, false);
+			break;
+		case 2:
+			arrayType = TypeProvider::array(location, true);
+			break;
+		default:
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid array kind."));
+		}
+		return TypeProvider::withLocation(arrayType, location, isPointer);
+	}
+	case Type::Category::FixedBytes:
+	{
+		uint64_t size = readUnsigned();
+		if (size == 0 || size > 32)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid fixed bytes type."));
+		return TypeProvider::fixedBytes(unsigned(size));
+	}
+	case Type::Category::Contract:
+	{
+		auto contract = readReference<ContractDefinition>();
+		if (!contract)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid contract type."));
+		return TypeProvider::contract(*contract, readBool());
+	}
+	case Type::Category::Struct:
+	{
+		auto structDefinition = readReference<StructDefinition>();
+		if (!structDefinition)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid struct type."));
+		DataLocation location = readEnum(DataLocation::Memory);
+		bool isPointer = readBool();
+		return TypeProvider::withLocation(TypeProvider::structType(*structDefinition, location), location, isPointer);
+	}
+	case Type::Category::Function:
+	{
+		TypePointers parameterTypes = readTypes();
+		TypePointers returnParameterTypes = readTypes();
+		strings parameterNames = readStrings();
+		strings returnParameterNames = readStrings();
+		auto kind = readEnum(FunctionType::Kind::MetaType);
+		bool arbitraryParameters = readBool();
+		auto stateMutability = readEnum(StateMutability::Payable);
+		auto declaration = readReference<Declaration>();
+		bool gasSet = readBool();
+		bool valueSet = readBool();
+		bool bound = readBool();
+		if (
+			parameterNames.size() != parameterTypes.size() ||
+			returnParameterNames.size() != returnParameterTypes.size() ||
+			(bound && parameterTypes.empty())
+		)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid function type."));
+		return TypeProvider::function(
+			parameterTypes,
+			returnParameterTypes,
+			parameterNames,
+			returnParameterNames,
+			kind,
+			arbitraryParameters,
+			stateMutability,
+			declaration,
+			gasSet,
+			valueSet,
+			bound
+		);
+	}
+	case Type::Category::Enum:
+	{
+		auto enumDefinition = readReference<EnumDefinition>();
+		if (!enumDefinition)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid enum type."));
+		return TypeProvider::enumType(*enumDefinition);
+	}
+	case Type::Category::Tuple:
+	{
+		vector<Type const*> components;
+		for (uint64_t count = readUnsigned(); count > 0; --count)
+			components.push_back(readType());
+		return TypeProvider::tuple(move(components));
+	}
+	case Type::Category::Mapping:
+	{
+		Type const* keyType = requireType();
+		Type const* valueType = requireType();
+		return TypeProvider::mapping(keyType, valueType);
+	}
+	case Type::Category::TypeType:
+		return TypeProvider::typeType(requireType());
+	case Type::Category::Modifier:
+	{
+		auto modifier = readReference<ModifierDefinition>();
+		if (!modifier)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid modifier type."));
+		return TypeProvider::modifier(*modifier);
+	}
+	case Type::Category::Magic:
+	{
+		auto kind = readEnum(MagicType::Kind::MetaType);
+		if (kind == MagicType::Kind::MetaType)
+			return TypeProvider::meta(requireType());
+		return TypeProvider::magic(kind);
+	}
+	case Type::Category::Module:
+	{
+		auto sourceUnit = readReference<SourceUnit>();
+		if (!sourceUnit)
+			BOOST_THROW_EXCEPTION(snapshotError("Invalid module type."));
+		return TypeProvider::module(*sourceUnit);
+	}
+	case Type::Category::InaccessibleDynamic:
+		return TypeProvider::inaccessibleDynamic();
+	}
+	solAssert(false, "");
+}
+
+}
+}
@@ -0,0 +1,287 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Binary snapshots of analysed source units, which can be loaded again without scanning,
+ * parsing or analysing the source.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTAnnotations.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceLocation.h>
+
+#include <libdevcore/Common.h>
+#include <libdevcore/Exceptions.h>
+#include <libdevcore/FixedHash.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace langutil
+{
+class CharStream;
+class Scanner;
+}
+
+namespace dev
+{
+namespace solidity
+{
+
+class ASTArena;
+class GlobalContext;
+
+DEV_SIMPLE_EXCEPTION(ASTSnapshotError);
+
+/**
+ * Creates snapshots of analysed source units: their ASTs and the annotations of all nodes,
+ * including the resolved references and the types.
+ *
+ * References to nodes are stored as the index of the node in a traversal of its source unit,
+ * so a snapshot can only be loaded together with exactly the same versions of the sources it
+ * refers to. These are recorded in the snapshot with the hashes of their contents.
+ * Node IDs are not stored, they are assigned again when loading, because they are only unique
+ * within a compilation run.
+ *
+ * The annotations that are set while registering declarations and resolving imports are not
+ * stored, so these steps have to be repeated after loading. The same holds for the analysis
+ * of inline assembly, which is not part of the AST.
+ */
+class ASTSnapshotWriter: private ASTConstVisitor, private boost::noncopyable
+{
+public:
+	/// @param _sources the analysed source units of the compilation and the keccak256 hashes
+	/// of their contents, by source name.
+	ASTSnapshotWriter(
+		std::map<std::string, std::pair<SourceUnit const*, h256>> _sources,
+		GlobalContext const& _globalContext,
+		langutil::EVMVersion _evmVersion
+	);
+
+	/// @returns the snapshot of the source unit with the given name.
+	bytes write(std::string const& _sourceName);
+
+private:
+	bool visit(SourceUnit const& _node) override;
+	bool visit(PragmaDirective const& _node) override;
+	bool visit(ImportDirective const& _node) override;
+	bool visit(ContractDefinition const& _node) override;
+	bool visit(InheritanceSpecifier const& _node) override;
+	bool visit(UsingForDirective const& _node) override;
+	bool visit(StructDefinition const& _node) override;
+	bool visit(EnumDefinition const& _node) override;
+	bool visit(EnumValue const& _node) override;
+	bool visit(ParameterList const& _node) override;
+	bool visit(FunctionDefinition const& _node) override;
+	bool visit(VariableDeclaration const& _node) override;
+	bool visit(ModifierDefinition const& _node) override;
+	bool visit(ModifierInvocation const& _node) override;
+	bool visit(EventDefinition const& _node) override;
+	bool visit(ElementaryTypeName const& _node) override;
+	bool visit(UserDefinedTypeName const& _node) override;
+	bool visit(FunctionTypeName const& _node) override;
+	bool visit(Mapping const& _node) override;
+	bool visit(ArrayTypeName const& _node) override;
+	bool visit(InlineAssembly const& _node) override;
+	bool visit(Block const& _node) override;
+	bool visit(PlaceholderStatement const& _node) override;
+	bool visit(IfStatement const& _node) override;
+	bool visit(WhileStatement const& _node) override;
+	bool visit(ForStatement const& _node) override;
+	bool visit(Continue const& _node) override;
+	bool visit(Break const& _node) override;
+	bool visit(Return const& _node) override;
+	bool visit(Throw const& _node) override;
+	bool visit(EmitStatement const& _node) override;
+	bool visit(VariableDeclarationStatement const& _node) override;
+	bool visit(ExpressionStatement const& _node) override;
+	bool visit(Conditional const& _node) override;
+	bool visit(Assignment const& _node) override;
+	bool visit(TupleExpression const& _node) override;
+	bool visit(UnaryOperation const& _node) override;
+	bool visit(BinaryOperation const& _node) override;
+	bool visit(FunctionCall const& _node) override;
+	bool visit(NewExpression const& _node) override;
+	bool visit(MemberAccess const& _node) override;
+	bool visit(IndexAccess const& _node) override;
+	bool visit(Identifier const& _node) override;
+	bool visit(ElementaryTypeNameExpression const& _node) override;
+	bool visit(Literal const& _node) override;
+
+	/// Writes the kind and the location of a node to the tree.
+	void writeHeader(ASTNode const& _node, uint8_t _kind);
+	/// Writes a node and its children to the tree, or a marker for nullptr.
+	void writeNode(ASTNode const* _node);
+	template <class T>
+	void writeNodes(std::vector<T> const& _nodes);
+	/// Writes a list of nodes that might be missing as a whole.
+	void writeOptionalNodes(std::vector<ASTPointer<Expression>> const* _nodes);
+
+	void writeAnnotations(ASTNode const& _node);
+	void writeDocTags(DocumentedAnnotation const& _annotation);
+
+	/// Writes the index of @a _string in the string table to @a _data.
+	void writeString(bytes& _data, std::string const& _string);
+	void writeOptionalString(bytes& _data, ASTPointer<ASTString> const& _string);
+	/// Writes a reference to a node of any source unit or a global declaration to @a _data.
+	void writeReference(bytes& _data, ASTNode const* _node);
+	/// Writes the index of @a _type in the type table to @a _data, adding it to the table first
+	/// if necessary.
+	void writeType(bytes& _data, Type const* _type);
+	/// @returns the entry of @a _type in the type table, referring to the entries of its
+	/// components, which are added to the table first.
+	bytes typeEntry(Type const& _type);
+
+	/// @returns the nodes of a source unit in the order of a traversal.
+	std::map<ASTNode const*, size_t> const& nodeIndices(std::string const& _sourceName);
+
+	std::map<std::string, std::pair<SourceUnit const*, h256>> m_sources;
+	std::map<int, std::string> m_sourceNamesByID;
+	std::map<Declaration const*, size_t> m_globalDeclarations;
+	langutil::EVMVersion m_evmVersion;
+	std::map<std::string, std::map<ASTNode const*, size_t>> m_nodeIndices;
+
+	/// State of the snapshot that is currently written.
+	/// @{
+	std::string m_sourceName;
+	/// Indices of the sources references can refer to, the source itself has index zero.
+	std::map<std::string, size_t> m_sourceIndices;
+	std::map<std::string, size_t> m_stringIndices;
+	std::vector<std::string const*> m_strings;
+	std::map<Type const*, size_t> m_typeIndices;
+	/// Type table entries that are already present, to merge equal types.
+	std::map<bytes, size_t> m_typeEntries;
+	size_t m_typeCount = 0;
+	bytes m_types;
+	bytes m_tree;
+	bytes m_annotations;
+	/// @}
+};
+
+/**
+ * Loads a snapshot created by @a ASTSnapshotWriter in two steps: First, the AST is rebuilt,
+ * which only requires the source the snapshot was made of, then the annotations are restored,
+ * which requires the ASTs (but not the annotations) of all sources the snapshot refers to.
+ */
+class ASTSnapshotReader: private boost::noncopyable
+{
+public:
+	/// Reads the header of @a _snapshot.
+	/// @throws ASTSnapshotError if it is not a snapshot in a supported format.
+	explicit ASTSnapshotReader(bytes _snapshot);
+
+	/// @returns the version of the compiler that created the snapshot.
+	std::string const& compilerVersion() const { return m_compilerVersion; }
+	/// @returns the EVM version the source was analysed for.
+	langutil::EVMVersion evmVersion() const { return m_evmVersion; }
+	/// @returns the name of the source the snapshot was made of.
+	std::string const& sourceName() const { return m_sourceName; }
+	/// @returns the keccak256 hash of the content of the source the snapshot was made of.
+	h256 const& sourceHash() const { return m_sourceHash; }
+	/// @returns the names of all sources the source imports (directly or indirectly) and the
+	/// keccak256 hashes of their contents.
+	std::map<std::string, h256> const& dependencies() const { return m_dependencies; }
+	/// @returns the absolute paths of the import directives of the source, in order.
+	std::vector<std::string> const& importPaths() const { return m_importPaths; }
+
+	/// Rebuilds the AST in @a _arena (or on the heap if it is nullptr). The locations of the
+	/// nodes refer to @a _source, from which the inline assembly blocks are parsed again.
+	/// @throws ASTSnapshotError if the snapshot is malformed.
+	ASTPointer<SourceUnit> readAST(
+		std::shared_ptr<ASTArena> _arena,
+		std::shared_ptr<langutil::CharStream> _source
+	);
+
+	/// Restores the annotations of the AST returned by @a readAST.
+	/// @param _sourceUnits the source units of the compilation by name, have to include all
+	/// dependencies.
+	/// @throws ASTSnapshotError if the snapshot is malformed.
+	void readAnnotations(
+		std::map<std::string, SourceUnit const*> const& _sourceUnits,
+		GlobalContext& _globalContext
+	);
+
+private:
+	uint64_t readUnsigned();
+	int64_t readSigned();
+	bool readBool();
+	std::string readData();
+	/// Reads an enum value that is at most @a _last.
+	template <class E>
+	E readEnum(E _last);
+	/// Reads an index into the string table.
+	ASTPointer<ASTString> const& readString();
+	ASTPointer<ASTString> readOptionalString();
+	langutil::SourceLocation readLocation();
+
+	ASTPointer<ASTNode> readNode();
+	template <class T>
+	ASTPointer<T> readNode();
+	template <class T>
+	std::vector<ASTPointer<T>> readNodes();
+	std::unique_ptr<std::vector<ASTPointer<Expression>>> readOptionalNodes();
+	template <class T, class... Args>
+	ASTPointer<T> createNode(Args&&... _args);
+	/// Parses the inline assembly block at @a _location again.
+	std::shared_ptr<yul::Block> parseInlineAssembly(langutil::SourceLocation const& _location);
+
+	void readAnnotations(ASTNode const& _node);
+	void readDocTags(DocumentedAnnotation& _annotation);
+	/// Reads a reference written by @a ASTSnapshotWriter::writeReference.
+	ASTNode const* readReference();
+	template <class T>
+	T const* readReference();
+	Type const* readType();
+	/// Reads an entry of the type table.
+	Type const* readTypeEntry();
+
+	bytes m_snapshot;
+	/// Position of the next byte to read.
+	size_t m_position = 0;
+
+	std::string m_compilerVersion;
+	langutil::EVMVersion m_evmVersion;
+	std::string m_sourceName;
+	h256 m_sourceHash;
+	std::map<std::string, h256> m_dependencies;
+	/// Names of the sources references can refer to, by their index.
+	std::vector<std::string> m_sourceNames;
+	std::vector<std::string> m_importPaths;
+
+	std::shared_ptr<ASTArena> m_arena;
+	std::shared_ptr<langutil::CharStream> m_source;
+	std::shared_ptr<langutil::Scanner> m_scanner;
+	std::vector<ASTPointer<ASTString>> m_strings;
+	ASTPointer<SourceUnit> m_ast;
+
+	GlobalContext* m_globalContext = nullptr;
+	std::vector<Declaration const*> m_globalDeclarations;
+	/// The nodes of the source units references can refer to, in the order of a traversal.
+	std::vector<std::vector<ASTNode const*>> m_nodes;
+	std::vector<Type const*> m_types;
+};
+
+}
+}
@@ -19,6 +19,7 @@
 #include <libsolidity/ast/TypeProvider.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <boost/functional/hash.hpp>
 
 using namespace std;
 using namespace dev;
@@ -191,12 +192,85 @@ void TypeProvider::reset()
 	instance().m_stringLiteralTypes.clear();
 	instance().m_ufixedMxN.clear();
 	instance().m_fixedMxN.clear();
+
+	instance().m_implicitConversions.clear();
+	instance().m_commonTypes.clear();
+	instance().m_binaryOperators.clear();
+}
+
+size_t TypeProvider::QueryKeyHash::operator()(QueryKey const& _key) const
+{
+	size_t hash = std::hash<Type const*>{}(_key.first);
+	boost::hash_combine(hash, _key.second);
+	boost::hash_combine(hash, static_cast<unsigned>(_key.op));
+	return hash;
+}
+
+template <class Result>
+template <class Compute>
+Result TypeProvider::QueryCache<Result>::get(QueryKey const& _key, Compute const& _compute)
+{
+	{
+		lock_guard<std::mutex> lock(mutex);
+		auto it = results.find(_key);
+		if (it != results.end())
+		{
+			++hits;
+			return it->second;
+		}
+	}
+	++misses;
+	// Computed without holding the lock, because queries can recursively issue other queries.
+	Result result = _compute();
+	lock_guard<std::mutex> lock(mutex);
+	return results.emplace(_key, move(result)).first->second;
+}
+
+template <class Result>
+void TypeProvider::QueryCache<Result>::clear()
+{
+	lock_guard<std::mutex> lock(mutex);
+	results.clear();
+	hits = 0;
+	misses = 0;
+}
+
+BoolResult TypeProvider::isImplicitlyConvertible(Type const& _from, Type const& _to)
+{
+	return instance().m_implicitConversions.get({&_from, &_to, Token::Illegal}, [&]() {
+		return _from.isImplicitlyConvertibleTo(_to);
+	});
+}
+
+TypePointer TypeProvider::commonType(Type const* _a, Type const* _b)
+{
+	return instance().m_commonTypes.get({_a, _b, Token::Illegal}, [&]() {
+		return Type::commonType(_a, _b);
+	});
+}
+
+TypeResult TypeProvider::binaryOperatorResult(Type const& _left, Token _operator, Type const* _right)
+{
+	return instance().m_binaryOperators.get({&_left, _right, _operator}, [&]() {
+		return _left.binaryOperatorResult(_operator, _right);
+	});
+}
+
+TypeQueryStatistics TypeProvider::queryStatistics()
+{
+	TypeQueryStatistics statistics;
+	statistics.implicitConversions = instance().m_implicitConversions.counters();
+	statistics.commonTypes = instance().m_commonTypes.counters();
+	statistics.binaryOperators = instance().m_binaryOperators.counters();
+	return statistics;
 }
 
 template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
-	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
+	auto type = make_unique<T>(std::forward<Args>(_args)...);
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
+	instance().m_generalTypes.emplace_back(move(type));
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
@@ -295,6 +369,7 @@ TypePointer TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
 	if (!m_bytesStorage)
 		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
 	return m_bytesStorage.get();
@@ -302,6 +377,7 @@ ArrayType const* TypeProvider::bytesStorage()
 
 ArrayType const* TypeProvider::bytesMemory()
 {
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
 	if (!m_bytesMemory)
 		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
 	return m_bytesMemory.get();
@@ -309,6 +385,7 @@ ArrayType const* TypeProvider::bytesMemory()
 
 ArrayType const* TypeProvider::stringStorage()
 {
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
 	if (!m_stringStorage)
 		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
 	return m_stringStorage.get();
@@ -316,6 +393,7 @@ ArrayType const* TypeProvider::stringStorage()
 
 ArrayType const* TypeProvider::stringMemory()
 {
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
 	if (!m_stringMemory)
 		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
 	return m_stringMemory.get();
@@ -358,6 +436,7 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 {
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
 	auto i = instance().m_stringLiteralTypes.find(literal);
 	if (i != instance().m_stringLiteralTypes.end())
 		return i->second.get();
@@ -367,6 +446,7 @@ StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 
 FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPointType::Modifier _modifier)
 {
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
 	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
 
 	auto i = map.find(make_pair(m, n));
@@ -392,7 +472,9 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
+	auto type = _type->copyForLocation(_location, _isPointer);
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
+	instance().m_generalTypes.emplace_back(move(type));
 	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
 }
 
@@ -20,8 +20,11 @@
 #include <libsolidity/ast/Types.h>
 
 #include <array>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 namespace dev
@@ -29,6 +32,22 @@ namespace dev
 namespace solidity
 {
 
+/**
+ * Number of queries on types that were answered by the cache of the TypeProvider and
+ * that had to be computed, since the last reset.
+ */
+struct TypeQueryStatistics
+{
+	struct Counters
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+	};
+	Counters implicitConversions;
+	Counters commonTypes;
+	Counters binaryOperators;
+};
+
 /**
  * API for accessing the Solidity Type System.
  *
@@ -186,7 +205,51 @@ public:
 
 	static MappingType const* mapping(Type const* _keyType, Type const* _valueType);
 
+	/// @name Memoised queries
+	/// Results of pure queries on types, cached by the addresses of the types. The types have
+	/// to be owned by the TypeProvider, since only their addresses are guaranteed not to be
+	/// reused before @a reset, which also clears the cache. Safe to use from multiple threads.
+	/// @{
+	/// Memoised version of @a Type::isImplicitlyConvertibleTo.
+	static BoolResult isImplicitlyConvertible(Type const& _from, Type const& _to);
+	/// Memoised version of @a Type::commonType.
+	static TypePointer commonType(Type const* _a, Type const* _b);
+	/// Memoised version of @a Type::binaryOperatorResult.
+	static TypeResult binaryOperatorResult(Type const& _left, Token _operator, Type const* _right);
+	static TypeQueryStatistics queryStatistics();
+	/// @}
+
 private:
+	/// Key of a memoised query, Token::Illegal for queries without an operator.
+	struct QueryKey
+	{
+		Type const* first;
+		Type const* second;
+		Token op;
+		bool operator==(QueryKey const& _other) const
+		{
+			return first == _other.first && second == _other.second && op == _other.op;
+		}
+	};
+	struct QueryKeyHash
+	{
+		size_t operator()(QueryKey const& _key) const;
+	};
+	template <class Result>
+	struct QueryCache
+	{
+		std::mutex mutex;
+		std::unordered_map<QueryKey, Result, QueryKeyHash> results;
+		std::atomic<size_t> hits{0};
+		std::atomic<size_t> misses{0};
+
+		/// @returns the cached result for @a _key or computes it using @a _compute.
+		template <class Compute>
+		Result get(QueryKey const& _key, Compute const& _compute);
+		void clear();
+		TypeQueryStatistics::Counters counters() const { return {hits, misses}; }
+	};
+
 	/// Global TypeProvider instance.
 	static TypeProvider& instance()
 	{
@@ -218,6 +281,13 @@ private:
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	/// Guards the members above and the lazily created types, because types are also
+	/// created by the threads of a parallel analysis.
+	std::recursive_mutex m_mutex;
+
+	QueryCache<BoolResult> m_implicitConversions;
+	QueryCache<TypePointer> m_commonTypes;
+	QueryCache<TypeResult> m_binaryOperators;
 };
 
 } // namespace solidity
@@ -49,6 +49,12 @@ using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
+recursive_mutex& dev::solidity::lazyComputationMutex()
+{
+	static recursive_mutex mutex;
+	return mutex;
+}
+
 namespace
 {
 
@@ -69,6 +75,36 @@ unsigned int mostSignificantBit(bigint const& _number)
 #endif
 }
 
+/// Numerators and denominators of rational constants are limited to this many bits. All checks
+/// are done before the operation is performed, so that the cost of evaluating a constant
+/// expression is bounded by the cost of operations on numbers of this size.
+size_t const c_rationalPrecisionBits = 4096;
+
+/// @returns true if the numerator and the denominator of _value fit into c_rationalPrecisionBits bits.
+bool fitsPrecision(rational const& _value)
+{
+	if (_value.numerator() == 0)
+		return true;
+	return
+		mostSignificantBit(abs(_value.numerator())) <= c_rationalPrecisionBits &&
+		mostSignificantBit(abs(_value.denominator())) <= c_rationalPrecisionBits;
+}
+
+/// @returns an upper bound for the number of significant digits in base _base of a number that
+/// fits into c_rationalPrecisionBits bits, used to reject literals before converting them.
+size_t maxPrecisionDigits(unsigned _base)
+{
+	return c_rationalPrecisionBits / unsigned(floor(log2(double(_base)))) + 1;
+}
+
+/// @returns false if the digits in [_begin, _end) are too many to fit into
+/// c_rationalPrecisionBits bits, ignoring leading zeros.
+bool fitsPrecisionDigits(string::const_iterator _begin, string::const_iterator _end, unsigned _base)
+{
+	_begin = find_if_not(_begin, _end, [](char const& a) { return a == '0'; });
+	return size_t(distance(_begin, _end)) <= maxPrecisionDigits(_base);
+}
+
 /// Check whether (_base ** _exp) fits into 4096 bits.
 bool fitsPrecisionExp(bigint const& _base, bigint const& _exp)
 {
@@ -77,7 +113,7 @@ bool fitsPrecisionExp(bigint const& _base, bigint const& _exp)
 
 	solAssert(_base > 0, "");
 
-	size_t const bitsMax = 4096;
+	size_t const bitsMax = c_rationalPrecisionBits;
 
 	unsigned mostSignificantBaseBit = mostSignificantBit(_base);
 	if (mostSignificantBaseBit == 0) // _base == 1
@@ -103,7 +139,7 @@ bool fitsPrecisionBaseX(
 
 	solAssert(_mantissa > 0, "");
 
-	size_t const bitsMax = 4096;
+	size_t const bitsMax = c_rationalPrecisionBits;
 
 	unsigned mostSignificantMantissaBit = mostSignificantBit(_mantissa);
 	if (mostSignificantMantissaBit > bitsMax) // _mantissa >= 2 ^ 4096
@@ -216,11 +252,28 @@ pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 
 void MemberList::combine(MemberList const & _other)
 {
+	lock_guard<recursive_mutex> lock(lazyComputationMutex());
 	m_memberTypes += _other.m_memberTypes;
+	m_memberIndices.reset();
+}
+
+vector<size_t> const& MemberList::memberIndices(string const& _name) const
+{
+	static vector<size_t> const noMembers;
+	lock_guard<recursive_mutex> lock(lazyComputationMutex());
+	if (!m_memberIndices)
+	{
+		m_memberIndices = make_unique<unordered_map<string, vector<size_t>>>();
+		for (size_t index = 0; index < m_memberTypes.size(); ++index)
+			(*m_memberIndices)[m_memberTypes[index].name].push_back(index);
+	}
+	auto indices = m_memberIndices->find(_name);
+	return indices == m_memberIndices->end() ? noMembers : indices->second;
 }
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
+	lock_guard<recursive_mutex> lock(lazyComputationMutex());
 	if (!m_storageOffsets)
 	{
 		TypePointers memberTypes;
@@ -230,14 +283,15 @@ pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name)
 		m_storageOffsets.reset(new StorageOffsets());
 		m_storageOffsets->computeOffsets(memberTypes);
 	}
-	for (size_t index = 0; index < m_memberTypes.size(); ++index)
-		if (m_memberTypes[index].name == _name)
-			return m_storageOffsets->offset(index);
-	return nullptr;
+	vector<size_t> const& indices = memberIndices(_name);
+	if (indices.empty())
+		return nullptr;
+	return m_storageOffsets->offset(indices.front());
 }
 
 u256 const& MemberList::storageSize() const
 {
+	lock_guard<recursive_mutex> lock(lazyComputationMutex());
 	// trigger lazy computation
 	memberStorageOffset("");
 	return m_storageOffsets->storageSize();
@@ -324,6 +378,7 @@ TypePointer Type::commonType(Type const* _a, Type const* _b)
 
 MemberList const& Type::members(ContractDefinition const* _currentScope) const
 {
+	lock_guard<recursive_mutex> lock(lazyComputationMutex());
 	if (!m_members[_currentScope])
 	{
 		MemberList::MemberMap members = nativeMembers(_currentScope);
@@ -746,20 +801,41 @@ tuple<bool, rational> RationalNumberType::parseRational(string const& _value)
 				_value.end(),
 				[](char const& a) { return a == '0'; }
 			);
+			// Trailing zeros do not change the value, but would make the denominator larger.
+			auto fractionalEnd = find_if_not(
+				_value.rbegin(),
+				string::const_reverse_iterator(fractionalBegin),
+				[](char const& a) { return a == '0'; }
+			).base();
+
+			// The reduced denominator is at least 2 ** (number of fractional digits).
+			if (size_t(distance(radixPoint + 1, fractionalEnd)) > c_rationalPrecisionBits)
+				return make_tuple(false, rational(0));
+			if (!fitsPrecisionDigits(_value.begin(), radixPoint, 10))
+				return make_tuple(false, rational(0));
 
 			rational numerator;
 			rational denominator(1);
 
-			denominator = bigint(string(fractionalBegin, _value.end()));
-			denominator /= boost::multiprecision::pow(
-				bigint(10),
-				distance(radixPoint + 1, _value.end())
-			);
+			if (fractionalBegin != fractionalEnd)
+			{
+				denominator = bigint(string(fractionalBegin, fractionalEnd));
+				denominator /= boost::multiprecision::pow(
+					bigint(10),
+					distance(radixPoint + 1, fractionalEnd)
+				);
+			}
+			else
+				denominator = 0;
 			numerator = bigint(string(_value.begin(), radixPoint));
 			value = numerator + denominator;
 		}
 		else
+		{
+			if (!fitsPrecisionDigits(_value.begin(), _value.end(), 10))
+				return make_tuple(false, rational(0));
 			value = bigint(_value);
+		}
 		return make_tuple(true, value);
 	}
 	catch (...)
@@ -782,6 +858,8 @@ tuple<bool, rational> RationalNumberType::isValidLiteral(Literal const& _literal
 		if (boost::starts_with(valueString, "0x"))
 		{
 			// process as hex
+			if (!fitsPrecisionDigits(valueString.begin() + 2, valueString.end(), 16))
+				return make_tuple(false, rational(0));
 			value = bigint(valueString);
 		}
 		else if (expPoint != valueString.end())
@@ -868,6 +946,8 @@ tuple<bool, rational> RationalNumberType::isValidLiteral(Literal const& _literal
 			break;
 	}
 
+	if (!fitsPrecision(value))
+		return make_tuple(false, rational(0));
 
 	return make_tuple(true, value);
 }
@@ -987,14 +1067,35 @@ TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const*
 				return nullptr;
 			value = m_value.numerator() & other.m_value.numerator();
 			break;
+		// Integers are combined directly, which avoids the normalisation of the rational result.
 		case Token::Add:
-			value = m_value + other.m_value;
+			if (fractional)
+				value = m_value + other.m_value;
+			else
+				value = m_value.numerator() + other.m_value.numerator();
 			break;
 		case Token::Sub:
-			value = m_value - other.m_value;
+			if (fractional)
+				value = m_value - other.m_value;
+			else
+				value = m_value.numerator() - other.m_value.numerator();
 			break;
 		case Token::Mul:
-			value = m_value * other.m_value;
+			if (fractional)
+				value = m_value * other.m_value;
+			else if (m_value.numerator() == 0 || other.m_value.numerator() == 0)
+				value = 0;
+			else
+			{
+				// The most significant bit of the product is at least the sum of the
+				// most significant bits of the factors, so we can fail without computing it.
+				if (
+					mostSignificantBit(abs(m_value.numerator())) + mostSignificantBit(abs(other.m_value.numerator())) >
+					c_rationalPrecisionBits
+				)
+					return TypeResult::err("Precision of rational constants is limited to 4096 bits.");
+				value = m_value.numerator() * other.m_value.numerator();
+			}
 			break;
 		case Token::Div:
 			if (other.m_value == rational(0))
@@ -1076,7 +1177,11 @@ TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const*
 				uint32_t exponent = other.m_value.numerator().convert_to<uint32_t>();
 				if (!fitsPrecisionBase2(abs(m_value.numerator()), exponent))
 					return nullptr;
-				value = m_value.numerator() * boost::multiprecision::pow(bigint(2), exponent);
+				// Shift the absolute value, left shifts of negative numbers are not supported by bigint.
+				if (m_value.numerator() < 0)
+					value = -(bigint(-m_value.numerator()) << exponent);
+				else
+					value = m_value.numerator() << exponent;
 			}
 			break;
 		}
@@ -1107,9 +1212,9 @@ TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const*
 						// therefore xor(div(xor(x,all_ones), exp(2, shift_amount)), all_ones) is
 						// -(-x - 1) / 2^shift_amount - 1, which is the same as
 						// (x + 1) / 2^shift_amount - 1.
-						value = rational((m_value.numerator() + 1) / boost::multiprecision::pow(bigint(2), exponent) - bigint(1), 1);
+						value = -(bigint(-(m_value.numerator() + 1)) >> exponent) - 1;
 					else
-						value = rational(m_value.numerator() / boost::multiprecision::pow(bigint(2), exponent), 1);
+						value = m_value.numerator() >> exponent;
 				}
 			}
 			break;
@@ -1119,7 +1224,7 @@ TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const*
 		}
 
 		// verify that numerator and denominator fit into 4096 bit after every operation
-		if (value.numerator() != 0 && max(mostSignificantBit(abs(value.numerator())), mostSignificantBit(abs(value.denominator()))) > 4096)
+		if (!fitsPrecision(value))
 			return TypeResult::err("Precision of rational constants is limited to 4096 bits.");
 
 		return TypeResult{TypeProvider::rationalNumber(value)};
@@ -1801,6 +1906,7 @@ TypePointer ArrayType::decodingType() const
 
 TypeResult ArrayType::interfaceType(bool _inLibrary) const
 {
+	lock_guard<recursive_mutex> lock(lazyComputationMutex());
 	if (_inLibrary && m_interfaceType_library.is_initialized())
 		return *m_interfaceType_library;
 
@@ -1925,6 +2031,7 @@ MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const* _con
 
 FunctionType const* ContractType::newExpressionType() const
 {
+	lock_guard<recursive_mutex> lock(lazyComputationMutex());
 	if (!m_constructorType)
 		m_constructorType = FunctionType::newExpressionType(m_contract);
 	return m_constructorType;
@@ -2083,6 +2190,7 @@ MemberList::MemberMap StructType::nativeMembers(ContractDefinition const*) const
 
 TypeResult StructType::interfaceType(bool _inLibrary) const
 {
+	lock_guard<recursive_mutex> lock(lazyComputationMutex());
 	if (_inLibrary && m_interfaceType_library.is_initialized())
 		return *m_interfaceType_library;
 
@@ -3348,13 +3456,18 @@ MemberList::MemberMap TypeType::nativeMembers(ContractDefinition const* _current
 	return members;
 }
 
-ModifierType::ModifierType(ModifierDefinition const& _modifier)
+ModifierType::ModifierType(ModifierDefinition const& _modifier):
+	m_modifier(_modifier)
+{
+}
+
+TypePointers ModifierType::parameterTypes() const
 {
 	TypePointers params;
-	params.reserve(_modifier.parameters().size());
-	for (ASTPointer<VariableDeclaration> const& var: _modifier.parameters())
+	params.reserve(m_modifier.parameters().size());
+	for (ASTPointer<VariableDeclaration> const& var: m_modifier.parameters())
 		params.push_back(var->annotation().type);
-	swap(params, m_parameterTypes);
+	return params;
 }
 
 u256 ModifierType::storageSize() const
@@ -3364,23 +3477,25 @@ u256 ModifierType::storageSize() const
 
 string ModifierType::richIdentifier() const
 {
-	return "t_modifier" + identifierList(m_parameterTypes);
+	TypePointers parameters = parameterTypes();
+	return "t_modifier" + identifierList(parameters);
 }
 
 bool ModifierType::operator==(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
-	ModifierType const& other = dynamic_cast<ModifierType const&>(_other);
+	TypePointers parameters = parameterTypes();
+	TypePointers otherParameters = dynamic_cast<ModifierType const&>(_other).parameterTypes();
 
-	if (m_parameterTypes.size() != other.m_parameterTypes.size())
+	if (parameters.size() != otherParameters.size())
 		return false;
 	auto typeCompare = [](Type const* _a, Type const* _b) -> bool { return *_a == *_b; };
 
 	if (!equal(
-		m_parameterTypes.cbegin(),
-		m_parameterTypes.cend(),
-		other.m_parameterTypes.cbegin(),
+		parameters.cbegin(),
+		parameters.cend(),
+		otherParameters.cbegin(),
 		typeCompare
 	))
 		return false;
@@ -3389,9 +3504,10 @@ bool ModifierType::operator==(Type const& _other) const
 
 string ModifierType::toString(bool _short) const
 {
+	TypePointers parameters = parameterTypes();
 	string name = "modifier (";
-	for (auto it = m_parameterTypes.begin(); it != m_parameterTypes.end(); ++it)
-		name += (*it)->toString(_short) + (it + 1 == m_parameterTypes.end() ? "" : ",");
+	for (auto it = parameters.begin(); it != parameters.end(); ++it)
+		name += (*it)->toString(_short) + (it + 1 == parameters.end() ? "" : ",");
 	return name + ")";
 }
 
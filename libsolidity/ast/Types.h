@@ -36,8 +36,10 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 namespace dev
 {
@@ -66,6 +68,11 @@ inline rational makeRational(bigint const& _numerator, bigint const& _denominato
 
 enum class DataLocation { Storage, CallData, Memory };
 
+/// Guards the caches that types and AST nodes fill lazily, because they are shared
+/// between the threads of a parallel analysis. Recursive because filling one cache
+/// often requires another one.
+std::recursive_mutex& lazyComputationMutex();
+
 
 /**
  * Helper class to compute storage offsets of members of structs and contracts.
@@ -113,21 +120,17 @@ public:
 	void combine(MemberList const& _other);
 	TypePointer memberType(std::string const& _name) const
 	{
-		TypePointer type = nullptr;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-			{
-				solAssert(!type, "Requested member type by non-unique name.");
-				type = it.type;
-			}
-		return type;
+		std::vector<size_t> const& indices = memberIndices(_name);
+		if (indices.empty())
+			return nullptr;
+		solAssert(indices.size() == 1, "Requested member type by non-unique name.");
+		return m_memberTypes[indices.front()].type;
 	}
 	MemberMap membersByName(std::string const& _name) const
 	{
 		MemberMap members;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-				members.push_back(it);
+		for (size_t index: memberIndices(_name))
+			members.push_back(m_memberTypes[index]);
 		return members;
 	}
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
@@ -140,8 +143,14 @@ public:
 	MemberMap::const_iterator end() const { return m_memberTypes.end(); }
 
 private:
+	/// @returns the indices of the members with the given name in declaration order.
+	/// Builds an index of all members on first use, since contracts with many bases can have
+	/// hundreds of members that are looked up for every member access.
+	std::vector<size_t> const& memberIndices(std::string const& _name) const;
+
 	MemberMap m_memberTypes;
 	mutable std::unique_ptr<StorageOffsets> m_storageOffsets;
+	mutable std::unique_ptr<std::unordered_map<std::string, std::vector<size_t>>> m_memberIndices;
 };
 
 static_assert(std::is_nothrow_move_constructible<MemberList>::value, "MemberList should be noexcept move constructible");
@@ -499,6 +508,10 @@ public:
 	/// If the integer part does not fit, returns an empty pointer.
 	FixedPointType const* fixedPointType() const;
 
+	rational const& value() const { return m_value; }
+	/// @returns the bytes type to which the rational can be explicitly converted or nullptr.
+	Type const* compatibleBytesType() const { return m_compatibleBytesType; }
+
 	/// @returns true if the value is not an integer.
 	bool isFractional() const { return m_value.denominator() != 1; }
 
@@ -1078,6 +1091,10 @@ public:
 
 	TypePointers parameterTypes() const;
 	std::vector<std::string> parameterNames() const;
+	/// @returns the parameter types including the "self" parameter of a bound function.
+	TypePointers const& parameterTypesIncludingSelf() const { return m_parameterTypes; }
+	/// @returns the parameter names including the "self" parameter of a bound function.
+	std::vector<std::string> const& parameterNamesIncludingSelf() const { return m_parameterNames; }
 	TypePointers const& returnParameterTypes() const { return m_returnParameterTypes; }
 	/// @returns the list of return parameter types. All dynamically-sized types (this excludes
 	/// storage pointers) are replaced by InaccessibleDynamicType instances.
@@ -1290,8 +1307,13 @@ public:
 	bool operator==(Type const& _other) const override;
 	std::string toString(bool _short) const override;
 
+	ModifierDefinition const& modifierDefinition() const { return m_modifier; }
+	/// @returns the types of the parameters of the modifier, they are only known after
+	/// the references of the modifier have been resolved.
+	TypePointers parameterTypes() const;
+
 private:
-	TypePointers m_parameterTypes;
+	ModifierDefinition const& m_modifier;
 };
 
 
@@ -1317,6 +1339,8 @@ public:
 
 	std::string toString(bool _short) const override;
 
+	SourceUnit const& sourceUnit() const { return m_sourceUnit; }
+
 private:
 	SourceUnit const& m_sourceUnit;
 };
@@ -58,10 +58,21 @@ public:
 	eth::LinkerObject assembledObject() const { return m_context.assembledObject(); }
 	/// @returns Only the runtime object (without constructor).
 	eth::LinkerObject runtimeObject() const { return m_context.assembledRuntimeObject(m_runtimeSub); }
+	/// @returns the sources of the inline assembly blocks generated for the contract.
+	langutil::SourceRegistry generatedSources() const
+	{
+		langutil::SourceRegistry sources = m_context.generatedSources();
+		sources.add(m_runtimeContext.generatedSources());
+		return sources;
+	}
 	/// @arg _sourceCodes is the map of input files to source code strings
-	std::string assemblyString(StringMap const& _sourceCodes = StringMap()) const
+	/// @arg _sources is used to look up the names of the sources referenced by source locations
+	std::string assemblyString(
+		StringMap const& _sourceCodes = StringMap(),
+		langutil::SourceRegistry const* _sources = nullptr
+	) const
 	{
-		return m_context.assemblyString(_sourceCodes);
+		return m_context.assemblyString(_sourceCodes, _sources);
 	}
 	/// @arg _sourceCodes is the map of input files to source code strings
 	Json::Value assemblyJSON(StringMap const& _sourceCodes = StringMap()) const
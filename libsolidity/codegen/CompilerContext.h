@@ -32,6 +32,7 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/Instruction.h>
 #include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceRegistry.h>
 #include <libdevcore/Common.h>
 
 #include <functional>
@@ -237,10 +238,17 @@ public:
 	/// Should be avoided except when adding sub-assemblies.
 	std::shared_ptr<eth::Assembly> assemblyPtr() const { return m_asm; }
 
+	/// @returns the sources of the inline assembly blocks generated by the compiler.
+	langutil::SourceRegistry const& generatedSources() const { return m_generatedSources; }
+
 	/// @arg _sourceCodes is the map of input files to source code strings
-	std::string assemblyString(StringMap const& _sourceCodes = StringMap()) const
+	/// @arg _sources is used to look up the names of the sources referenced by source locations
+	std::string assemblyString(
+		StringMap const& _sourceCodes = StringMap(),
+		langutil::SourceRegistry const* _sources = nullptr
+	) const
 	{
-		return m_asm->assemblyString(_sourceCodes);
+		return m_asm->assemblyString(_sourceCodes, _sources);
 	}
 
 	/// @arg _sourceCodes is the map of input files to source code strings
@@ -326,6 +334,9 @@ private:
 	std::vector<ContractDefinition const*> m_inheritanceHierarchy;
 	/// Stack of current visited AST nodes, used for location attachment
 	std::stack<ASTNode const*> m_visitedNodes;
+	/// Sources of the inline assembly blocks generated by the compiler, kept alive
+	/// because the generated code refers to them by their source ID.
+	langutil::SourceRegistry m_generatedSources;
 	/// The runtime context if in Creation mode, this is used for generating tags that would be stored into the storage and then used at runtime.
 	CompilerContext *m_runtimeContext;
 	/// The index of the runtime subroutine.
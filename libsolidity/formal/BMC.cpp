@@ -18,20 +18,48 @@
 #include <libsolidity/formal/BMC.h>
 
 #include <libsolidity/formal/SMTPortfolio.h>
+#include <libsolidity/formal/Slicing.h>
+#include <libsolidity/formal/Substitution.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <atomic>
+#include <exception>
+#include <thread>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-BMC::BMC(smt::EncodingContext& _context, ErrorReporter& _errorReporter, map<h256, string> const& _smtlib2Responses):
+BMC::BMC(
+	smt::EncodingContext& _context,
+	ErrorReporter& _errorReporter,
+	map<h256, string> const& _smtlib2Responses,
+	ModelCheckerSettings const& _settings
+):
 	SMTEncoder(_context),
 	m_outerErrorReporter(_errorReporter),
-	m_interface(make_shared<smt::SMTPortfolio>(_smtlib2Responses))
+	m_statistics(_settings.statistics)
 {
+	// All solver instances share the budget of the engine.
+	auto budget = make_shared<smt::SolverBudget>(_settings);
+	m_interface = make_shared<smt::SMTPortfolio>(
+		_smtlib2Responses,
+		_settings.portfolio,
+		_settings.queryCache,
+		budget,
+		_settings.solverCommand
+	);
+	for (unsigned i = 1; i < _settings.threads; ++i)
+		m_targetSolvers.emplace_back(make_shared<smt::SMTPortfolio>(
+			_smtlib2Responses,
+			_settings.portfolio,
+			_settings.queryCache,
+			budget,
+			_settings.solverCommand
+		));
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (!_smtlib2Responses.empty())
 		m_errorReporter.warning(
@@ -50,8 +78,9 @@ void BMC::analyze(SourceUnit const& _source, shared_ptr<Scanner> const& _scanner
 	m_scanner = _scanner;
 
 	m_safeAssertions += move(_safeAssertions);
-	m_context.setSolver(m_interface);
+	m_context.setSolver(m_interface, m_targetSolvers);
 	m_context.clear();
+	m_functionSummaries.clear();
 	m_variableUsage.setFunctionInlining(true);
 
 	_source.accept(*this);
@@ -109,6 +138,7 @@ bool BMC::shouldInlineFunctionCall(FunctionCall const& _funCall)
 
 bool BMC::visit(ContractDefinition const& _contract)
 {
+	m_functionSummaries.clear();
 	SMTEncoder::visit(_contract);
 
 	/// Check targets created by state variable initialization.
@@ -416,14 +446,16 @@ void BMC::inlineFunctionCall(FunctionCall const& _funCall)
 			funArgs.push_back(expr(*arg));
 		initializeFunctionCallParameters(*funDef, funArgs);
 
-		// The reason why we need to pushCallStack here instead of visit(FunctionDefinition)
-		// is that there we don't have `_funCall`.
-		pushCallStack({funDef, &_funCall});
-		// If an internal function is called to initialize
-		// a state variable.
-		if (m_callStack.empty())
-			initFunction(*funDef);
-		funDef->accept(*this);
+		if (!summarizable(*funDef, _funCall))
+			visitCalledFunction(*funDef, _funCall);
+		else
+		{
+			auto summary = m_functionSummaries.find(funDef);
+			if (summary == m_functionSummaries.end())
+				m_functionSummaries[funDef] = summarizeFunctionCall(*funDef, _funCall);
+			else if (!summary->second || !instantiateFunctionSummary(*summary->second, *funDef, _funCall))
+				visitCalledFunction(*funDef, _funCall);
+		}
 
 		auto const& returnParams = funDef->returnParameters();
 		if (returnParams.size() > 1)
@@ -443,6 +475,335 @@ void BMC::inlineFunctionCall(FunctionCall const& _funCall)
 	}
 }
 
+void BMC::visitCalledFunction(FunctionDefinition const& _function, FunctionCall const& _funCall)
+{
+	// The reason why we need to pushCallStack here instead of visit(FunctionDefinition)
+	// is that there we don't have `_funCall`.
+	pushCallStack({&_function, &_funCall});
+	// If an internal function is called to initialize
+	// a state variable.
+	if (m_callStack.empty())
+		initFunction(_function);
+	_function.accept(*this);
+}
+
+bool BMC::summarizable(FunctionDefinition const& _function, FunctionCall const& _funCall)
+{
+	auto const& funType = dynamic_cast<FunctionType const&>(*_funCall.expression().annotation().type);
+	return
+		!m_callStack.empty() &&
+		funType.kind() == FunctionType::Kind::Internal &&
+		_function.stateMutability() <= StateMutability::View &&
+		_function.returnParameters().size() <= 1;
+}
+
+boost::optional<BMC::FunctionSummary> BMC::summarizeFunctionCall(
+	FunctionDefinition const& _function,
+	FunctionCall const& _funCall
+)
+{
+	auto ssaIndices = [](auto const& _variables) {
+		map<typename decay_t<decltype(_variables)>::key_type, SSAIndices> indices;
+		for (auto const& variable: _variables)
+			indices[variable.first] = {variable.second->index(), variable.second->nextFreeIndex()};
+		return indices;
+	};
+	// @returns the indices allocated for a variable since @a _before, or nothing if the
+	// variable was not changed.
+	auto ssaAllocation = [](smt::SymbolicVariable const& _variable, boost::optional<SSAIndices> const& _before) {
+		boost::optional<SSAAllocation> allocation;
+		SSAIndices after{_variable.index(), _variable.nextFreeIndex()};
+		if (_before && *_before == after)
+			return allocation;
+		allocation = SSAAllocation{};
+		// A newly created variable starts at index zero.
+		unsigned firstIndex = 0;
+		if (_before)
+		{
+			allocation->entryIndex = _before->index;
+			firstIndex = _before->nextFreeIndex;
+		}
+		for (unsigned index = firstIndex; index < after.nextFreeIndex; ++index)
+			allocation->indices.push_back(index);
+		allocation->exitIndex = after.index;
+		return allocation;
+	};
+
+	auto variablesBefore = ssaIndices(m_context.variables());
+	auto expressionsBefore = ssaIndices(m_context.expressions());
+	auto globalsBefore = ssaIndices(m_context.globalSymbols());
+	string balancesBefore = m_context.balance().name;
+	string thisAddressBefore = m_context.thisAddress().name;
+	size_t errorsBefore = m_errorReporter.errors().size();
+	size_t targetsBefore = m_verificationTargets.size();
+	size_t callStackBefore = m_callStack.size();
+	set<Expression const*> uninterpretedTermsBefore = m_uninterpretedTerms;
+	bool loopExecutionHappened = m_loopExecutionHappened;
+	bool externalFunctionCallHappened = m_externalFunctionCallHappened;
+	bool arrayAssignmentHappened = m_arrayAssignmentHappened;
+	m_loopExecutionHappened = m_externalFunctionCallHappened = m_arrayAssignmentHappened = false;
+
+	// Visit the function without the path conditions and the assertions of the caller,
+	// such that the resulting encoding does not depend on the call site.
+	vector<smt::Expression> pathConditions;
+	swap(pathConditions, m_pathConditions);
+	auto assertions = m_context.swapAssertions({});
+	visitCalledFunction(_function, _funCall);
+	smt::Expression constraints = m_context.assertions();
+	m_context.swapAssertions(move(assertions));
+	swap(pathConditions, m_pathConditions);
+
+	FunctionSummary summary{
+		{}, {}, {}, {},
+		balancesBefore,
+		thisAddressBefore,
+		constraints,
+		{},
+		{},
+		m_loopExecutionHappened,
+		m_externalFunctionCallHappened,
+		m_arrayAssignmentHappened
+	};
+	m_loopExecutionHappened |= loopExecutionHappened;
+	m_externalFunctionCallHappened |= externalFunctionCallHappened;
+	m_arrayAssignmentHappened |= arrayAssignmentHappened;
+	for (auto term: m_uninterpretedTerms)
+		if (!uninterpretedTermsBefore.count(term))
+			summary.uninterpretedTerms.insert(term);
+
+	// Add the encoding of the call.
+	smt::Expression callerConstraints = currentPathConditions() && m_context.assertions();
+	m_context.addAssertion(smt::Expression::implies(currentPathConditions(), constraints));
+	for (size_t i = targetsBefore; i < m_verificationTargets.size(); ++i)
+	{
+		VerificationTarget& target = m_verificationTargets[i];
+		solAssert(target.callStack.size() > callStackBefore, "");
+		summary.targets.push_back({
+			target.type,
+			target.value,
+			target.constraints,
+			target.expression,
+			vector<CallStackEntry>(target.callStack.begin() + callStackBefore + 1, target.callStack.end())
+		});
+		target.constraints = callerConstraints && move(target.constraints);
+	}
+
+	// Check whether the call can be instantiated at other call sites.
+	if (m_errorReporter.errors().size() != errorsBefore || m_callStack.size() != callStackBefore)
+		return {};
+	if (m_context.balance().name != balancesBefore || m_context.thisAddress().name != thisAddressBefore)
+		return {};
+	for (auto const& global: m_context.globalSymbols())
+	{
+		auto before = globalsBefore.find(global.first);
+		if (before == globalsBefore.end() || !(before->second == SSAIndices{global.second->index(), global.second->nextFreeIndex()}))
+			return {};
+		summary.globalSymbols.emplace_back(global.first, global.second->currentName());
+	}
+
+	// Variables of the callers must not be changed, since other callers do not have them.
+	set<VariableDeclaration const*> callerVariables;
+	for (size_t i = 0; i < callStackBefore; ++i)
+	{
+		CallableDeclaration const* caller = m_callStack[i].first;
+		for (auto const& variable: caller->parameters())
+			callerVariables.insert(variable.get());
+		callerVariables += caller->localVariables();
+		if (caller->returnParameterList())
+			for (auto const& variable: caller->returnParameterList()->parameters())
+				callerVariables.insert(variable.get());
+	}
+	set<VariableDeclaration const*> functionVariables;
+	for (auto const& variable: _function.parameters() + _function.returnParameters())
+		functionVariables.insert(variable.get());
+	functionVariables += _function.localVariables();
+
+	map<string, string> names;
+	auto addNames = [&](smt::SymbolicVariable const& _variable, SSAAllocation const& _allocation) -> bool {
+		// Function symbols are only declared at their latest allocated index.
+		if (_variable.sort()->kind == smt::Kind::Function)
+			return false;
+		if (_allocation.entryIndex)
+			names[_variable.nameAtIndex(*_allocation.entryIndex)] = _variable.nameAtIndex(*_allocation.entryIndex);
+		for (unsigned index: _allocation.indices)
+			names[_variable.nameAtIndex(index)] = _variable.nameAtIndex(index);
+		return
+			_allocation.entryIndex == _allocation.exitIndex ||
+			find(_allocation.indices.begin(), _allocation.indices.end(), _allocation.exitIndex) != _allocation.indices.end();
+	};
+	for (auto const& variable: m_context.variables())
+	{
+		auto before = variablesBefore.find(variable.first);
+		boost::optional<SSAIndices> indices;
+		if (before != variablesBefore.end())
+			indices = before->second;
+		auto allocation = ssaAllocation(*variable.second, indices);
+		if (!allocation && functionVariables.count(variable.first))
+			allocation = SSAAllocation{indices->index, {}, indices->index};
+		if (!allocation)
+		{
+			if (variable.first->isStateVariable())
+				summary.stateVariables.emplace_back(variable.first, variable.second->currentName());
+			continue;
+		}
+		if (
+			variable.first->isStateVariable() ||
+			(indices && callerVariables.count(variable.first)) ||
+			!addNames(*variable.second, *allocation)
+		)
+			return {};
+		summary.variables.emplace_back(variable.first, move(*allocation));
+	}
+	for (auto const& expression: m_context.expressions())
+	{
+		auto before = expressionsBefore.find(expression.first);
+		boost::optional<SSAIndices> indices;
+		if (before != expressionsBefore.end())
+			indices = before->second;
+		auto allocation = ssaAllocation(*expression.second, indices);
+		if (!allocation)
+			continue;
+		if (!addNames(*expression.second, *allocation))
+			return {};
+		summary.expressions.emplace_back(expression.first, move(*allocation));
+	}
+
+	// The encoding must only refer to the variables above.
+	for (auto const& stateVariable: summary.stateVariables)
+		names[stateVariable.second] = stateVariable.second;
+	for (auto const& global: summary.globalSymbols)
+		names[global.second] = global.second;
+	names[balancesBefore] = balancesBefore;
+	names[thisAddressBefore] = thisAddressBefore;
+	if (!smt::renameSymbols(summary.constraints, names))
+		return {};
+	for (auto const& target: summary.targets)
+		if (
+			target.type == VerificationTarget::Type::ConstantCondition ||
+			!smt::renameSymbols(target.value, names) ||
+			!smt::renameSymbols(target.constraints, names)
+		)
+			return {};
+
+	return summary;
+}
+
+bool BMC::instantiateFunctionSummary(
+	FunctionSummary const& _summary,
+	FunctionDefinition const& _function,
+	FunctionCall const& _funCall
+)
+{
+	map<string, string> names;
+	for (auto const& stateVariable: _summary.stateVariables)
+		if (m_context.knownVariable(*stateVariable.first))
+			names[stateVariable.second] = m_context.variable(*stateVariable.first)->currentName();
+	for (auto const& global: _summary.globalSymbols)
+		if (m_context.knownGlobalSymbol(global.first))
+			names[global.second] = m_context.globalSymbol(global.first)->currentName();
+	names[_summary.balances] = m_context.balance().name;
+	names[_summary.thisAddress] = m_context.thisAddress().name;
+
+	// Plans the allocation of fresh indices of the same shape as in the summary.
+	struct Allocation
+	{
+		shared_ptr<smt::SymbolicVariable> variable;
+		SSAAllocation const* summary;
+		bool create;
+		/// First index that is allocated for the variable.
+		unsigned firstIndex;
+	};
+	vector<Allocation> allocations;
+	auto plan = [&](shared_ptr<smt::SymbolicVariable> _variable, SSAAllocation const& _allocation) {
+		allocations.push_back({_variable, &_allocation, !_variable, _variable ? _variable->nextFreeIndex() : 0});
+	};
+	for (auto const& variable: _summary.variables)
+		plan(m_context.knownVariable(*variable.first) ? m_context.variable(*variable.first) : nullptr, variable.second);
+	for (auto const& expression: _summary.expressions)
+		plan(m_context.knownExpression(*expression.first) ? m_context.expression(*expression.first) : nullptr, expression.second);
+
+	// Variables and expressions that do not exist yet start at index zero.
+	for (size_t i = 0; i < allocations.size(); ++i)
+		if (allocations[i].create)
+		{
+			if (i < _summary.variables.size())
+			{
+				VariableDeclaration const& variable = *_summary.variables[i].first;
+				if (m_context.createVariable(variable))
+					return false;
+				allocations[i].variable = m_context.variable(variable);
+			}
+			else
+			{
+				Expression const& expression = *_summary.expressions[i - _summary.variables.size()].first;
+				if (m_context.createExpression(expression))
+					return false;
+				allocations[i].variable = m_context.expression(expression);
+			}
+		}
+
+	for (auto const& allocation: allocations)
+	{
+		smt::SymbolicVariable const& variable = *allocation.variable;
+		if (allocation.summary->entryIndex && !allocation.create)
+			names[variable.nameAtIndex(*allocation.summary->entryIndex)] = variable.currentName();
+		for (size_t i = 0; i < allocation.summary->indices.size(); ++i)
+			names[variable.nameAtIndex(allocation.summary->indices[i])] = variable.nameAtIndex(allocation.firstIndex + i);
+	}
+
+	auto constraints = smt::renameSymbols(_summary.constraints, names);
+	if (!constraints)
+		return false;
+	vector<pair<smt::Expression, smt::Expression>> targets;
+	for (auto const& target: _summary.targets)
+	{
+		auto value = smt::renameSymbols(target.value, names);
+		auto targetConstraints = smt::renameSymbols(target.constraints, names);
+		if (!value || !targetConstraints)
+			return false;
+		targets.emplace_back(move(*value), move(*targetConstraints));
+	}
+
+	for (auto const& allocation: allocations)
+	{
+		auto const& indices = allocation.summary->indices;
+		unsigned exitIndex = allocation.variable->index();
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			unsigned index = allocation.firstIndex + unsigned(i);
+			if (!(allocation.create && i == 0))
+				allocation.variable->increaseIndex();
+			solAssert(allocation.variable->index() == index, "");
+			if (indices[i] == allocation.summary->exitIndex)
+				exitIndex = index;
+		}
+		allocation.variable->index() = exitIndex;
+	}
+
+	smt::Expression callerConstraints = currentPathConditions() && m_context.assertions();
+	m_context.addAssertion(smt::Expression::implies(currentPathConditions(), move(*constraints)));
+	m_uninterpretedTerms += _summary.uninterpretedTerms;
+	m_loopExecutionHappened |= _summary.loopExecutionHappened;
+	m_externalFunctionCallHappened |= _summary.externalFunctionCallHappened;
+	m_arrayAssignmentHappened |= _summary.arrayAssignmentHappened;
+
+	auto callStack = m_callStack;
+	callStack.emplace_back(&_function, &_funCall);
+	for (size_t i = 0; i < targets.size(); ++i)
+	{
+		TargetSummary const& target = _summary.targets[i];
+		m_verificationTargets.push_back({
+			target.type,
+			move(targets[i].first),
+			callerConstraints && move(targets[i].second),
+			target.expression,
+			callStack + target.callStack,
+			modelExpressions()
+		});
+	}
+	return true;
+}
+
 void BMC::abstractFunctionCall(FunctionCall const& _funCall)
 {
 	vector<smt::Expression> smtArguments;
@@ -543,8 +904,27 @@ pair<vector<smt::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets(smt::Expression const& _constraints)
 {
+	// The queries are only answered concurrently if an integrated solver is available,
+	// since the SMT-LIB2 queries are requested in a deterministic order.
+	if (m_targetSolvers.empty() || m_interface->solvers() == 1)
+	{
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target, _constraints);
+		return;
+	}
+
+	// The targets are independent given the constraints, so all queries are collected first,
+	// answered concurrently and then reported in the order of the targets.
+	m_deferQueries = true;
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target, _constraints);
+	m_deferQueries = false;
+
+	vector<ConditionQuery> queries = move(m_deferredQueries);
+	m_deferredQueries.clear();
+	answerQueriesConcurrently(queries);
+	for (auto const& query: queries)
+		reportQuery(query);
 }
 
 void BMC::checkVerificationTarget(VerificationTarget& _target, smt::Expression const& _constraints)
@@ -599,7 +979,8 @@ void BMC::checkUnderflow(VerificationTarget& _target, smt::Expression const& _co
 	auto intType = dynamic_cast<IntegerType const*>(_target.expression->annotation().type);
 	solAssert(intType, "");
 	checkCondition(
-		_target.constraints && _constraints && _target.value < smt::minValue(*intType),
+		_target.constraints && _constraints,
+		_target.value < smt::minValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -619,7 +1000,8 @@ void BMC::checkOverflow(VerificationTarget& _target, smt::Expression const& _con
 	auto intType = dynamic_cast<IntegerType const*>(_target.expression->annotation().type);
 	solAssert(intType, "");
 	checkCondition(
-		_target.constraints && _constraints && _target.value > smt::maxValue(*intType),
+		_target.constraints && _constraints,
+		_target.value > smt::maxValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -633,7 +1015,8 @@ void BMC::checkDivByZero(VerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTarget::Type::DivByZero, "");
 	checkCondition(
-		_target.constraints && (_target.value == 0),
+		_target.constraints,
+		_target.value == 0,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -647,7 +1030,8 @@ void BMC::checkBalance(VerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTarget::Type::Balance, "");
 	checkCondition(
-		_target.constraints && _target.value,
+		_target.constraints,
+		_target.value,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -661,7 +1045,8 @@ void BMC::checkAssert(VerificationTarget& _target)
 	solAssert(_target.type == VerificationTarget::Type::Assert, "");
 	if (!m_safeAssertions.count(_target.expression))
 		checkCondition(
-			_target.constraints && !_target.value,
+			_target.constraints,
+			!_target.value,
 			_target.callStack,
 			_target.modelExpressions,
 			_target.expression->location(),
@@ -692,7 +1077,8 @@ void BMC::addVerificationTarget(
 /// Solving.
 
 void BMC::checkCondition(
-	smt::Expression _condition,
+	smt::Expression _constraints,
+	smt::Expression _target,
 	vector<SMTEncoder::CallStackEntry> const& callStack,
 	pair<vector<smt::Expression>, vector<string>> const& _modelExpressions,
 	SourceLocation const& _location,
@@ -701,24 +1087,123 @@ void BMC::checkCondition(
 	smt::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
-	vector<smt::Expression> expressionsToEvaluate;
-	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
+	ConditionQuery query{
+		move(_constraints),
+		move(_target),
+		{},
+		callStack,
+		{},
+		{},
+		_location,
+		_description,
+		smt::CheckResult::ERROR,
+		{},
+		{}
+	};
+	// Slicing does not pay off if the queries are answered by the SMT-LIB2 callback only.
+	if (m_interface->solvers() > 1)
+		query.slicedCondition = smt::sliceConstraints(query.constraints, query.target);
+	tie(query.expressionsToEvaluate, query.expressionNames) = _modelExpressions;
 	if (callStack.size())
 	{
 		solAssert(m_scanner, "");
 		if (_additionalValue)
 		{
-			expressionsToEvaluate.emplace_back(*_additionalValue);
-			expressionNames.push_back(_additionalValueName);
+			query.expressionsToEvaluate.emplace_back(*_additionalValue);
+			query.expressionNames.push_back(_additionalValueName);
 		}
 	}
-	smt::CheckResult result;
-	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+
+	if (m_deferQueries)
+	{
+		m_deferredQueries.emplace_back(move(query));
+		return;
+	}
+
+	answerQuery(*m_interface, query);
+	reportQuery(query);
+}
+
+void BMC::answerQuery(smt::SolverInterface& _solver, ConditionQuery& _query)
+{
+	auto start = chrono::steady_clock::now();
+
+	// If the target is unsatisfiable together with the constraints it depends on, it is
+	// unsatisfiable together with all of them. Otherwise, the dropped constraints might still
+	// contradict each other and the counterexample has to satisfy them as well, so the solver
+	// is queried again with all constraints.
+	if (_query.slicedCondition)
+	{
+		_solver.push();
+		_solver.addAssertion(*_query.slicedCondition);
+		smt::CheckResult result;
+		std::tie(result, std::ignore, std::ignore) = checkSatisfiableAndGenerateModel(_solver, {});
+		_solver.pop();
+		if (result == smt::CheckResult::UNSATISFIABLE)
+		{
+			_query.result = result;
+			_query.answeredBy = _solver.answeredBy();
+			_query.answeredBySlice = true;
+			_query.solveTime = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+			return;
+		}
+	}
+
+	_solver.push();
+	_solver.addAssertion(_query.constraints && _query.target);
+	std::tie(_query.result, _query.values, _query.solverError) =
+		checkSatisfiableAndGenerateModel(_solver, _query.expressionsToEvaluate);
+	_solver.pop();
+	_query.answeredBy = _solver.answeredBy();
+	_query.solveTime = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+}
+
+void BMC::answerQueriesConcurrently(vector<ConditionQuery>& _queries)
+{
+	vector<shared_ptr<smt::SolverInterface>> solvers{m_interface};
+	solvers.insert(solvers.end(), m_targetSolvers.begin(), m_targetSolvers.end());
+	if (solvers.size() > _queries.size())
+		solvers.resize(_queries.size());
+
+	atomic<size_t> nextQuery{0};
+	vector<exception_ptr> exceptions(solvers.size());
+	vector<thread> threads;
+	for (size_t i = 0; i < solvers.size(); ++i)
+		threads.emplace_back([&, i]() {
+			try
+			{
+				for (size_t query = nextQuery++; query < _queries.size(); query = nextQuery++)
+					answerQuery(*solvers[i], _queries[query]);
+			}
+			catch (...)
+			{
+				exceptions[i] = current_exception();
+			}
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	for (auto const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
+
+void BMC::reportQuery(ConditionQuery const& _query)
+{
+	if (m_statistics)
+		recordStatistics(
+			_query.location,
+			_query.description,
+			_query.result,
+			_query.answeredBy,
+			_query.solveTime,
+			_query.answeredBySlice ?
+				smt::expressionSize(*_query.slicedCondition) :
+				smt::expressionSize(_query.constraints) + smt::expressionSize(_query.target) + 1
+		);
+
+	if (_query.solverError)
+		m_errorReporter.warning(*_query.solverError);
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -735,53 +1220,64 @@ void BMC::checkCondition(
 	SecondarySourceLocation secondaryLocation{};
 	secondaryLocation.append(extraComment, SourceLocation{});
 
-	switch (result)
+	switch (_query.result)
 	{
 	case smt::CheckResult::SATISFIABLE:
 	{
 		std::ostringstream message;
-		message << _description << " happens here";
-		if (callStack.size())
+		message << _query.description << " happens here";
+		if (_query.callStack.size())
 		{
 			std::ostringstream modelMessage;
 			modelMessage << "  for:\n";
-			solAssert(values.size() == expressionNames.size(), "");
+			solAssert(_query.values.size() == _query.expressionNames.size(), "");
 			map<string, string> sortedModel;
-			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
-					sortedModel[expressionNames.at(i)] = values.at(i);
+			for (size_t i = 0; i < _query.values.size(); ++i)
+				if (_query.expressionsToEvaluate.at(i).name != _query.values.at(i))
+					sortedModel[_query.expressionNames.at(i)] = _query.values.at(i);
 
 			for (auto const& eval: sortedModel)
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 			m_errorReporter.warning(
-				_location,
+				_query.location,
 				message.str(),
 				SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-				.append(SMTEncoder::callStackMessage(callStack))
+				.append(SMTEncoder::callStackMessage(_query.callStack))
 				.append(move(secondaryLocation))
 			);
 		}
 		else
 		{
 			message << ".";
-			m_errorReporter.warning(_location, message.str(), secondaryLocation);
+			m_errorReporter.warning(_query.location, message.str(), secondaryLocation);
 		}
 		break;
 	}
 	case smt::CheckResult::UNSATISFIABLE:
 		break;
 	case smt::CheckResult::UNKNOWN:
-		m_errorReporter.warning(_location, _description + " might happen here.", secondaryLocation);
+		m_errorReporter.warning(_query.location, _query.description + " might happen here.", secondaryLocation);
 		break;
 	case smt::CheckResult::CONFLICTING:
-		m_errorReporter.warning(_location, "At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(_query.location, "At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smt::CheckResult::ERROR:
-		m_errorReporter.warning(_location, "Error trying to invoke SMT solver.");
+		m_errorReporter.warning(_query.location, "Error trying to invoke SMT solver.");
 		break;
 	}
+}
 
-	m_interface->pop();
+void BMC::recordStatistics(
+	SourceLocation const& _location,
+	string const& _description,
+	smt::CheckResult _result,
+	string const& _answeredBy,
+	chrono::milliseconds _solveTime,
+	size_t _querySize
+)
+{
+	solAssert(m_statistics, "");
+	m_statistics->targets.push_back({"BMC", _location, _description, _result, _answeredBy, _solveTime, _querySize});
 }
 
 void BMC::checkBooleanNotConstant(
@@ -796,15 +1292,25 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	auto check = [&](smt::Expression const& _query, string const& _description) {
+		auto start = chrono::steady_clock::now();
+		m_interface->push();
+		m_interface->addAssertion(_query);
+		auto result = checkSatisfiable();
+		m_interface->pop();
+		if (m_statistics)
+			recordStatistics(
+				_condition.location(),
+				_description,
+				result,
+				m_interface->answeredBy(),
+				chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start),
+				smt::expressionSize(_query)
+			);
+		return result;
+	};
+	auto positiveResult = check(_constraints && _value, "Condition is true");
+	auto negatedResult = check(_constraints && !_value, "Condition is false");
 
 	if (positiveResult == smt::CheckResult::ERROR || negatedResult == smt::CheckResult::ERROR)
 		m_errorReporter.warning(_condition.location(), "Error trying to invoke SMT solver.");
@@ -847,16 +1353,32 @@ BMC::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _expression
 {
 	smt::CheckResult result;
 	vector<string> values;
+	boost::optional<string> error;
+	std::tie(result, values, error) = checkSatisfiableAndGenerateModel(*m_interface, _expressionsToEvaluate);
+	if (error)
+		m_errorReporter.warning(*error);
+	return make_pair(result, values);
+}
+
+tuple<smt::CheckResult, vector<string>, boost::optional<string>>
+BMC::checkSatisfiableAndGenerateModel(
+	smt::SolverInterface& _solver,
+	vector<smt::Expression> const& _expressionsToEvaluate
+)
+{
+	smt::CheckResult result;
+	vector<string> values;
+	boost::optional<string> error;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = _solver.check(_expressionsToEvaluate);
 	}
 	catch (smt::SolverError const& _e)
 	{
 		string description("Error querying SMT solver");
 		if (_e.comment())
 			description += ": " + *_e.comment();
-		m_errorReporter.warning(description);
+		error = description;
 		result = smt::CheckResult::ERROR;
 	}
 
@@ -870,7 +1392,7 @@ BMC::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _expression
 		catch (...) { }
 	}
 
-	return make_pair(result, values);
+	return make_tuple(result, values, error);
 }
 
 smt::CheckResult BMC::checkSatisfiable()
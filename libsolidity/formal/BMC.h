@@ -29,6 +29,8 @@
 
 
 #include <libsolidity/formal/EncodingContext.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 #include <libsolidity/formal/SMTEncoder.h>
 #include <libsolidity/formal/SolverInterface.h>
 
@@ -36,8 +38,13 @@
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/Scanner.h>
 
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <map>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace langutil
@@ -54,7 +61,12 @@ namespace solidity
 class BMC: public SMTEncoder
 {
 public:
-	BMC(smt::EncodingContext& _context, langutil::ErrorReporter& _errorReporter, std::map<h256, std::string> const& _smtlib2Responses);
+	BMC(
+		smt::EncodingContext& _context,
+		langutil::ErrorReporter& _errorReporter,
+		std::map<h256, std::string> const& _smtlib2Responses,
+		ModelCheckerSettings const& _settings = ModelCheckerSettings{}
+	);
 
 	void analyze(SourceUnit const& _sources, std::shared_ptr<langutil::Scanner> const& _scanner, std::set<Expression const*> _safeAssertions);
 
@@ -95,6 +107,8 @@ private:
 	/// Inlines if the function call is internal or external to `this`.
 	/// Erases knowledge about state variables if external.
 	void internalOrExternalFunctionCall(FunctionCall const& _funCall);
+	/// Visits @a _function, which is called by @a _funCall.
+	void visitCalledFunction(FunctionDefinition const& _function, FunctionCall const& _funCall);
 
 	/// Creates underflow/overflow verification targets.
 	std::pair<smt::Expression, smt::Expression> arithmeticOperation(
@@ -138,11 +152,116 @@ private:
 	);
 	//@}
 
+	/// Function summaries.
+	//@{
+	/// SSA indices of a symbolic variable.
+	struct SSAIndices
+	{
+		unsigned index;
+		unsigned nextFreeIndex;
+		bool operator==(SSAIndices const& _other) const
+		{
+			return index == _other.index && nextFreeIndex == _other.nextFreeIndex;
+		}
+	};
+	/// SSA indices a call allocated for a symbolic variable.
+	struct SSAAllocation
+	{
+		/// Index before the call, or nothing if the variable was created by the call.
+		boost::optional<unsigned> entryIndex;
+		/// Indices allocated by the call, in the order of their allocation.
+		std::vector<unsigned> indices;
+		/// Index after the call.
+		unsigned exitIndex;
+	};
+	/// Verification target created by a call, relative to the call.
+	struct TargetSummary
+	{
+		VerificationTarget::Type type;
+		smt::Expression value;
+		/// Path conditions within the called function and the assertions of the call before the target.
+		smt::Expression constraints;
+		Expression const* expression;
+		/// Call stack within the called function.
+		std::vector<CallStackEntry> callStack;
+	};
+	/**
+	 * Encoding of a call to a pure or view internal function, independent of its call site.
+	 *
+	 * The encoding relates the SSA indices of the parameters before the call to the indices of
+	 * the return parameter after the call. Each further call instantiates the summary by
+	 * allocating fresh indices of the same shape, i.e. of the same number for each variable, and
+	 * by renaming the variables of the encoding accordingly, instead of visiting the function
+	 * again. State variables and global symbols are only read by the call and are renamed to
+	 * their indices at the call site.
+	 */
+	struct FunctionSummary
+	{
+		std::vector<std::pair<VariableDeclaration const*, SSAAllocation>> variables;
+		std::vector<std::pair<Expression const*, SSAAllocation>> expressions;
+		/// Names of the values of state variables and global symbols at the start of the call.
+		std::vector<std::pair<VariableDeclaration const*, std::string>> stateVariables;
+		std::vector<std::pair<std::string, std::string>> globalSymbols;
+		std::string balances;
+		std::string thisAddress;
+		/// Conjunction of the assertions added by the call, implied by the path conditions at the
+		/// call site.
+		smt::Expression constraints;
+		std::vector<TargetSummary> targets;
+		std::set<Expression const*> uninterpretedTerms;
+		bool loopExecutionHappened;
+		bool externalFunctionCallHappened;
+		bool arrayAssignmentHappened;
+	};
+
+	/// @returns true if calls like @a _funCall to @a _function can be summarized.
+	bool summarizable(FunctionDefinition const& _function, FunctionCall const& _funCall);
+	/// Visits @a _function, which is called by @a _funCall, separately from the caller and adds the
+	/// resulting encoding to the context.
+	/// @returns the summary of the call, or nothing if the call cannot be instantiated at other
+	/// call sites.
+	boost::optional<FunctionSummary> summarizeFunctionCall(FunctionDefinition const& _function, FunctionCall const& _funCall);
+	/// Instantiates @a _summary of a previous call to @a _function for @a _funCall.
+	/// @returns false and adds nothing to the encoding if the SSA indices of the context do not
+	/// allow it.
+	bool instantiateFunctionSummary(
+		FunctionSummary const& _summary,
+		FunctionDefinition const& _function,
+		FunctionCall const& _funCall
+	);
+	//@}
+
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// A query whether a condition can be satisfied, which is reported once it is answered.
+	struct ConditionQuery
+	{
+		smt::Expression constraints;
+		smt::Expression target;
+		/// Conjunction of the target and the constraints it depends on, if it drops any constraint.
+		boost::optional<smt::Expression> slicedCondition;
+		std::vector<CallStackEntry> callStack;
+		std::vector<smt::Expression> expressionsToEvaluate;
+		std::vector<std::string> expressionNames;
+		langutil::SourceLocation location;
+		std::string description;
+		smt::CheckResult result = smt::CheckResult::ERROR;
+		std::vector<std::string> values;
+		/// Description of the error if querying the solver failed.
+		boost::optional<std::string> solverError;
+		/// Statistics about answering the query.
+		//@{
+		std::chrono::milliseconds solveTime{0};
+		std::string answeredBy;
+		bool answeredBySlice = false;
+		//@}
+	};
+
+	/// Check that @a _target can be satisfied together with @a _constraints.
+	/// If m_deferQueries is set, the query is only added to m_deferredQueries.
 	void checkCondition(
-		smt::Expression _condition,
+		smt::Expression _constraints,
+		smt::Expression _target,
 		std::vector<CallStackEntry> const& callStack,
 		std::pair<std::vector<smt::Expression>, std::vector<std::string>> const& _modelExpressions,
 		langutil::SourceLocation const& _location,
@@ -160,8 +279,31 @@ private:
 		std::vector<CallStackEntry> const& _callStack,
 		std::string const& _description
 	);
+	/// Answers @a _query using @a _solver without reporting anything, such that it can
+	/// be called concurrently for different solvers.
+	static void answerQuery(smt::SolverInterface& _solver, ConditionQuery& _query);
+	/// Answers the queries using m_interface and the solvers in m_targetSolvers concurrently.
+	void answerQueriesConcurrently(std::vector<ConditionQuery>& _queries);
+	void reportQuery(ConditionQuery const& _query);
+	/// Adds the statistics of a query to m_statistics, which must not be null.
+	void recordStatistics(
+		langutil::SourceLocation const& _location,
+		std::string const& _description,
+		smt::CheckResult _result,
+		std::string const& _answeredBy,
+		std::chrono::milliseconds _solveTime,
+		std::size_t _querySize
+	);
+
 	std::pair<smt::CheckResult, std::vector<std::string>>
 	checkSatisfiableAndGenerateModel(std::vector<smt::Expression> const& _expressionsToEvaluate);
+	/// @returns the result, the formatted values of the expressions and the description of
+	/// the error if querying the solver failed.
+	static std::tuple<smt::CheckResult, std::vector<std::string>, boost::optional<std::string>>
+	checkSatisfiableAndGenerateModel(
+		smt::SolverInterface& _solver,
+		std::vector<smt::Expression> const& _expressionsToEvaluate
+	);
 
 	smt::CheckResult checkSatisfiable();
 	//@}
@@ -179,6 +321,18 @@ private:
 	std::set<Expression const*> m_safeAssertions;
 
 	std::shared_ptr<smt::SolverInterface> m_interface;
+	/// Solvers that check verification targets concurrently with m_interface.
+	std::vector<std::shared_ptr<smt::SolverInterface>> m_targetSolvers;
+
+	/// Statistics about the verification targets, or null.
+	std::shared_ptr<smt::ModelCheckerStatistics> m_statistics;
+
+	bool m_deferQueries = false;
+	std::vector<ConditionQuery> m_deferredQueries;
+
+	/// Summaries of the calls to pure and view internal functions of the current contract,
+	/// or nothing if the calls to the function cannot be summarized.
+	std::map<FunctionDefinition const*, boost::optional<FunctionSummary>> m_functionSummaries;
 };
 
 }
@@ -23,20 +23,122 @@
 
 #include <libsolidity/formal/SymbolicTypes.h>
 
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 using namespace std;
 using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-CHC::CHC(smt::EncodingContext& _context, ErrorReporter& _errorReporter):
+namespace
+{
+
+/// @returns the contract @a _declaration is part of, or null if it is not part of a contract.
+ContractDefinition const* enclosingContract(Declaration const* _declaration)
+{
+	ASTNode const* node = _declaration;
+	while (node)
+	{
+		if (auto contract = dynamic_cast<ContractDefinition const*>(node))
+			return contract;
+		auto declaration = dynamic_cast<Declaration const*>(node);
+		node = declaration ? declaration->scope() : nullptr;
+	}
+	return nullptr;
+}
+
+/// @returns the contracts whose declarations are referenced in @a _contract.
+set<ContractDefinition const*> referencedContracts(ContractDefinition const& _contract)
+{
+	set<ContractDefinition const*> contracts;
+	for (auto base: _contract.annotation().linearizedBaseContracts)
+		contracts.insert(base);
+	contracts += _contract.annotation().contractDependencies;
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) {
+			Declaration const* declaration = nullptr;
+			if (auto identifier = dynamic_cast<Identifier const*>(&_node))
+				declaration = identifier->annotation().referencedDeclaration;
+			else if (auto typeName = dynamic_cast<UserDefinedTypeName const*>(&_node))
+				declaration = typeName->annotation().referencedDeclaration;
+			else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+				declaration = memberAccess->annotation().referencedDeclaration;
+			if (auto contract = enclosingContract(declaration))
+				contracts.insert(contract);
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	_contract.accept(visitor);
+	return contracts;
+}
+
+/// @returns the calls to assert in @a _contract.
+vector<FunctionCall const*> assertions(ContractDefinition const& _contract)
+{
+	vector<FunctionCall const*> calls;
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) {
+			auto call = dynamic_cast<FunctionCall const*>(&_node);
+			if (call && call->annotation().kind == FunctionCallKind::FunctionCall)
+			{
+				auto type = dynamic_cast<FunctionType const*>(call->expression().annotation().type);
+				if (type && type->kind() == FunctionType::Kind::Assert)
+					calls.push_back(call);
+			}
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	_contract.accept(visitor);
+	return calls;
+}
+
+/// @returns the location of @a _node relative to the start of @a _contract.
+string relativeLocation(ContractDefinition const& _contract, ASTNode const& _node)
+{
+	int start = _contract.location().start;
+	return to_string(_node.location().start - start) + ":" + to_string(_node.location().end - start);
+}
+
+}
+
+CHC::CHC(
+	smt::EncodingContext& _context,
+	ErrorReporter& _errorReporter,
+	ModelCheckerSettings const& _settings,
+	SourceRegistry const* _sourceRegistry
+):
+	CHC(_context, _errorReporter, _settings, make_shared<smt::SolverBudget>(_settings))
+{
+	m_sourceRegistry = _sourceRegistry;
+}
+
+CHC::CHC(
+	smt::EncodingContext& _context,
+	ErrorReporter& _errorReporter,
+	ModelCheckerSettings const& _settings,
+	shared_ptr<smt::SolverBudget> _budget
+):
 	SMTEncoder(_context),
-#ifdef HAVE_Z3
-	m_interface(make_shared<smt::Z3CHCInterface>()),
-#endif
+	m_settings(_settings),
+	m_queryCache(_settings.queryCache),
+	m_budget(move(_budget)),
+	m_statistics(_settings.statistics),
 	m_outerErrorReporter(_errorReporter)
 {
+#ifdef HAVE_Z3
+	m_interface = make_shared<smt::Z3CHCInterface>(m_budget);
+#endif
 }
 
 void CHC::analyze(SourceUnit const& _source, shared_ptr<Scanner> const& _scanner)
@@ -44,16 +146,178 @@ void CHC::analyze(SourceUnit const& _source, shared_ptr<Scanner> const& _scanner
 	solAssert(_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker), "");
 
 	m_scanner = _scanner;
+	m_safeAssertions.clear();
 
 #ifdef HAVE_Z3
-	auto z3Interface = dynamic_pointer_cast<smt::Z3CHCInterface>(m_interface);
-	solAssert(z3Interface, "");
-	m_context.setSolver(z3Interface->z3Interface());
-	m_context.clear();
-	m_variableUsage.setFunctionInlining(false);
+	vector<unique_ptr<ContractAnalysis>> analyses;
+	for (auto contract: ASTNode::filteredNodes<ContractDefinition>(_source.nodes()))
+	{
+		if (!shouldVisit(*contract))
+			continue;
+		boost::optional<h256> key = analysisKey(*contract);
+		if (key && loadAnalysis(*contract, *key))
+			continue;
+		analyses.push_back(encodeContract(*contract));
+		analyses.back()->cacheKey = key;
+	}
 
-	_source.accept(*this);
+	solveConcurrently(analyses);
+
+	for (auto& analysis: analyses)
+		mergeAnalysis(*analysis);
+#endif
+}
+
+unique_ptr<CHC::ContractAnalysis> CHC::encodeContract(ContractDefinition const& _contract)
+{
+	// The engines are created and encode their contracts one after the other, since the
+	// solver parameters and the types created during the encoding are global.
+	auto analysis = make_unique<ContractAnalysis>();
+	analysis->contract = &_contract;
+	analysis->errorReporter = make_unique<ErrorReporter>(analysis->errors);
+	analysis->context = make_unique<smt::EncodingContext>();
+
+	ModelCheckerSettings settings = m_settings;
+	if (m_statistics)
+		settings.statistics = make_shared<smt::ModelCheckerStatistics>();
+	analysis->engine.reset(new CHC(*analysis->context, *analysis->errorReporter, settings, m_budget));
+
+	CHC& engine = *analysis->engine;
+	engine.m_scanner = m_scanner;
+#ifdef HAVE_Z3
+	auto z3Interface = dynamic_pointer_cast<smt::Z3CHCInterface>(engine.m_interface);
+	solAssert(z3Interface, "");
+	engine.m_context.setSolver(z3Interface->z3Interface());
 #endif
+	engine.m_context.clear();
+	engine.m_variableUsage.setFunctionInlining(false);
+
+	_contract.accept(engine);
+	return analysis;
+}
+
+void CHC::solveConcurrently(vector<unique_ptr<ContractAnalysis>>& _analyses)
+{
+	auto solve = [](ContractAnalysis& _analysis) {
+		try
+		{
+			_analysis.engine->answerQueries();
+		}
+		catch (...)
+		{
+			_analysis.exception = current_exception();
+		}
+	};
+
+	size_t threadCount = min<size_t>(m_settings.threads, _analyses.size());
+	if (threadCount <= 1)
+	{
+		for (auto& analysis: _analyses)
+			solve(*analysis);
+		return;
+	}
+
+	atomic<size_t> nextAnalysis{0};
+	vector<thread> threads;
+	for (size_t i = 0; i < threadCount; ++i)
+		threads.emplace_back([&]() {
+			for (size_t analysis = nextAnalysis++; analysis < _analyses.size(); analysis = nextAnalysis++)
+				solve(*_analyses[analysis]);
+		});
+	for (auto& thread: threads)
+		thread.join();
+}
+
+void CHC::mergeAnalysis(ContractAnalysis& _analysis)
+{
+	if (_analysis.exception)
+		rethrow_exception(_analysis.exception);
+
+	CHC const& engine = *_analysis.engine;
+	m_safeAssertions += engine.m_safeAssertions;
+	m_outerErrorReporter.merge(_analysis.errors);
+	if (m_statistics)
+		m_statistics->targets += engine.m_statistics->targets;
+
+	// Without errors, the safe assertions only depend on the key, unless the answers of the
+	// solver depend on the resources spent by the analyses of other contracts.
+	if (_analysis.cacheKey && _analysis.errors.empty() && !m_budget->limitsAllQueries())
+		storeAnalysis(*_analysis.contract, *_analysis.cacheKey, engine.m_safeAssertions);
+}
+
+boost::optional<h256> CHC::analysisKey(ContractDefinition const& _contract) const
+{
+	if (!m_queryCache || !m_sourceRegistry || !m_interface)
+		return {};
+
+	// The contract itself comes first, followed by the contracts it refers to, directly or
+	// indirectly, ordered by their position in the sources.
+	set<ContractDefinition const*> contracts{&_contract};
+	vector<ContractDefinition const*> pending{&_contract};
+	while (!pending.empty())
+	{
+		ContractDefinition const* contract = pending.back();
+		pending.pop_back();
+		for (auto referenced: referencedContracts(*contract))
+			if (contracts.insert(referenced).second)
+				pending.push_back(referenced);
+	}
+	contracts.erase(&_contract);
+	vector<ContractDefinition const*> ordered(contracts.begin(), contracts.end());
+	sort(ordered.begin(), ordered.end(), [&](ContractDefinition const* _a, ContractDefinition const* _b) {
+		return
+			make_pair(m_sourceRegistry->name(_a->location().sourceId), _a->location().start) <
+			make_pair(m_sourceRegistry->name(_b->location().sourceId), _b->location().start);
+	});
+	ordered.insert(ordered.begin(), &_contract);
+
+	string text = VersionStringStrict + "\n";
+	for (auto contract: ordered)
+	{
+		CharStream const* stream = m_sourceRegistry->charStream(contract->location());
+		if (!stream || contract->location().start < 0 || contract->location().end < contract->location().start)
+			return {};
+		text += m_sourceRegistry->name(contract->location().sourceId) + "\n";
+		// Pragmas enable or disable features of the analysis.
+		if (auto sourceUnit = dynamic_cast<SourceUnit const*>(contract->scope()))
+			for (auto pragma: ASTNode::filteredNodes<PragmaDirective>(sourceUnit->nodes()))
+				text += stream->source().substr(
+					size_t(pragma->location().start),
+					size_t(pragma->location().end - pragma->location().start)
+				) + "\n";
+		text += stream->source().substr(
+			size_t(contract->location().start),
+			size_t(contract->location().end - contract->location().start)
+		) + "\n";
+	}
+	return smt::SMTQueryCache::key(m_interface->identity() + ", contract analysis", text);
+}
+
+bool CHC::loadAnalysis(ContractDefinition const& _contract, h256 const& _key)
+{
+	auto answer = m_queryCache->lookup(_key);
+	if (!answer || answer->first != smt::CheckResult::UNSATISFIABLE)
+		return false;
+
+	set<string> safeLocations(answer->second.begin(), answer->second.end());
+	for (auto assertion: assertions(_contract))
+		if (safeLocations.count(relativeLocation(_contract, *assertion)))
+			m_safeAssertions.insert(assertion);
+	return true;
+}
+
+void CHC::storeAnalysis(
+	ContractDefinition const& _contract,
+	h256 const& _key,
+	set<Expression const*> const& _safeAssertions
+)
+{
+	// The answer is only a marker, the values are the locations of the safe assertions.
+	vector<string> safeLocations;
+	for (auto assertion: _safeAssertions)
+		safeLocations.push_back(relativeLocation(_contract, *assertion));
+	sort(safeLocations.begin(), safeLocations.end());
+	m_queryCache->store(_key, {smt::CheckResult::UNSATISFIABLE, safeLocations});
 }
 
 bool CHC::visit(ContractDefinition const& _contract)
@@ -131,6 +395,7 @@ void CHC::visitAssert(FunctionCall const&)
 void CHC::reset()
 {
 	m_verificationTargets.clear();
+	m_targetQueries.clear();
 	m_safeAssertions.clear();
 }
 
@@ -154,11 +419,52 @@ bool CHC::shouldVisit(FunctionDefinition const& _function) const
 	return false;
 }
 
+void CHC::answerQueries()
+{
+	for (auto const& targetQuery: m_targetQueries)
+		if (query(targetQuery.query, targetQuery.target->location()))
+			m_safeAssertions.insert(targetQuery.target);
+	m_targetQueries.clear();
+}
+
 bool CHC::query(smt::Expression const& _query, langutil::SourceLocation const& _location)
 {
+	auto start = chrono::steady_clock::now();
 	smt::CheckResult result;
 	vector<string> values;
-	tie(result, values) = m_interface->query(_query);
+	string queryText = m_queryCache ? m_interface->smtlib2Query(_query) : string();
+	h256 cacheKey;
+	boost::optional<smt::SMTQueryCache::Answer> cachedAnswer;
+	if (!queryText.empty())
+	{
+		cacheKey = smt::SMTQueryCache::key(m_interface->identity(), queryText);
+		cachedAnswer = m_queryCache->lookup(cacheKey);
+	}
+	if (cachedAnswer)
+		tie(result, values) = *cachedAnswer;
+	else
+	{
+		tie(result, values) = m_interface->query(_query);
+		if (!queryText.empty() && (result != smt::CheckResult::UNKNOWN || !m_budget->limitsAllQueries()))
+			m_queryCache->store(cacheKey, {result, values});
+	}
+	if (m_statistics)
+	{
+		string answeredBy;
+		if (cachedAnswer)
+			answeredBy = "cache";
+		else if (result == smt::CheckResult::SATISFIABLE || result == smt::CheckResult::UNSATISFIABLE)
+			answeredBy = "Z3";
+		m_statistics->targets.push_back({
+			"CHC",
+			_location,
+			"Assertion violation",
+			result,
+			answeredBy,
+			chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start),
+			smt::expressionSize(_query)
+		});
+	}
 	switch (result)
 	{
 	case smt::CheckResult::SATISFIABLE:
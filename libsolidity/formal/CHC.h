@@ -33,7 +33,20 @@
 #include <libsolidity/formal/SMTEncoder.h>
 
 #include <libsolidity/formal/CHCSolverInterface.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/formal/SolverBudget.h>
 
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/SourceRegistry.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/optional.hpp>
+
+#include <exception>
+#include <memory>
 #include <set>
 
 namespace dev
@@ -44,13 +57,67 @@ namespace solidity
 class CHC: public SMTEncoder
 {
 public:
-	CHC(smt::EncodingContext& _context, langutil::ErrorReporter& _errorReporter);
-
+	CHC(
+		smt::EncodingContext& _context,
+		langutil::ErrorReporter& _errorReporter,
+		ModelCheckerSettings const& _settings = ModelCheckerSettings{},
+		langutil::SourceRegistry const* _sourceRegistry = nullptr
+	);
+
+	/// Analyzes the contracts of @a _sources, each one by its own engine. The contracts are encoded
+	/// one after the other, but up to `threads` of them are solved concurrently.
+	/// If the settings contain a query cache and a source registry was given to the constructor, the
+	/// assertions proven safe are stored per contract and reused as long as the source code of
+	/// the contract, of the contracts it refers to and of their pragmas does not change.
 	void analyze(SourceUnit const& _sources, std::shared_ptr<langutil::Scanner> const& _scanner);
 
 	std::set<Expression const*> const& safeAssertions() const { return m_safeAssertions; }
 
 private:
+	/// Analysis of a single contract by its own engine, which has its own solver and reports its
+	/// errors and statistics separately, such that several analyses can be solved concurrently.
+	struct ContractAnalysis
+	{
+		ContractDefinition const* contract = nullptr;
+		/// Key of the analysis in the query cache, if it can be cached.
+		boost::optional<h256> cacheKey;
+		langutil::ErrorList errors;
+		std::unique_ptr<langutil::ErrorReporter> errorReporter;
+		std::unique_ptr<smt::EncodingContext> context;
+		std::unique_ptr<CHC> engine;
+		std::exception_ptr exception;
+	};
+
+	/// Creates an engine for a single contract that shares the budget @a _budget.
+	CHC(
+		smt::EncodingContext& _context,
+		langutil::ErrorReporter& _errorReporter,
+		ModelCheckerSettings const& _settings,
+		std::shared_ptr<smt::SolverBudget> _budget
+	);
+
+	/// Creates the engine of the analysis of @a _contract and encodes the contract.
+	std::unique_ptr<ContractAnalysis> encodeContract(ContractDefinition const& _contract);
+	/// Answers the queries of the engines of @a _analyses, up to `threads` engines at once.
+	void solveConcurrently(std::vector<std::unique_ptr<ContractAnalysis>>& _analyses);
+	/// Merges the results of @a _analysis into the results of this engine and stores them in the
+	/// query cache.
+	void mergeAnalysis(ContractAnalysis& _analysis);
+
+	/// @returns the key of the analysis of @a _contract in the query cache, or nothing if it cannot
+	/// be cached.
+	boost::optional<h256> analysisKey(ContractDefinition const& _contract) const;
+	/// Adds the assertions of @a _contract that were proven safe by a previous analysis stored
+	/// under @a _key to the safe assertions.
+	/// @returns false if there is no such analysis.
+	bool loadAnalysis(ContractDefinition const& _contract, h256 const& _key);
+	/// Stores the assertions @a _safeAssertions of @a _contract under @a _key.
+	void storeAnalysis(
+		ContractDefinition const& _contract,
+		h256 const& _key,
+		std::set<Expression const*> const& _safeAssertions
+	);
+
 	/// Visitor functions.
 	//@{
 	bool visit(ContractDefinition const& _node) override;
@@ -72,6 +139,8 @@ private:
 
 	/// Solver related.
 	//@{
+	/// Answers the queries of m_targetQueries and adds the safe assertions to m_safeAssertions.
+	void answerQueries();
 	/// @returns true if query is unsatisfiable (safe).
 	bool query(smt::Expression const& _query, langutil::SourceLocation const& _location);
 	//@}
@@ -80,6 +149,15 @@ private:
 	//@{
 	std::vector<Expression const*> m_verificationTargets;
 
+	/// Query whether a verification target can be violated.
+	struct TargetQuery
+	{
+		Expression const* target;
+		smt::Expression query;
+	};
+	/// Queries of the verification targets, answered after the contract is encoded.
+	std::vector<TargetQuery> m_targetQueries;
+
 	/// Assertions proven safe.
 	std::set<Expression const*> m_safeAssertions;
 	//@}
@@ -92,6 +170,21 @@ private:
 	/// CHC solver.
 	std::shared_ptr<smt::CHCSolverInterface> m_interface;
 
+	/// Settings the engines of the contracts are created with.
+	ModelCheckerSettings m_settings;
+
+	/// Answers of previous queries and analyses, or null.
+	std::shared_ptr<smt::SMTQueryCache> m_queryCache;
+
+	/// Sources of the contracts, used to identify the analyses in the query cache, or null.
+	langutil::SourceRegistry const* m_sourceRegistry = nullptr;
+
+	/// Limits of the queries of the CHC solver.
+	std::shared_ptr<smt::SolverBudget> m_budget;
+
+	/// Statistics about the verification targets, or null.
+	std::shared_ptr<smt::ModelCheckerStatistics> m_statistics;
+
 	/// ErrorReporter that comes from CompilerStack.
 	langutil::ErrorReporter& m_outerErrorReporter;
 };
@@ -49,6 +49,13 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>> query(
 		Expression const& _expr
 	) = 0;
+
+	/// @returns the rules and the query @a _expr in SMT-LIB2 format,
+	/// or an empty string if they cannot be printed.
+	virtual std::string smtlib2Query(Expression const& _expr) = 0;
+
+	/// @returns the name and version of the solver and the options that influence its answers.
+	virtual std::string identity() const = 0;
 };
 
 }
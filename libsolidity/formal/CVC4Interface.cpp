@@ -20,11 +20,14 @@
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
 
-CVC4Interface::CVC4Interface():
+CVC4Interface::CVC4Interface(shared_ptr<SolverBudget> _budget):
+	m_budget(move(_budget)),
 	m_solver(&m_context)
 {
 	reset();
@@ -35,7 +38,6 @@ void CVC4Interface::reset()
 	m_variables.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
-	m_solver.setTimeLimit(queryTimeout);
 }
 
 void CVC4Interface::push()
@@ -80,11 +82,21 @@ void CVC4Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	boost::optional<SolverBudget::QueryLimits> limits = m_budget->nextQuery();
+	if (!limits)
+		return make_pair(CheckResult::UNKNOWN, vector<string>{});
+
 	CheckResult result;
 	vector<string> values;
 	try
 	{
-		switch (m_solver.checkSat().isSat())
+		// Zero means unlimited and the limits apply to the next query only.
+		m_solver.setResourceLimit(limits->resources, false);
+		m_solver.setTimeLimit(limits->milliseconds, false);
+		unsigned long resourcesBefore = m_solver.getResourceUsage();
+		CVC4::Result::Sat cvc4Result = m_solver.checkSat().isSat();
+		m_budget->spend(m_solver.getResourceUsage() - resourcesBefore);
+		switch (cvc4Result)
 		{
 		case CVC4::Result::SAT:
 			result = CheckResult::SATISFIABLE;
@@ -114,6 +126,16 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	m_solver.interrupt();
+}
+
+string CVC4Interface::identity() const
+{
+	return "CVC4 " + CVC4::Configuration::getVersionString() + ", " + m_budget->identity();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
@@ -17,9 +17,12 @@
 
 #pragma once
 
+#include <libsolidity/formal/SolverBudget.h>
 #include <libsolidity/formal/SolverInterface.h>
 #include <boost/noncopyable.hpp>
 
+#include <memory>
+
 #if defined(__GLIBC__)
 // The CVC4 headers includes the deprecated system headers <ext/hash_map>
 // and <ext/hash_set>. These headers cause a warning that will break the
@@ -43,7 +46,7 @@ namespace smt
 class CVC4Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	CVC4Interface();
+	explicit CVC4Interface(std::shared_ptr<SolverBudget> _budget = std::make_shared<SolverBudget>());
 
 	void reset() override;
 
@@ -54,12 +57,17 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	std::string identity() const override;
+	std::string answeredBy() const override { return "CVC4"; }
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
 	CVC4::Type cvc4Sort(smt::Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<smt::SortPointer> const& _sorts);
 
+	std::shared_ptr<SolverBudget> m_budget;
+
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
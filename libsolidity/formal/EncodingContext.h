@@ -48,16 +48,24 @@ public:
 
 	/// Sets the current solver used by the current engine for
 	/// SMT variable declaration.
-	void setSolver(std::shared_ptr<SolverInterface> _solver)
+	/// The additional solvers receive the same variable declarations, such that
+	/// the engine can use them to check verification targets concurrently.
+	void setSolver(
+		std::shared_ptr<SolverInterface> _solver,
+		std::vector<std::shared_ptr<SolverInterface>> _additionalSolvers = {}
+	)
 	{
 		solAssert(_solver, "");
 		m_solver = _solver;
+		m_additionalSolvers = std::move(_additionalSolvers);
 	}
 
-	/// Forwards variable creation to the solver.
+	/// Forwards variable creation to the solvers.
 	Expression newVariable(std::string _name, SortPointer _sort)
 	{
-		solAssert(m_solver, "");
+		solAssert(m_solver && _sort, "");
+		for (auto const& solver: m_additionalSolvers)
+			solver->declareVariable(_name, *_sort);
 		return m_solver->newVariable(move(_name), move(_sort));
 	}
 
@@ -141,6 +149,14 @@ public:
 	void pushSolver();
 	void popSolver();
 	void addAssertion(Expression const& _e);
+	/// Replaces all assertions by @a _assertions, such that a part of the program can be
+	/// encoded separately.
+	/// @returns the replaced assertions.
+	std::vector<Expression> swapAssertions(std::vector<Expression> _assertions)
+	{
+		std::swap(m_assertions, _assertions);
+		return _assertions;
+	}
 	std::shared_ptr<SolverInterface> solver()
 	{
 		solAssert(m_solver, "");
@@ -175,6 +191,7 @@ private:
 	//@{
 	/// Solver can be SMT solver or Horn solver in the future.
 	std::shared_ptr<SolverInterface> m_solver;
+	std::vector<std::shared_ptr<SolverInterface>> m_additionalSolvers;
 
 	/// Assertion stack.
 	std::vector<Expression> m_assertions;
@@ -22,9 +22,14 @@ using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-ModelChecker::ModelChecker(ErrorReporter& _errorReporter, map<h256, string> const& _smtlib2Responses):
-	m_bmc(m_context, _errorReporter, _smtlib2Responses),
-	m_chc(m_context, _errorReporter),
+ModelChecker::ModelChecker(
+	ErrorReporter& _errorReporter,
+	map<h256, string> const& _smtlib2Responses,
+	ModelCheckerSettings const& _settings,
+	SourceRegistry const* _sourceRegistry
+):
+	m_bmc(m_context, _errorReporter, _smtlib2Responses, _settings),
+	m_chc(m_context, _errorReporter, _settings, _sourceRegistry),
 	m_context()
 {
 }
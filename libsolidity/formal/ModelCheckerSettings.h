@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Settings of the model checking engines.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+class SMTQueryCache;
+struct ModelCheckerStatistics;
+
+/// How the SMTPortfolio queries the solvers it wraps.
+enum class PortfolioMode
+{
+	/// Queries the solvers one after the other and combines their answers.
+	Sequential,
+	/// Queries all solvers concurrently and returns the first SAT or UNSAT answer,
+	/// interrupting the other solvers.
+	FirstAnswer,
+	/// Queries all solvers concurrently and combines their answers like Sequential.
+	AllAnswers
+};
+
+}
+
+struct ModelCheckerSettings
+{
+	smt::PortfolioMode portfolio = smt::PortfolioMode::Sequential;
+	/// Number of solver instances the engines use to check verification targets concurrently.
+	unsigned threads = 1;
+	/// Answers of the solvers that are reused across queries and compilations, or null.
+	std::shared_ptr<smt::SMTQueryCache> queryCache;
+	/// Resources the solvers may spend on each query, which replaces the time limit of each query.
+	boost::optional<unsigned> queryResourceLimit;
+	/// Resources the solvers of each engine may spend on all queries.
+	boost::optional<std::uint64_t> totalResourceLimit;
+	/// Time in milliseconds each engine may spend on all queries.
+	boost::optional<unsigned> timeBudget;
+	/// Command line of an SMT solver that reads SMT-LIB2 from its standard input, which the BMC engine
+	/// queries through a process that is kept running, or empty.
+	std::string solverCommand;
+	/// Statistics about the verification targets, only collected if not null.
+	std::shared_ptr<smt::ModelCheckerStatistics> statistics;
+
+	static boost::optional<smt::PortfolioMode> portfolioFromString(std::string const& _mode)
+	{
+		if (_mode == "sequential")
+			return smt::PortfolioMode::Sequential;
+		else if (_mode == "first")
+			return smt::PortfolioMode::FirstAnswer;
+		else if (_mode == "all")
+			return smt::PortfolioMode::AllAnswers;
+		return {};
+	}
+};
+
+}
+}
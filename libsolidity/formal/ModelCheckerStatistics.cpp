@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/ModelCheckerStatistics.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+size_t smt::expressionSize(Expression const& _expr)
+{
+	// Conjunctions of assertions are nested very deeply, hence no recursion.
+	size_t size = 0;
+	vector<Expression const*> pending{&_expr};
+	while (!pending.empty())
+	{
+		Expression const* expr = pending.back();
+		pending.pop_back();
+		++size;
+		for (auto const& argument: expr->arguments)
+			pending.push_back(&argument);
+	}
+	return size;
+}
+
+string smt::checkResultName(CheckResult _result)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
+		return "sat";
+	case CheckResult::UNSATISFIABLE:
+		return "unsat";
+	case CheckResult::UNKNOWN:
+		return "unknown";
+	case CheckResult::CONFLICTING:
+		return "conflicting";
+	case CheckResult::ERROR:
+		return "error";
+	}
+	solAssert(false, "");
+	return {};
+}
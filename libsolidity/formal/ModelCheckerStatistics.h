@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Statistics about the verification targets checked by the model checking engines.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+struct TargetStatistics
+{
+	/// "BMC" or "CHC".
+	std::string engine;
+	langutil::SourceLocation location;
+	/// The property that was checked, e.g. "Assertion violation".
+	std::string description;
+	/// Answer to the query whether the property can be violated.
+	CheckResult result;
+	/// Solvers that answered the query, "cache" if it was answered by the query cache or empty
+	/// if no solver answered.
+	std::string solver;
+	std::chrono::milliseconds solveTime;
+	/// Number of nodes of the query expression.
+	std::size_t querySize;
+};
+
+/// Collects the statistics of the engines. Only used by the thread running the engines.
+struct ModelCheckerStatistics
+{
+	std::vector<TargetStatistics> targets;
+};
+
+/// @returns the number of nodes of @a _expr.
+std::size_t expressionSize(Expression const& _expr);
+
+/// @returns "sat", "unsat", "unknown", "conflicting" or "error".
+std::string checkResultName(CheckResult _result);
+
+}
+}
+}
@@ -17,12 +17,16 @@
 
 #include <libsolidity/formal/SMTLib2Interface.h>
 
+#include <libsolidity/formal/SolverProcess.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem/operations.hpp>
 
 #include <array>
@@ -37,17 +41,37 @@ using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTLib2Interface::SMTLib2Interface(map<h256, string> const& _queryResponses):
-	m_queryResponses(_queryResponses)
+SMTLib2Interface::SMTLib2Interface(map<h256, string> const& _queryResponses, string _solverCommand):
+	m_queryResponses(_queryResponses),
+	m_solverCommand(move(_solverCommand))
 {
+	if (!m_solverCommand.empty())
+		try
+		{
+			m_solver = make_unique<SolverProcess>(m_solverCommand);
+			// The answers depend on the version of the solver, which is part of the identity.
+			string info = m_solver->query("(get-info :name)\n(get-info :version)\n");
+			boost::algorithm::replace_all(info, "\n", " ");
+			boost::algorithm::trim(info);
+			m_identity = m_solverCommand + " " + info;
+		}
+		catch (SolverError const& _error)
+		{
+			solverFailed(_error);
+		}
 	reset();
 }
 
+SMTLib2Interface::~SMTLib2Interface() = default;
+
 void SMTLib2Interface::reset()
 {
 	m_accumulatedOutput.clear();
 	m_accumulatedOutput.emplace_back();
 	m_variables.clear();
+	m_scopeVariables.clear();
+	m_scopeVariables.emplace_back();
+	stream("(reset)\n");
 	write("(set-option :produce-models true)");
 	write("(set-logic QF_UFLIA)");
 }
@@ -55,12 +79,18 @@ void SMTLib2Interface::reset()
 void SMTLib2Interface::push()
 {
 	m_accumulatedOutput.emplace_back();
+	m_scopeVariables.emplace_back();
+	stream("(push 1)\n");
 }
 
 void SMTLib2Interface::pop()
 {
 	solAssert(!m_accumulatedOutput.empty(), "");
 	m_accumulatedOutput.pop_back();
+	for (auto const& name: m_scopeVariables.back())
+		m_variables.erase(name);
+	m_scopeVariables.pop_back();
+	stream("(pop 1)\n");
 }
 
 void SMTLib2Interface::declareVariable(string const& _name, Sort const& _sort)
@@ -70,6 +100,7 @@ void SMTLib2Interface::declareVariable(string const& _name, Sort const& _sort)
 	else if (!m_variables.count(_name))
 	{
 		m_variables.insert(_name);
+		m_scopeVariables.back().push_back(_name);
 		write("(declare-fun |" + _name + "| () " + toSmtLibSort(_sort) + ')');
 	}
 }
@@ -84,6 +115,7 @@ void SMTLib2Interface::declareFunction(string const& _name, Sort const& _sort)
 		string domain = toSmtLibSort(fSort.domain);
 		string codomain = toSmtLibSort(*fSort.codomain);
 		m_variables.insert(_name);
+		m_scopeVariables.back().push_back(_name);
 		write(
 			"(declare-fun |" +
 			_name +
@@ -103,10 +135,10 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string response =
+		m_solverCommand.empty() ?
+		querySolver(smtlib2Query(_expressionsToEvaluate)) :
+		queryProcess(_expressionsToEvaluate);
 
 	CheckResult result;
 	// TODO proper parsing
@@ -125,6 +157,13 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 	return make_pair(result, values);
 }
 
+string SMTLib2Interface::smtlib2Query(vector<Expression> const& _expressionsToEvaluate) const
+{
+	return
+		boost::algorithm::join(m_accumulatedOutput, "\n") +
+		checkSatAndGetValuesCommand(_expressionsToEvaluate);
+}
+
 string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
 	if (_expr.arguments.empty())
@@ -166,9 +205,37 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 void SMTLib2Interface::write(string _data)
 {
 	solAssert(!m_accumulatedOutput.empty(), "");
+	stream(_data + "\n");
 	m_accumulatedOutput.back() += move(_data) + "\n";
 }
 
+void SMTLib2Interface::stream(string const& _commands)
+{
+	if (!m_solver)
+		return;
+	try
+	{
+		m_solver->send(_commands);
+	}
+	catch (SolverError const& _error)
+	{
+		solverFailed(_error);
+	}
+}
+
+void SMTLib2Interface::solverFailed(SolverError const& _error)
+{
+	m_solver.reset();
+	m_solverError = _error.comment() ? *_error.comment() : "SMT solver \"" + m_solverCommand + "\" failed.";
+}
+
+string SMTLib2Interface::answeredBy() const
+{
+	if (m_solverCommand.empty())
+		return "SMT-LIB2";
+	return m_solverCommand.substr(0, m_solverCommand.find(' '));
+}
+
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
 {
 	string command;
@@ -176,21 +243,34 @@ string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _
 		command = "(check-sat)\n";
 	else
 	{
-		// TODO make sure these are unique
-		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
-		{
-			auto const& e = _expressionsToEvaluate.at(i);
-			solAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
-			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
-			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
-		}
+		command += evaluationConstants(_expressionsToEvaluate);
 		command += "(check-sat)\n";
-		command += "(get-value (";
-		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
-			command += "|EVALEXPR_" + to_string(i) + "| ";
-		command += "))\n";
+		command += getValuesCommand(_expressionsToEvaluate);
+	}
+
+	return command;
+}
+
+string SMTLib2Interface::evaluationConstants(vector<Expression> const& _expressionsToEvaluate)
+{
+	string command;
+	// TODO make sure these are unique
+	for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
+	{
+		auto const& e = _expressionsToEvaluate.at(i);
+		solAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
+		command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
+		command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
 	}
+	return command;
+}
 
+string SMTLib2Interface::getValuesCommand(vector<Expression> const& _expressionsToEvaluate)
+{
+	string command = "(get-value (";
+	for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
+		command += "|EVALEXPR_" + to_string(i) + "| ";
+	command += "))\n";
 	return command;
 }
 
@@ -221,3 +301,51 @@ string SMTLib2Interface::querySolver(string const& _input)
 		return "unknown\n";
 	}
 }
+
+string SMTLib2Interface::queryProcess(vector<Expression> const& _expressionsToEvaluate)
+{
+	if (!m_solver)
+	{
+		// The failure is only reported once, the following queries are answered with an error.
+		if (m_solverError.empty())
+			return "error\n";
+		string error;
+		swap(error, m_solverError);
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment(error));
+	}
+
+	// The constants to evaluate the expressions are declared in their own scope, which is popped
+	// after the query, such that the solver keeps the assertions and what it learned from them.
+	// The values are only requested if the query is satisfiable, since there is no model otherwise.
+	string commands = "(push 1)\n" + evaluationConstants(_expressionsToEvaluate) + "(check-sat)\n";
+
+	string result;
+	string values;
+	string error;
+	try
+	{
+		// The response also contains errors caused by the commands streamed since the last query.
+		vector<string> lines;
+		string response = m_solver->query(commands);
+		boost::algorithm::split(lines, response, boost::algorithm::is_any_of("\n"));
+		for (auto const& line: lines)
+			if (boost::starts_with(line, "(error"))
+				error = line;
+			else if (line == "sat" || line == "unsat" || line == "unknown")
+				result = line;
+		if (result == "sat" && error.empty() && !_expressionsToEvaluate.empty())
+			values = m_solver->query(getValuesCommand(_expressionsToEvaluate));
+		m_solver->send("(pop 1)\n");
+	}
+	catch (SolverError const& _error)
+	{
+		solverFailed(_error);
+		return queryProcess(_expressionsToEvaluate);
+	}
+
+	if (!error.empty())
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment(answeredBy() + ": " + error));
+	if (result.empty())
+		return "error\n";
+	return result + "\n" + values;
+}
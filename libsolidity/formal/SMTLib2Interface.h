@@ -27,6 +27,7 @@
 #include <boost/noncopyable.hpp>
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -38,10 +39,23 @@ namespace solidity
 namespace smt
 {
 
+class SolverProcess;
+
+/**
+ * Translates the queries to SMT-LIB2. The queries are either answered by the responses given
+ * in advance, keyed by the hash of the query, or streamed to a solver process incrementally
+ * as the assertions are added.
+ */
 class SMTLib2Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	explicit SMTLib2Interface(std::map<h256, std::string> const& _queryResponses);
+	/// @param _solverCommand command line of a solver that reads SMT-LIB2 from its standard input,
+	/// which is started once and queried instead of using @a _queryResponses, or empty.
+	explicit SMTLib2Interface(
+		std::map<h256, std::string> const& _queryResponses,
+		std::string _solverCommand = {}
+	);
+	~SMTLib2Interface() override;
 
 	void reset() override;
 
@@ -54,28 +68,56 @@ public:
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
+	/// @returns the solver command and the name and version the solver reports,
+	/// or an empty string if there is no solver process.
+	std::string identity() const override { return m_identity; }
+	std::string answeredBy() const override;
+
+	/// @returns the query that @a check sends to the solver.
+	std::string smtlib2Query(std::vector<Expression> const& _expressionsToEvaluate) const;
 
 private:
 	void declareFunction(std::string const&, Sort const&);
 
-	std::string toSExpr(Expression const& _expr);
-	std::string toSmtLibSort(Sort const& _sort);
-	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
+	static std::string toSExpr(Expression const& _expr);
+	static std::string toSmtLibSort(Sort const& _sort);
+	static std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
 
+	/// Adds @a _data to the query and sends it to the solver process, if there is one.
 	void write(std::string _data);
-
-	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
+	/// Sends @a _commands to the solver process, if there is one.
+	void stream(std::string const& _commands);
+	/// Stops using the solver process, reporting @a _error with the next query.
+	void solverFailed(SolverError const& _error);
+
+	static std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
+	/// @returns the declarations of the constants that are equal to @a _expressionsToEvaluate.
+	static std::string evaluationConstants(std::vector<Expression> const& _expressionsToEvaluate);
+	static std::string getValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
+	/// Sends the query to the solver process, in which the assertions were already added.
+	/// @returns the response in the same format as the responses given in advance.
+	/// Throws SolverError if the solver fails.
+	std::string queryProcess(std::vector<Expression> const& _expressionsToEvaluate);
 
 	std::vector<std::string> m_accumulatedOutput;
 	std::set<std::string> m_variables;
+	/// Variables declared in each element of @a m_accumulatedOutput, which are no longer
+	/// declared once it is popped.
+	std::vector<std::vector<std::string>> m_scopeVariables;
 
 	std::map<h256, std::string> const& m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
-};
+
+	std::string m_solverCommand;
+	/// Null if there is no solver command or if the solver failed.
+	std::unique_ptr<SolverProcess> m_solver;
+	/// Why the solver process failed, reported by the next query.
+	std::string m_solverError;
+	std::string m_identity;};
 
 }
 }
@@ -25,20 +25,50 @@
 #endif
 #include <libsolidity/formal/SMTLib2Interface.h>
 
+#include <boost/algorithm/string/join.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTPortfolio::SMTPortfolio(map<h256, string> const& _smtlib2Responses)
+SMTPortfolio::SMTPortfolio(
+	map<h256, string> const& _smtlib2Responses,
+	PortfolioMode _mode,
+	shared_ptr<SMTQueryCache> _queryCache,
+	shared_ptr<SolverBudget> _budget,
+	string _solverCommand
+):
+	m_mode(_mode),
+	m_queryCache(move(_queryCache)),
+	m_budget(move(_budget))
 {
-	m_solvers.emplace_back(make_unique<smt::SMTLib2Interface>(_smtlib2Responses));
+	m_solvers.emplace_back(make_unique<smt::SMTLib2Interface>(_smtlib2Responses, move(_solverCommand)));
 #ifdef HAVE_Z3
-	m_solvers.emplace_back(make_unique<smt::Z3Interface>());
+	m_solvers.emplace_back(make_unique<smt::Z3Interface>(m_budget));
 #endif
 #ifdef HAVE_CVC4
-	m_solvers.emplace_back(make_unique<smt::CVC4Interface>());
+	m_solvers.emplace_back(make_unique<smt::CVC4Interface>(m_budget));
 #endif
+
+	// Without responses, the SMT-LIB2 interface answers UNKNOWN to every query and
+	// only collects the queries, which is only needed if there is no other solver,
+	// unless it streams the queries to a solver process.
+	if (_smtlib2Responses.empty())
+	{
+		vector<string> identities;
+		for (auto const& solver: m_solvers)
+			if (!solver->identity().empty())
+				identities.push_back(solver->identity());
+		m_identity = boost::algorithm::join(identities, "; ");
+	}
 }
 
 void SMTPortfolio::reset()
@@ -100,33 +130,134 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If a query cache is used, the result is first looked up under the SMT-LIB2 text of the query
+ * and the identity of the solvers, and the solvers are only queried if it is not found.
+ * UNKNOWN is not stored if it might be due to the resources or the time spent by previous queries.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	CheckResult lastResult = CheckResult::ERROR;
-	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	bool useCache = m_queryCache && !m_identity.empty();
+	h256 cacheKey;
+	if (useCache)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		// This code assumes that the constructor guarantees that
+		// SmtLib2Interface is in position 0.
+		auto const& smtlib2Interface = dynamic_cast<smt::SMTLib2Interface const&>(*m_solvers.front());
+		cacheKey = SMTQueryCache::key(m_identity, smtlib2Interface.smtlib2Query(_expressionsToEvaluate));
+		if (auto answer = m_queryCache->lookup(cacheKey))
+		{
+			m_answeredBy = "cache";
+			return *answer;
+		}
+	}
+
+	Answer combined{CheckResult::ERROR, {}};
+	vector<string> answeredBy;
+	if (m_mode != PortfolioMode::Sequential && m_solvers.size() > 1)
+		combined = checkConcurrently(_expressionsToEvaluate, answeredBy);
+	else
+		for (auto const& s: m_solvers)
 		{
-			if (!solverAnswered(lastResult))
+			Answer answer = s->check(_expressionsToEvaluate);
+			if (solverAnswered(answer.first))
+				answeredBy.push_back(s->answeredBy());
+			if (!combine(combined, move(answer)))
+				break;
+		}
+	m_answeredBy = boost::algorithm::join(answeredBy, ", ");
+
+	if (useCache && (combined.first != CheckResult::UNKNOWN || !m_budget->limitsAllQueries()))
+		m_queryCache->store(cacheKey, combined);
+	return combined;
+}
+
+/*
+ * Runs the check of every solver on its own thread. The solvers do not share any state,
+ * and the expressions to evaluate are only read.
+ *
+ * In the mode FirstAnswer, the first SAT or UNSAT answer is returned and the solvers that
+ * are still running are interrupted. Since an interrupt is lost if it arrives before
+ * the solver started its check, they are interrupted repeatedly until they return.
+ * If no solver answers the query, the results are combined as above.
+ *
+ * In the mode AllAnswers, the results are combined in the order of the solvers as above,
+ * such that the result is the same as in the mode Sequential.
+ *
+ * In both modes, all threads are joined before returning and an exception thrown by a solver
+ * is rethrown.
+ */
+SMTPortfolio::Answer SMTPortfolio::checkConcurrently(
+	vector<Expression> const& _expressionsToEvaluate,
+	vector<string>& _answeredBy
+)
+{
+	vector<Answer> answers(m_solvers.size());
+	vector<exception_ptr> exceptions(m_solvers.size());
+	vector<bool> done(m_solvers.size(), false);
+	size_t firstAnswer = m_solvers.size();
+	mutex answersMutex;
+	condition_variable answered;
+
+	vector<thread> threads;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		threads.emplace_back([&, i]() {
+			Answer answer;
+			exception_ptr exception;
+			try
 			{
-				lastResult = result;
-				finalValues = std::move(values);
+				answer = m_solvers[i]->check(_expressionsToEvaluate);
 			}
-			else if (lastResult != result)
+			catch (...)
 			{
-				lastResult = CheckResult::CONFLICTING;
-				break;
+				exception = current_exception();
+			}
+
+			lock_guard<mutex> lock(answersMutex);
+			if (!exception && solverAnswered(answer.first) && firstAnswer == m_solvers.size())
+				firstAnswer = i;
+			answers[i] = move(answer);
+			exceptions[i] = exception;
+			done[i] = true;
+			answered.notify_all();
+		});
+
+	{
+		unique_lock<mutex> lock(answersMutex);
+		auto allDone = [&]() { return find(done.begin(), done.end(), false) == done.end(); };
+		if (m_mode == PortfolioMode::FirstAnswer)
+		{
+			answered.wait(lock, [&]() { return firstAnswer < m_solvers.size() || allDone(); });
+			while (!allDone())
+			{
+				for (size_t i = 0; i < m_solvers.size(); ++i)
+					if (!done[i])
+						m_solvers[i]->interrupt();
+				answered.wait_for(lock, chrono::milliseconds(10));
 			}
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
-			lastResult = result;
+		else
+			answered.wait(lock, allDone);
 	}
-	return make_pair(lastResult, finalValues);
+	for (auto& t: threads)
+		t.join();
+
+	for (auto const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		if (solverAnswered(answers[i].first))
+			_answeredBy.push_back(m_solvers[i]->answeredBy());
+
+	if (m_mode == PortfolioMode::FirstAnswer && firstAnswer < m_solvers.size())
+		return move(answers[firstAnswer]);
+
+	Answer combined{CheckResult::ERROR, {}};
+	for (auto& answer: answers)
+		if (!combine(combined, move(answer)))
+			break;
+	return combined;
 }
 
 vector<string> SMTPortfolio::unhandledQueries()
@@ -142,3 +273,20 @@ bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
 }
+
+bool SMTPortfolio::combine(Answer& _combined, Answer _answer)
+{
+	if (solverAnswered(_answer.first))
+	{
+		if (!solverAnswered(_combined.first))
+			_combined = move(_answer);
+		else if (_combined.first != _answer.first)
+		{
+			_combined.first = CheckResult::CONFLICTING;
+			return false;
+		}
+	}
+	else if (_answer.first == CheckResult::UNKNOWN && _combined.first == CheckResult::ERROR)
+		_combined.first = _answer.first;
+	return true;
+}
@@ -18,12 +18,17 @@
 #pragma once
 
 
+#include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/formal/SolverBudget.h>
 #include <libsolidity/formal/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libdevcore/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace dev
@@ -38,11 +43,19 @@ namespace smt
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * Depending on the mode, the solvers are queried one after the other
+ * or concurrently, each on its own thread.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
 public:
-	SMTPortfolio(std::map<h256, std::string> const& _smtlib2Responses);
+	SMTPortfolio(
+		std::map<h256, std::string> const& _smtlib2Responses,
+		PortfolioMode _mode = PortfolioMode::Sequential,
+		std::shared_ptr<SMTQueryCache> _queryCache = nullptr,
+		std::shared_ptr<SolverBudget> _budget = std::make_shared<SolverBudget>(),
+		std::string _solverCommand = {}
+	);
 
 	void reset() override;
 
@@ -57,10 +70,30 @@ public:
 
 	std::vector<std::string> unhandledQueries() override;
 	unsigned solvers() override { return m_solvers.size(); }
+	std::string identity() const override { return m_identity; }
+	/// @returns the names of the solvers that answered the last query with SAT or UNSAT,
+	/// "cache" if it was answered by the query cache.
+	std::string answeredBy() const override { return m_answeredBy; }
 private:
+	using Answer = std::pair<CheckResult, std::vector<std::string>>;
+
+	/// Queries all solvers concurrently and waits until the answers satisfy the mode.
+	/// Adds the names of the solvers that answered to @a _answeredBy.
+	Answer checkConcurrently(std::vector<Expression> const& _expressionsToEvaluate, std::vector<std::string>& _answeredBy);
+
 	static bool solverAnswered(CheckResult result);
+	/// Adds the answer of a solver to @a _combined, the combined answer of the previous solvers.
+	/// @returns false if the answers are conflicting.
+	static bool combine(Answer& _combined, Answer _answer);
 
 	std::vector<std::unique_ptr<smt::SolverInterface>> m_solvers;
+	PortfolioMode m_mode;
+	/// Answers of previous queries, or null.
+	std::shared_ptr<SMTQueryCache> m_queryCache;
+	/// Identity of the solvers whose answers are combined, empty if the answers must not be cached.
+	std::string m_identity;
+	std::shared_ptr<SolverBudget> m_budget;
+	std::string m_answeredBy;
 
 	std::vector<Expression> m_assertions;
 };
@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+map<CheckResult, string> const c_resultNames{
+	{CheckResult::SATISFIABLE, "sat"},
+	{CheckResult::UNSATISFIABLE, "unsat"},
+	{CheckResult::UNKNOWN, "unknown"}
+};
+
+}
+
+h256 SMTQueryCache::key(string const& _solverIdentity, string const& _query)
+{
+	return keccak256(_solverIdentity + '\n' + _query);
+}
+
+boost::optional<SMTQueryCache::Answer> SMTQueryCache::lookup(h256 const& _key)
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto answer = m_answers.find(_key);
+		if (answer != m_answers.end())
+			return answer->second;
+	}
+	if (m_directory.empty())
+		return {};
+
+	boost::optional<Answer> answer = readFile(_key);
+	if (answer)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_answers.emplace(_key, *answer);
+	}
+	return answer;
+}
+
+void SMTQueryCache::store(h256 const& _key, Answer const& _answer)
+{
+	if (!c_resultNames.count(_answer.first))
+		return;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_answers.emplace(_key, _answer).second)
+			return;
+	}
+	if (!m_directory.empty())
+		writeFile(_key, _answer);
+}
+
+boost::optional<SMTQueryCache::Answer> SMTQueryCache::readFile(h256 const& _key) const
+{
+	boost::filesystem::path path = m_directory / _key.hex();
+	boost::system::error_code error;
+	if (!boost::filesystem::is_regular_file(path, error))
+		return {};
+
+	Json::Value json;
+	if (!jsonParseStrict(readFileAsString(path.string()), json) || !json.isObject())
+		return {};
+	if (!json["result"].isString() || !json["values"].isArray())
+		return {};
+
+	Answer answer;
+	auto result = find_if(c_resultNames.begin(), c_resultNames.end(), [&](pair<CheckResult const, string> const& _name) {
+		return _name.second == json["result"].asString();
+	});
+	if (result == c_resultNames.end())
+		return {};
+	answer.first = result->first;
+	for (auto const& value: json["values"])
+	{
+		if (!value.isString())
+			return {};
+		answer.second.push_back(value.asString());
+	}
+	return answer;
+}
+
+void SMTQueryCache::writeFile(h256 const& _key, Answer const& _answer) const
+{
+	Json::Value json(Json::objectValue);
+	json["result"] = c_resultNames.at(_answer.first);
+	json["values"] = Json::arrayValue;
+	for (auto const& value: _answer.second)
+		json["values"].append(value);
+
+	// Another compiler might read the file while it is written, so it is
+	// written under a unique name first and then renamed.
+	boost::system::error_code error;
+	boost::filesystem::create_directories(m_directory, error);
+	boost::filesystem::path temporaryPath = m_directory / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+	{
+		ofstream file(temporaryPath.string(), ios::binary);
+		file << jsonCompactPrint(json);
+		if (!file)
+		{
+			file.close();
+			boost::filesystem::remove(temporaryPath, error);
+			return;
+		}
+	}
+	boost::filesystem::rename(temporaryPath, m_directory / _key.hex(), error);
+	if (error)
+		boost::filesystem::remove(temporaryPath, error);
+}
@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache of the answers of SMT solvers that can be shared between compilations.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Content-addressed store of the answers of SMT solvers.
+ *
+ * A query is identified by the hash of its SMT-LIB2 text and of the identity of the solver
+ * that answers it, i.e. its name, its version and the options that influence the answer,
+ * like the timeout. Only SAT, UNSAT and UNKNOWN answers are stored, together with the values
+ * of the expressions that were evaluated.
+ *
+ * The answers are kept in memory and, if a directory is given, also in one file per query
+ * in that directory, so that they persist between runs of the compiler. Files that cannot
+ * be read or written are ignored.
+ *
+ * All functions can be called concurrently.
+ */
+class SMTQueryCache: boost::noncopyable
+{
+public:
+	using Answer = std::pair<CheckResult, std::vector<std::string>>;
+
+	/// Creates a cache that is only kept in memory.
+	SMTQueryCache() = default;
+	/// Creates a cache that also stores the answers in @a _directory.
+	/// The directory is created when the first answer is stored.
+	explicit SMTQueryCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the key of the query @a _query in SMT-LIB2 format to the solver @a _solverIdentity.
+	static h256 key(std::string const& _solverIdentity, std::string const& _query);
+
+	/// @returns the stored answer to the query with the key @a _key, if any.
+	boost::optional<Answer> lookup(h256 const& _key);
+	/// Stores @a _answer as the answer to the query with the key @a _key,
+	/// unless it is ERROR or CONFLICTING.
+	void store(h256 const& _key, Answer const& _answer);
+
+private:
+	boost::optional<Answer> readFile(h256 const& _key) const;
+	void writeFile(h256 const& _key, Answer const& _answer) const;
+
+	std::mutex m_mutex;
+	std::map<h256, Answer> m_answers;
+	/// Directory of the persistent answers, empty if they are only kept in memory.
+	boost::filesystem::path m_directory;
+};
+
+}
+}
+}
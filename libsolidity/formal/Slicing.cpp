@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/Slicing.h>
+
+#include <libsolidity/formal/Substitution.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+/// @returns the conjuncts of @a _expr from left to right.
+vector<Expression const*> conjuncts(Expression const& _expr)
+{
+	// Conjunctions of assertions are nested very deeply, hence no recursion.
+	vector<Expression const*> result;
+	vector<Expression const*> pending{&_expr};
+	while (!pending.empty())
+	{
+		Expression const* expr = pending.back();
+		pending.pop_back();
+		if (expr->name == "and" && expr->arguments.size() == 2)
+		{
+			pending.push_back(&expr->arguments[1]);
+			pending.push_back(&expr->arguments[0]);
+		}
+		else if (expr->name != "true" || !expr->arguments.empty())
+			result.push_back(expr);
+	}
+	return result;
+}
+
+/// Adds the names of the variables and uninterpreted functions in @a _expr to @a _symbols.
+void collectSymbols(Expression const& _expr, set<string>& _symbols)
+{
+	if (isSymbol(_expr))
+		_symbols.insert(_expr.name);
+	for (auto const& argument: _expr.arguments)
+		collectSymbols(argument, _symbols);
+}
+
+}
+
+boost::optional<Expression> smt::sliceConstraints(Expression const& _constraints, Expression const& _target)
+{
+	vector<Expression const*> conjuncts = ::conjuncts(_constraints);
+
+	vector<set<string>> conjunctSymbols(conjuncts.size());
+	map<string, vector<size_t>> conjunctsBySymbol;
+	vector<bool> kept(conjuncts.size(), false);
+	vector<size_t> keptConjuncts;
+	for (size_t i = 0; i < conjuncts.size(); ++i)
+	{
+		collectSymbols(*conjuncts[i], conjunctSymbols[i]);
+		for (auto const& symbol: conjunctSymbols[i])
+			conjunctsBySymbol[symbol].push_back(i);
+		if (conjunctSymbols[i].empty())
+		{
+			kept[i] = true;
+			keptConjuncts.push_back(i);
+		}
+	}
+
+	set<string> targetSymbols;
+	collectSymbols(_target, targetSymbols);
+	vector<string> pendingSymbols(targetSymbols.begin(), targetSymbols.end());
+	set<string> visitedSymbols(targetSymbols.begin(), targetSymbols.end());
+	while (!pendingSymbols.empty())
+	{
+		string symbol = move(pendingSymbols.back());
+		pendingSymbols.pop_back();
+		auto conjunctsWithSymbol = conjunctsBySymbol.find(symbol);
+		if (conjunctsWithSymbol == conjunctsBySymbol.end())
+			continue;
+		for (size_t i: conjunctsWithSymbol->second)
+			if (!kept[i])
+			{
+				// An additional query with most of the conjuncts does not pay off.
+				if (2 * (keptConjuncts.size() + 1) > conjuncts.size())
+					return {};
+				kept[i] = true;
+				keptConjuncts.push_back(i);
+				for (auto const& otherSymbol: conjunctSymbols[i])
+					if (visitedSymbols.insert(otherSymbol).second)
+						pendingSymbols.push_back(otherSymbol);
+			}
+	}
+
+	// Keep the conjuncts in their original order, so that the query does not depend
+	// on the order in which they were found.
+	sort(keptConjuncts.begin(), keptConjuncts.end());
+	Expression sliced = _target;
+	for (auto i = keptConjuncts.rbegin(); i != keptConjuncts.rend(); ++i)
+		sliced = *conjuncts[*i] && move(sliced);
+	return sliced;
+}
@@ -0,0 +1,47 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cone-of-influence slicing of SMT queries.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/optional.hpp>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/// Splits @a _constraints into its conjuncts and keeps those that share a variable or an
+/// uninterpreted function with @a _target, directly or through other kept conjuncts.
+/// Conjuncts without any variable are kept as well.
+/// @returns the conjunction of @a _target and the kept conjuncts, or nothing if more than half of
+/// the conjuncts are kept.
+///
+/// The result is implied by `_constraints && _target`, hence if it is unsatisfiable, so is the
+/// latter. The converse does not hold in general, since the dropped conjuncts might contradict
+/// each other.
+boost::optional<Expression> sliceConstraints(Expression const& _constraints, Expression const& _target);
+
+}
+}
+}
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SolverBudget.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+SolverBudget::SolverBudget(ModelCheckerSettings const& _settings):
+	m_queryResourceLimit(_settings.queryResourceLimit),
+	m_totalResourceLimit(_settings.totalResourceLimit),
+	m_timeBudget(_settings.timeBudget)
+{
+}
+
+boost::optional<SolverBudget::QueryLimits> SolverBudget::nextQuery()
+{
+	lock_guard<mutex> lock(m_mutex);
+
+	QueryLimits limits;
+	if (m_queryResourceLimit)
+		limits.resources = *m_queryResourceLimit;
+	else
+		limits.milliseconds = queryTimeout;
+
+	if (m_totalResourceLimit)
+	{
+		if (m_spentResources >= *m_totalResourceLimit)
+			return {};
+		uint64_t remaining = min<uint64_t>(*m_totalResourceLimit - m_spentResources, numeric_limits<unsigned>::max());
+		if (limits.resources == 0 || remaining < limits.resources)
+			limits.resources = unsigned(remaining);
+	}
+
+	if (m_timeBudget)
+	{
+		auto now = chrono::steady_clock::now();
+		if (!m_start)
+			m_start = now;
+		auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - *m_start).count();
+		if (elapsed >= *m_timeBudget)
+			return {};
+		unsigned remaining = *m_timeBudget - unsigned(elapsed);
+		if (limits.milliseconds == 0 || remaining < limits.milliseconds)
+			limits.milliseconds = remaining;
+	}
+
+	return limits;
+}
+
+void SolverBudget::spend(uint64_t _resources)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_spentResources += _resources;
+}
+
+string SolverBudget::identity() const
+{
+	if (m_queryResourceLimit)
+		return "resource limit " + to_string(*m_queryResourceLimit);
+	return "timeout " + to_string(queryTimeout);
+}
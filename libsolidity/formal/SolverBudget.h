@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Resources and time the solvers of a model checking engine may spend.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/ModelCheckerSettings.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Limits of the queries of an engine, shared by all its solver instances.
+ *
+ * Each query is limited by the resource limit of the settings, or by a time limit if there is no
+ * resource limit. Resources are measured by the solvers themselves and, unlike time, do not depend
+ * on the load of the machine. In addition, all queries together are limited by the total resource
+ * limit and by the time budget, which starts with the first query. Once one of them is exhausted,
+ * the solvers are not queried anymore and answer UNKNOWN. Concurrent queries might exceed the total
+ * resource limit, since each of them may spend the resources that remained when it started.
+ */
+class SolverBudget: public boost::noncopyable
+{
+public:
+	/// Limits of a single query, zero if unlimited.
+	struct QueryLimits
+	{
+		unsigned resources = 0;
+		unsigned milliseconds = 0;
+	};
+
+	explicit SolverBudget(ModelCheckerSettings const& _settings = ModelCheckerSettings{});
+
+	/// @returns the limits of the next query, or nothing if the budget is exhausted.
+	boost::optional<QueryLimits> nextQuery();
+	/// Records the resources spent by a query.
+	void spend(std::uint64_t _resources);
+
+	/// @returns a description of the limits of each query, which influence the answers of the solvers.
+	std::string identity() const;
+	/// @returns true if the answers of the solvers also depend on the resources or the time
+	/// spent by previous queries, such that UNKNOWN answers must not be reused.
+	bool limitsAllQueries() const { return m_totalResourceLimit || m_timeBudget; }
+
+	/// Time limit of each query in milliseconds if there is no resource limit.
+	static unsigned const queryTimeout = 10000;
+
+private:
+	boost::optional<unsigned> m_queryResourceLimit;
+	boost::optional<std::uint64_t> m_totalResourceLimit;
+	boost::optional<unsigned> m_timeBudget;
+
+	std::mutex m_mutex;
+	std::uint64_t m_spentResources = 0;
+	boost::optional<std::chrono::steady_clock::time_point> m_start;
+};
+
+}
+}
+}
@@ -315,15 +315,23 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Aborts a call to @a check that is running on another thread, which then returns UNKNOWN.
+	/// Has no effect if no check is running.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual unsigned solvers() { return 1; }
 
-protected:
-	// SMT query timeout in milliseconds.
-	static int const queryTimeout = 10000;
+	/// @returns the name and version of the solver and the options that influence its answers,
+	/// or an empty string if its answers must not be cached.
+	virtual std::string identity() const { return {}; }
+
+	/// @returns the name of the solver that produced the answer to the last query, or of the solvers
+	/// if the answers of several solvers are combined.
+	virtual std::string answeredBy() const { return {}; }
 };
 
 }
@@ -0,0 +1,143 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SolverProcess.h>
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/process/args.hpp>
+#include <boost/process/exception.hpp>
+#include <boost/process/io.hpp>
+#include <boost/process/search_path.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+/// Printed by the solver after the response to a query.
+string const c_responseEnd = "solc-end-of-response";
+
+vector<string> splitCommand(string const& _command)
+{
+	vector<string> arguments;
+	boost::algorithm::split(arguments, _command, boost::algorithm::is_space(), boost::algorithm::token_compress_on);
+	arguments.erase(remove(arguments.begin(), arguments.end(), ""), arguments.end());
+	return arguments;
+}
+
+/// @returns the path of the executable, searched in PATH if it is not a path, or an empty path
+/// if it does not exist.
+boost::filesystem::path findExecutable(string const& _executable)
+{
+	boost::filesystem::path executable = _executable;
+	if (!executable.has_parent_path())
+		return boost::process::search_path(_executable);
+	if (!boost::filesystem::is_regular_file(executable))
+		return {};
+	return executable;
+}
+
+}
+
+SolverProcess::SolverProcess(string const& _command):
+	m_command(_command)
+{
+	vector<string> arguments = splitCommand(_command);
+	if (arguments.empty())
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment("No SMT solver command given."));
+	boost::filesystem::path executable = findExecutable(arguments.front());
+	if (executable.empty())
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment("SMT solver \"" + arguments.front() + "\" not found."));
+
+	try
+	{
+		m_process = boost::process::child(
+			executable,
+			boost::process::args(vector<string>(arguments.begin() + 1, arguments.end())),
+			boost::process::std_in < m_input,
+			boost::process::std_out > m_output,
+			boost::process::std_err > boost::process::null
+		);
+	}
+	catch (boost::process::process_error const& _error)
+	{
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment(
+			"Could not start SMT solver \"" + _command + "\": " + _error.what()
+		));
+	}
+}
+
+bool SolverProcess::available(string const& _command)
+{
+	vector<string> arguments = splitCommand(_command);
+	return !arguments.empty() && !findExecutable(arguments.front()).empty();
+}
+
+SolverProcess::~SolverProcess()
+{
+	try
+	{
+		if (m_process.running())
+		{
+			m_input << "(exit)" << endl;
+			m_input.pipe().close();
+			if (!m_process.wait_for(chrono::seconds(1)))
+				m_process.terminate();
+		}
+	}
+	catch (...)
+	{
+	}
+}
+
+void SolverProcess::send(string const& _commands)
+{
+	// Checked before writing, since writing to the pipe of a terminated process raises SIGPIPE.
+	if (!m_process.running())
+		BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment("SMT solver \"" + m_command + "\" terminated."));
+	m_input << _commands;
+}
+
+string SolverProcess::query(string const& _commands)
+{
+	send(_commands + "(echo \"" + c_responseEnd + "\")\n");
+	m_input.flush();
+
+	string response;
+	string line;
+	while (getline(m_output, line))
+	{
+		boost::algorithm::trim_right(line);
+		// Some solvers print the quotes of the echoed string.
+		if (line == c_responseEnd || line == "\"" + c_responseEnd + "\"")
+			return response;
+		response += line + "\n";
+	}
+	BOOST_THROW_EXCEPTION(SolverError() << errinfo_comment("SMT solver \"" + m_command + "\" terminated."));
+}
@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * SMT solver running in a separate process that reads SMT-LIB2 commands from its standard input.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+#include <boost/process/child.hpp>
+#include <boost/process/pipe.hpp>
+
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Keeps a solver process running and exchanges SMT-LIB2 commands and responses with it
+ * through pipes, such that the solver keeps its state across queries.
+ *
+ * Responses are delimited by asking the solver to echo a marker after the commands of a query,
+ * hence the solver has to support the "echo" command of SMT-LIB 2.5.
+ */
+class SolverProcess: public boost::noncopyable
+{
+public:
+	/// Starts the solver using @a _command, the path or the name of the executable followed by
+	/// its arguments, separated by whitespace. Throws SolverError if it cannot be started.
+	explicit SolverProcess(std::string const& _command);
+	/// @returns true if the executable of @a _command exists.
+	static bool available(std::string const& _command);
+	/// Asks the solver to exit and terminates it if it does not.
+	~SolverProcess();
+
+	/// Sends @a _commands to the solver without waiting for a response.
+	/// Throws SolverError if the solver is not running.
+	void send(std::string const& _commands);
+	/// Sends @a _commands to the solver and @returns the lines it printed in response to them
+	/// and to previously sent commands.
+	/// Throws SolverError if the solver terminates before it responded.
+	std::string query(std::string const& _commands);
+
+private:
+	std::string m_command;
+	boost::process::opstream m_input;
+	boost::process::ipstream m_output;
+	boost::process::child m_process;
+};
+
+}
+}
+}
@@ -0,0 +1,56 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/Substitution.h>
+
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+bool smt::isSymbol(Expression const& _expr)
+{
+	if (_expr.hasCorrectArity() || _expr.name.empty())
+		return false;
+	if (!_expr.arguments.empty())
+		return true;
+	char first = _expr.name.front();
+	return _expr.name != "true" && _expr.name != "false" && first != '-' && !('0' <= first && first <= '9');
+}
+
+boost::optional<Expression> smt::renameSymbols(Expression _expr, map<string, string> const& _names)
+{
+	// Conjunctions of assertions are nested very deeply, hence no recursion.
+	vector<Expression*> pending{&_expr};
+	while (!pending.empty())
+	{
+		Expression* expr = pending.back();
+		pending.pop_back();
+		if (isSymbol(*expr))
+		{
+			auto name = _names.find(expr->name);
+			if (name == _names.end())
+				return {};
+			expr->name = name->second;
+		}
+		for (auto& argument: expr->arguments)
+			pending.push_back(&argument);
+	}
+	return _expr;
+}
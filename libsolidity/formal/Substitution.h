@@ -0,0 +1,48 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Renaming of the variables and uninterpreted functions of SMT expressions.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/// @returns true if @a _expr is a variable or an application of an uninterpreted function,
+/// i.e. neither a literal nor an operator.
+bool isSymbol(Expression const& _expr);
+
+/// @returns @a _expr with the name of each variable and uninterpreted function replaced
+/// according to @a _names, or nothing if @a _names does not contain one of the names.
+/// The sorts are not changed, hence the new names must have been declared with the same sorts.
+boost::optional<Expression> renameSymbols(Expression _expr, std::map<std::string, std::string> const& _names);
+
+}
+}
+}
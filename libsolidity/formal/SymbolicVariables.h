@@ -64,6 +64,7 @@ public:
 
 	unsigned index() const { return m_ssa->index(); }
 	unsigned& index() { return m_ssa->index(); }
+	unsigned nextFreeIndex() const { return m_ssa->nextFreeIndex(); }
 
 	SortPointer const& sort() const { return m_sort; }
 	solidity::TypePointer const& type() const { return m_type; }
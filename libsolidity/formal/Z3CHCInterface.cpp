@@ -20,19 +20,20 @@
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/CommonIO.h>
 
+#include <chrono>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
 
-Z3CHCInterface::Z3CHCInterface():
-	m_z3Interface(make_shared<Z3Interface>()),
+Z3CHCInterface::Z3CHCInterface(shared_ptr<SolverBudget> _budget):
+	m_z3Interface(make_shared<Z3Interface>(_budget)),
+	m_budget(move(_budget)),
 	m_context(m_z3Interface->context()),
 	m_solver(*m_context)
 {
 	// This needs to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
-	// This needs to be set in the context.
-	m_context->set("timeout", queryTimeout);
 }
 
 void Z3CHCInterface::declareVariable(string const& _name, Sort const& _sort)
@@ -60,12 +61,38 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 	}
 }
 
+string Z3CHCInterface::smtlib2Query(Expression const& _expr)
+{
+	try
+	{
+		z3::expr_vector queries(*m_context);
+		queries.push_back(m_z3Interface->toZ3Expr(_expr));
+		return m_solver.to_string(queries);
+	}
+	catch (z3::exception const&)
+	{
+		return {};
+	}
+}
+
+string Z3CHCInterface::identity() const
+{
+	return string(Z3_get_full_version()) + ", Horn, " + m_budget->identity();
+}
+
 pair<CheckResult, vector<string>> Z3CHCInterface::query(Expression const& _expr)
 {
+	boost::optional<SolverBudget::QueryLimits> limits = m_budget->nextQuery();
+	if (!limits)
+		return make_pair(CheckResult::UNKNOWN, vector<string>{});
+
 	CheckResult result;
 	vector<string> values;
+	uint64_t resourcesBefore = Z3Interface::spentResources(m_solver.statistics());
+	auto start = chrono::steady_clock::now();
 	try
 	{
+		Z3Interface::setLimits(*m_context, *limits);
 		z3::expr z3Expr = m_z3Interface->toZ3Expr(_expr);
 		switch (m_solver.query(z3Expr))
 		{
@@ -89,9 +116,20 @@ pair<CheckResult, vector<string>> Z3CHCInterface::query(Expression const& _expr)
 	}
 	catch (z3::exception const& _e)
 	{
-		result = CheckResult::ERROR;
+		// Unlike the other solvers, the Horn solver throws if it runs out of time or resources.
+		bool outOfResources =
+			limits->resources &&
+			Z3Interface::spentResources(m_solver.statistics()) - resourcesBefore >= limits->resources;
+		bool outOfTime =
+			limits->milliseconds &&
+			chrono::steady_clock::now() - start >= chrono::milliseconds(limits->milliseconds);
+		if (outOfResources || outOfTime)
+			result = CheckResult::UNKNOWN;
+		else
+			result = CheckResult::ERROR;
 		values.clear();
 	}
+	m_budget->spend(Z3Interface::spentResources(m_solver.statistics()) - resourcesBefore);
 
 	return make_pair(result, values);
 }
@@ -34,7 +34,7 @@ namespace smt
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface();
+	explicit Z3CHCInterface(std::shared_ptr<SolverBudget> _budget = std::make_shared<SolverBudget>());
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, Sort const& _sort) override;
@@ -45,18 +45,21 @@ public:
 
 	std::pair<CheckResult, std::vector<std::string>> query(Expression const& _expr) override;
 
+	std::string smtlib2Query(Expression const& _expr) override;
+
+	std::string identity() const override;
+
 	std::shared_ptr<Z3Interface> z3Interface() { return m_z3Interface; }
 
 private:
 	// Used to handle variables.
 	std::shared_ptr<Z3Interface> m_z3Interface;
 
+	std::shared_ptr<SolverBudget> m_budget;
+
 	z3::context* m_context;
 	// Horn solver.
 	z3::fixedpoint m_solver;
-
-	// SMT query timeout in milliseconds.
-	static int const queryTimeout = 10000;
 };
 
 }
@@ -20,17 +20,18 @@
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/CommonIO.h>
 
+#include <limits>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
 
-Z3Interface::Z3Interface():
+Z3Interface::Z3Interface(shared_ptr<SolverBudget> _budget):
+	m_budget(move(_budget)),
 	m_solver(m_context)
 {
 	// This needs to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
-	// This needs to be set in the context.
-	m_context.set("timeout", queryTimeout);
 }
 
 void Z3Interface::reset()
@@ -75,11 +76,19 @@ void Z3Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	boost::optional<SolverBudget::QueryLimits> limits = m_budget->nextQuery();
+	if (!limits)
+		return make_pair(CheckResult::UNKNOWN, vector<string>{});
+
 	CheckResult result;
 	vector<string> values;
 	try
 	{
-		switch (m_solver.check())
+		setLimits(m_context, *limits);
+		uint64_t resourcesBefore = spentResources(m_solver.statistics());
+		z3::check_result z3Result = m_solver.check();
+		m_budget->spend(spentResources(m_solver.statistics()) - resourcesBefore);
+		switch (z3Result)
 		{
 		case z3::check_result::sat:
 			result = CheckResult::SATISFIABLE;
@@ -108,6 +117,35 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	return make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	// Interrupting the whole context can leave it cancelled if the interrupt arrives
+	// while the solver is not checking, such that the next push fails.
+	Z3_solver_interrupt(m_context, m_solver);
+}
+
+string Z3Interface::identity() const
+{
+	return string(Z3_get_full_version()) + ", " + m_budget->identity();
+}
+
+void Z3Interface::setLimits(z3::context& _context, SolverBudget::QueryLimits const& _limits)
+{
+	// These need to be set in the context. Zero means unlimited for the resource limit,
+	// but not for the timeout.
+	_context.set("rlimit", to_string(_limits.resources).c_str());
+	_context.set("timeout", to_string(_limits.milliseconds ? _limits.milliseconds : numeric_limits<unsigned>::max()).c_str());
+}
+
+uint64_t Z3Interface::spentResources(z3::stats const& _statistics)
+{
+	// The count is cumulative for the context, unlike the limit, which applies to each query.
+	for (unsigned i = 0; i < _statistics.size(); ++i)
+		if (_statistics.key(i) == "rlimit count")
+			return _statistics.is_uint(i) ? _statistics.uint_value(i) : uint64_t(_statistics.double_value(i));
+	return 0;
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
@@ -17,10 +17,14 @@
 
 #pragma once
 
+#include <libsolidity/formal/SolverBudget.h>
 #include <libsolidity/formal/SolverInterface.h>
 #include <boost/noncopyable.hpp>
 #include <z3++.h>
 
+#include <cstdint>
+#include <memory>
+
 namespace dev
 {
 namespace solidity
@@ -31,7 +35,7 @@ namespace smt
 class Z3Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	Z3Interface();
+	explicit Z3Interface(std::shared_ptr<SolverBudget> _budget = std::make_shared<SolverBudget>());
 
 	void reset() override;
 
@@ -42,6 +46,9 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	std::string identity() const override;
+	std::string answeredBy() const override { return "Z3"; }
 
 	z3::expr toZ3Expr(Expression const& _expr);
 
@@ -50,6 +57,11 @@ public:
 
 	z3::context* context() { return &m_context; }
 
+	/// Applies @a _limits to the next queries of all solvers of the context.
+	static void setLimits(z3::context& _context, SolverBudget::QueryLimits const& _limits);
+	/// @returns the resources spent by all solvers of the context so far, according to @a _statistics.
+	static std::uint64_t spentResources(z3::stats const& _statistics);
+
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
@@ -59,6 +71,8 @@ private:
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
 
+	std::shared_ptr<SolverBudget> m_budget;
+
 	z3::context m_context;
 	z3::solver m_solver;
 };
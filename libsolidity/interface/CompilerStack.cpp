@@ -37,6 +37,9 @@
 #include <libsolidity/analysis/ViewPureChecker.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
+#include <libsolidity/ast/ASTSnapshot.h>
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
@@ -64,6 +67,7 @@
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/IpfsHash.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Parallel.h>
 
 #include <json/json.h>
 
@@ -76,6 +80,21 @@ using namespace dev::solidity;
 
 static int g_compilerStackCounts = 0;
 
+namespace
+{
+
+/// Creates the annotation of every node it visits.
+class AnnotationCreator: public ASTConstVisitor
+{
+	bool visitNode(ASTNode const& _node) override
+	{
+		_node.annotation();
+		return true;
+	}
+};
+
+}
+
 CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 	m_readFile{_readFile},
 	m_generateIR{false},
@@ -131,6 +150,20 @@ void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 	m_evmVersion = _version;
 }
 
+void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
+{
+	if (m_stackState >= ParsingSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set model checker settings before parsing."));
+	m_modelCheckerSettings = std::move(_settings);
+}
+
+void CompilerStack::setASTSnapshotCallback(ASTSnapshotCallback _callback)
+{
+	if (m_stackState >= ParsingSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set AST snapshot callback before parsing."));
+	m_astSnapshotCallback = move(_callback);
+}
+
 void CompilerStack::setLibraries(std::map<std::string, h160> const& _libraries)
 {
 	if (m_stackState >= ParsingSuccessful)
@@ -170,6 +203,7 @@ void CompilerStack::reset(bool _keepSettings)
 {
 	m_stackState = Empty;
 	m_sources.clear();
+	m_sourceRegistry.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
@@ -180,7 +214,10 @@ void CompilerStack::reset(bool _keepSettings)
 		m_generateIR = false;
 		m_generateEWasm = false;
 		m_optimiserSettings = OptimiserSettings::minimal();
+		m_modelCheckerSettings = ModelCheckerSettings();
 		m_metadataLiteralSources = false;
+		m_parallelAnalysis = false;
+		m_astSnapshotCallback = ASTSnapshotCallback();
 	}
 	m_globalContext.reset();
 	m_scopes.clear();
@@ -196,8 +233,11 @@ void CompilerStack::setSources(StringMap _sources)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
+	for (auto& source: _sources)
+	{
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
+		m_sourceRegistry.add(m_sources[source.first].scanner->charStream());
+	}
 	m_stackState = SourcesSet;
 }
 
@@ -225,21 +265,42 @@ bool CompilerStack::parse()
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
 		source.scanner->reset();
-		source.ast = Parser(m_errorReporter, m_evmVersion, m_parserErrorRecovery).parse(source.scanner);
+		source.arena = ASTArena::create();
+		loadFromSnapshot(path, source);
+		if (!source.snapshot)
+			source.ast = Parser(m_errorReporter, m_evmVersion, m_parserErrorRecovery, source.arena).parse(source.scanner);
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
 			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			for (auto& newSource: loadMissingSources(*source.ast, path))
 			{
 				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(std::move(newSource.second), newPath));
+				m_sourceRegistry.add(m_sources[newPath].scanner->charStream());
 				sourcesToParse.push_back(newPath);
 			}
 		}
 	}
+	// Snapshots can only be used together with the sources they were created with,
+	// the other sources are parsed after all.
+	for (auto& sourcePair: m_sources)
+	{
+		Source& source = sourcePair.second;
+		if (!source.snapshot || snapshotMatchesSources(source))
+			continue;
+		source.snapshot.reset();
+		source.scanner->reset();
+		source.arena = ASTArena::create();
+		source.ast = Parser(m_errorReporter, m_evmVersion, m_parserErrorRecovery, source.arena).parse(source.scanner);
+		if (source.ast)
+		{
+			source.ast->annotation().path = sourcePair.first;
+			StringMap newSources = loadMissingSources(*source.ast, sourcePair.first);
+			solAssert(newSources.empty(), "");
+		}
+	}
 	if (Error::containsOnlyWarnings(m_errorReporter.errors()))
 	{
 		m_stackState = ParsingSuccessful;
@@ -258,16 +319,24 @@ bool CompilerStack::analyze()
 	bool noErrors = true;
 
 	try {
+		// Sources loaded from snapshots were analysed when the snapshot was created, only the
+		// declarations and imports are registered again. Their diagnostics are not repeated.
+		set<int> snapshotSourceIDs;
+		for (Source const* source: m_sourceOrder)
+			if (source->snapshot)
+				snapshotSourceIDs.insert(source->ast->location().sourceId);
+
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
 		for (Source const* source: m_sourceOrder)
-			if (!syntaxChecker.checkSyntax(*source->ast))
+			if (!source->snapshot && !syntaxChecker.checkSyntax(*source->ast))
 				noErrors = false;
 
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
-			if (!docStringAnalyser.analyseDocStrings(*source->ast))
+			if (!source->snapshot && !docStringAnalyser.analyseDocStrings(*source->ast))
 				noErrors = false;
 
+		size_t errorCount = m_errorList.size();
 		m_globalContext = make_shared<GlobalContext>();
 		NameAndTypeResolver resolver(*m_globalContext, m_scopes, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -281,6 +350,22 @@ bool CompilerStack::analyze()
 			if (!resolver.performImports(*source->ast, sourceUnitsByName))
 				return false;
 
+		m_errorList.erase(
+			remove_if(
+				m_errorList.begin() + errorCount,
+				m_errorList.end(),
+				[&](shared_ptr<Error const> const& _error)
+				{
+					SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*_error);
+					return location && snapshotSourceIDs.count(location->sourceId);
+				}
+			),
+			m_errorList.end()
+		);
+		for (Source const* source: m_sourceOrder)
+			if (source->snapshot)
+				source->snapshot->readAnnotations(sourceUnitsByName, *m_globalContext);
+
 		// This is the main name and type resolution loop. Needs to be run for every contract, because
 		// the special variables "this" and "super" must be set appropriately.
 		for (Source const* source: m_sourceOrder)
@@ -288,7 +373,7 @@ bool CompilerStack::analyze()
 				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 				{
 
-					if (!resolver.resolveNamesAndTypes(*contract)) return false;
+					if (!source->snapshot && !resolver.resolveNamesAndTypes(*contract)) return false;
 					// Note that we now reference contracts by their fully qualified names, and
 					// thus contracts can only conflict if declared in the same source file.  This
 					// already causes a double-declaration error elsewhere, so we do not report
@@ -303,10 +388,11 @@ bool CompilerStack::analyze()
 		// type checker.
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!contractLevelChecker.check(*contract))
-						noErrors = false;
+			if (!source->snapshot)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						if (!contractLevelChecker.check(*contract))
+							noErrors = false;
 
 		// New we run full type checks that go down to the expression level. This
 		// cannot be done earlier, because we need cross-contract types and information
@@ -315,19 +401,28 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!typeChecker.checkTypeRequirements(*contract))
-						noErrors = false;
+		if (m_parallelAnalysis)
+		{
+			if (!typeCheckConcurrently())
+				noErrors = false;
+		}
+		else
+		{
+			TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!source->snapshot)
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+							if (!typeChecker.checkTypeRequirements(*contract))
+								noErrors = false;
+		}
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!postTypeChecker.check(*source->ast))
+				if (!source->snapshot && !postTypeChecker.check(*source->ast))
 					noErrors = false;
 		}
 
@@ -337,14 +432,14 @@ bool CompilerStack::analyze()
 			// variable is used before it is assigned to.
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!cfg.constructFlow(*source->ast))
+				if (!source->snapshot && !cfg.constructFlow(*source->ast))
 					noErrors = false;
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
 				for (Source const* source: m_sourceOrder)
-					if (!controlFlowAnalyzer.analyze(*source->ast))
+					if (!source->snapshot && !controlFlowAnalyzer.analyze(*source->ast))
 						noErrors = false;
 			}
 		}
@@ -354,7 +449,7 @@ bool CompilerStack::analyze()
 			// Checks for common mistakes. Only generates warnings.
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!staticAnalyzer.analyze(*source->ast))
+				if (!source->snapshot && !staticAnalyzer.analyze(*source->ast))
 					noErrors = false;
 		}
 
@@ -362,18 +457,24 @@ bool CompilerStack::analyze()
 		{
 			// Check for state mutability in every function.
 			vector<ASTPointer<ASTNode>> ast;
+			set<ASTNode const*> snapshotASTs;
 			for (Source const* source: m_sourceOrder)
+			{
 				ast.push_back(source->ast);
+				if (source->snapshot)
+					snapshotASTs.insert(source->ast.get());
+			}
 
-			if (!ViewPureChecker(ast, m_errorReporter).check())
+			if (!ViewPureChecker(ast, m_errorReporter, snapshotASTs).check())
 				noErrors = false;
 		}
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses);
+			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, &m_sourceRegistry);
 			for (Source const* source: m_sourceOrder)
-				modelChecker.analyze(*source->ast, source->scanner);
+				if (!source->snapshot)
+					modelChecker.analyze(*source->ast, source->scanner);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
 		}
 	}
@@ -393,6 +494,62 @@ bool CompilerStack::analyze()
 		return false;
 }
 
+bool CompilerStack::typeCheckConcurrently()
+{
+	vector<ContractDefinition const*> contracts;
+	for (Source const* source: m_sourceOrder)
+	{
+		// Annotations are created on first use, which is not thread-safe.
+		AnnotationCreator annotationCreator;
+		source->ast->accept(annotationCreator);
+		if (!source->snapshot)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					contracts.push_back(contract);
+	}
+	for (Declaration const* declaration: m_globalContext->declarations())
+		declaration->annotation();
+
+	struct Result
+	{
+		ErrorList errors;
+		bool success = false;
+		bool fatal = false;
+	};
+	vector<Result> results(contracts.size());
+	ErrorList const& previousErrors = m_errorReporter.errors();
+	size_t previousErrorCount = previousErrors.size();
+	parallelFor(contracts.size(), [&](size_t _index)
+	{
+		Result& result = results[_index];
+		ErrorReporter errorReporter(result.errors);
+		// Start from the state of the shared reporter, so that checks for earlier errors
+		// and the limits on the number of errors behave as in a sequential check.
+		errorReporter.merge(previousErrors);
+		try
+		{
+			result.success = TypeChecker(m_evmVersion, errorReporter).checkTypeRequirements(*contracts[_index]);
+		}
+		catch (FatalError const&)
+		{
+			result.fatal = true;
+		}
+	});
+
+	// Report the errors in the same order as a sequential check would. The sequential check
+	// stops at the first fatal error, so the errors of later contracts are dropped.
+	bool success = true;
+	for (Result const& result: results)
+	{
+		m_errorReporter.merge(ErrorList(result.errors.begin() + previousErrorCount, result.errors.end()));
+		if (result.fatal)
+			BOOST_THROW_EXCEPTION(FatalError());
+		if (!result.success)
+			success = false;
+	}
+	return success;
+}
+
 bool CompilerStack::parseAndAnalyze()
 {
 	return parse() && analyze();
@@ -598,7 +755,7 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.compiler)
-		return currentContract.compiler->assemblyString(_sourceCodes);
+		return currentContract.compiler->assemblyString(_sourceCodes, &m_sourceRegistry);
 	else
 		return string();
 }
@@ -633,6 +790,15 @@ map<string, unsigned> CompilerStack::sourceIndices() const
 	return indices;
 }
 
+map<int, unsigned> CompilerStack::sourceIndicesByID() const
+{
+	map<int, unsigned> indices;
+	unsigned index = 0;
+	for (auto const& s: m_sources)
+		indices[s.second.scanner->sourceId()] = index++;
+	return indices;
+}
+
 Json::Value const& CompilerStack::contractABI(string const& _contractName) const
 {
 	if (m_stackState < AnalysisSuccessful)
@@ -748,6 +914,24 @@ SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 	return *source(_sourceName).ast;
 }
 
+bytes CompilerStack::astSnapshot(string const& _sourceName) const
+{
+	if (m_stackState < AnalysisSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+	if (!count(m_sourceOrder.begin(), m_sourceOrder.end(), &source(_sourceName)))
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Source was not analysed."));
+
+	map<string, pair<SourceUnit const*, h256>> sources;
+	for (auto const& sourcePair: m_sources)
+		sources[sourcePair.first] = make_pair(sourcePair.second.ast.get(), sourcePair.second.keccak256());
+	return ASTSnapshotWriter(move(sources), *m_globalContext, m_evmVersion).write(_sourceName);
+}
+
+bool CompilerStack::loadedFromSnapshot(string const& _sourceName) const
+{
+	return !!source(_sourceName).snapshot;
+}
+
 ContractDefinition const& CompilerStack::contractDefinition(string const& _contractName) const
 {
 	if (m_stackState < AnalysisSuccessful)
@@ -783,8 +967,13 @@ tuple<int, int, int, int> CompilerStack::positionFromSourceLocation(SourceLocati
 	int startColumn;
 	int endLine;
 	int endColumn;
-	tie(startLine, startColumn) = scanner(_sourceLocation.source->name()).translatePositionToLineColumn(_sourceLocation.start);
-	tie(endLine, endColumn) = scanner(_sourceLocation.source->name()).translatePositionToLineColumn(_sourceLocation.end);
+	CharStream const* source = m_sourceRegistry.charStream(_sourceLocation);
+	solAssert(source, "Unknown source.");
+	auto lineColumns = source->translatePositionsToLineColumns(
+		{_sourceLocation.start, _sourceLocation.end}
+	);
+	tie(startLine, startColumn) = lineColumns[0];
+	tie(endLine, endColumn) = lineColumns[1];
 
 	return make_tuple(++startLine, ++startColumn, ++endLine, ++endColumn);
 }
@@ -812,6 +1001,51 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
+void CompilerStack::loadFromSnapshot(string const& _path, Source& _source)
+{
+	if (!m_astSnapshotCallback)
+		return;
+	bytes data = m_astSnapshotCallback(_source.keccak256());
+	if (data.empty())
+		return;
+
+	try
+	{
+		auto snapshot = make_shared<ASTSnapshotReader>(move(data));
+		if (
+			snapshot->compilerVersion() != VersionString ||
+			!(snapshot->evmVersion() == m_evmVersion) ||
+			snapshot->sourceName() != _path ||
+			snapshot->sourceHash() != _source.keccak256()
+		)
+			return;
+		_source.ast = snapshot->readAST(_source.arena, _source.scanner->charStream());
+		_source.snapshot = move(snapshot);
+	}
+	catch (ASTSnapshotError const&)
+	{
+		// Invalid snapshots are ignored and the source is parsed instead.
+		_source.ast.reset();
+		_source.arena = ASTArena::create();
+	}
+}
+
+bool CompilerStack::snapshotMatchesSources(Source const& _source) const
+{
+	solAssert(_source.snapshot, "");
+	for (auto const& dependency: _source.snapshot->dependencies())
+	{
+		auto dependencySource = m_sources.find(dependency.first);
+		if (dependencySource == m_sources.end() || dependencySource->second.keccak256() != dependency.second)
+			return false;
+	}
+	vector<string> importPaths;
+	for (auto const& node: _source.ast->nodes())
+		if (auto import = dynamic_cast<ImportDirective const*>(node.get()))
+			importPaths.push_back(import->annotation().absolutePath);
+	return importPaths == _source.snapshot->importPaths();
+}
+
 StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
 {
 	solAssert(m_stackState < ParsingSuccessful, "");
@@ -985,6 +1219,7 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
+	m_sourceRegistry.add(compiler->generatedSources());
 	_otherCompilers[compiledContract.contract] = compiler;
 }
 
@@ -1129,6 +1364,9 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+		details["constantOptimizerMaxSteps"] = Json::Value(Json::LargestUInt(m_optimiserSettings.constantOptimiserMaxSteps));
+		details["blockLayout"] = m_optimiserSettings.runBlockLayout;
+		details["tagRelaxation"] = m_optimiserSettings.runTagRelaxation;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
@@ -1265,7 +1503,7 @@ string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) con
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	string ret;
-	map<string, unsigned> sourceIndicesMap = sourceIndices();
+	map<int, unsigned> sourceIndicesMap = sourceIndicesByID();
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
@@ -1278,8 +1516,8 @@ string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) con
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
 		int sourceIndex =
-			location.source && sourceIndicesMap.count(location.source->name()) ?
-			sourceIndicesMap.at(location.source->name()) :
+			sourceIndicesMap.count(location.sourceId) ?
+			sourceIndicesMap.at(location.sourceId) :
 			-1;
 		char jump = '-';
 		if (item.getJumpType() == eth::AssemblyItem::JumpType::IntoFunction)
@@ -1376,26 +1614,31 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 
 	if (eth::AssemblyItems const* items = runtimeAssemblyItems(_contractName))
 	{
+		// The estimations for the different functions are independent of each other,
+		// so they are collected first and then computed concurrently.
+		vector<function<Gas()>> estimations;
+
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
-		Json::Value externalFunctions(Json::objectValue);
+		vector<string> externalSignatures;
 		for (auto it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
+			externalSignatures.push_back(sig);
+			estimations.emplace_back([&, sig]() { return gasEstimator.functionalEstimation(*items, sig); });
 		}
 
 		if (contract.fallbackFunction())
+		{
+			externalSignatures.push_back("");
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
-
-		if (!externalFunctions.empty())
-			output["external"] = externalFunctions;
+			estimations.emplace_back([&]() { return gasEstimator.functionalEstimation(*items, "INVALID"); });
+		}
 
 		/// Internal functions
-		Json::Value internalFunctions(Json::objectValue);
+		vector<string> internalSignatures;
 		for (auto const& it: contract.definedFunctions())
 		{
 			/// Exclude externally visible functions, constructor and the fallback function
@@ -1403,9 +1646,13 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 				continue;
 
 			size_t entry = functionEntryPoint(_contractName, *it);
-			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
+			FunctionDefinition const* functionDefinition = it;
 			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
+				estimations.emplace_back([&, entry, functionDefinition]() {
+					return gasEstimator.functionalEstimation(*items, entry, *functionDefinition);
+				});
+			else
+				estimations.emplace_back([]() { return Gas::infinite(); });
 
 			/// TODO: This could move into a method shared with externalSignature()
 			FunctionType type(*it);
@@ -1414,10 +1661,22 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 			for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
 				sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
 			sig += ")";
-
-			internalFunctions[sig] = gasToJson(gas);
+			internalSignatures.push_back(sig);
 		}
 
+		vector<Gas> estimates(estimations.size());
+		parallelFor(estimations.size(), [&](size_t _index) { estimates[_index] = estimations[_index](); });
+
+		size_t index = 0;
+		Json::Value externalFunctions(Json::objectValue);
+		for (string const& sig: externalSignatures)
+			externalFunctions[sig] = gasToJson(estimates[index++]);
+		if (!externalFunctions.empty())
+			output["external"] = externalFunctions;
+
+		Json::Value internalFunctions(Json::objectValue);
+		for (string const& sig: internalSignatures)
+			internalFunctions[sig] = gasToJson(estimates[index++]);
 		if (!internalFunctions.empty())
 			output["internal"] = internalFunctions;
 	}
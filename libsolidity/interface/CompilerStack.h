@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
@@ -30,6 +31,7 @@
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
+#include <liblangutil/SourceRegistry.h>
 
 #include <libevmasm/LinkerObject.h>
 
@@ -44,6 +46,7 @@
 #include <ostream>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace langutil
@@ -65,7 +68,9 @@ namespace solidity
 {
 
 // forward declarations
+class ASTArena;
 class ASTNode;
+class ASTSnapshotReader;
 class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
@@ -97,6 +102,10 @@ public:
 		std::string target;
 	};
 
+	/// Callback that returns a snapshot created by @a astSnapshot for the source with the given
+	/// keccak256 hash or an empty byte array if there is none.
+	using ASTSnapshotCallback = std::function<bytes(h256 const& _sourceHash)>;
+
 	/// Creates a new compiler stack.
 	/// @param _readFile callback to used to read files for import statements. Must return
 	/// and must not emit exceptions.
@@ -141,6 +150,23 @@ public:
 		m_parserErrorRecovery = _wantErrorRecovery;
 	}
 
+	/// Set whether the contracts are type checked concurrently.
+	/// The reported errors do not depend on this setting.
+	/// Must be set before analysis.
+	void setParallelAnalysis(bool _parallelAnalysis = false)
+	{
+		m_parallelAnalysis = _parallelAnalysis;
+	}
+
+	/// Sets the callback used to look up snapshots of the sources. Sources for which a
+	/// matching snapshot is found are loaded from it instead of being parsed and analysed.
+	/// Must be set before parsing.
+	void setASTSnapshotCallback(ASTSnapshotCallback _callback = ASTSnapshotCallback());
+
+	/// Sets the settings of the model checking engines.
+	/// Must be set before parsing.
+	void setModelCheckerSettings(ModelCheckerSettings _settings);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -196,12 +222,26 @@ public:
 	/// by sourceNames().
 	std::map<std::string, unsigned> sourceIndices() const;
 
+	/// @returns a mapping assigning the ID of each source, as used in source locations,
+	/// its index inside the vector returned by sourceNames().
+	std::map<int, unsigned> sourceIndicesByID() const;
+
+	/// @returns the registry of all sources, used to look up the sources of source locations.
+	langutil::SourceRegistry const& sourceRegistry() const { return m_sourceRegistry; }
+
 	/// @returns the previously used scanner, useful for counting lines during error reporting.
 	langutil::Scanner const& scanner(std::string const& _sourceName) const;
 
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
+	/// @returns a binary snapshot of the analysed source unit with the supplied name.
+	/// Prerequisite: Successful analysis.
+	bytes astSnapshot(std::string const& _sourceName) const;
+
+	/// @returns true if the source with the supplied name was loaded from a snapshot.
+	bool loadedFromSnapshot(std::string const& _sourceName) const;
+
 	/// Helper function for logs printing. Do only use in error cases, it's quite expensive.
 	/// line and columns are numbered starting from 1 with following order:
 	/// start line, start column, end line, end column
@@ -287,7 +327,11 @@ private:
 	struct Source
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
+		/// Memory area holding the nodes of the AST, their annotations and identifiers.
+		std::shared_ptr<ASTArena> arena;
 		std::shared_ptr<SourceUnit> ast;
+		/// Snapshot the AST was loaded from, if any.
+		std::shared_ptr<ASTSnapshotReader> snapshot;
 		h256 mutable keccak256HashCached;
 		h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -315,6 +359,13 @@ private:
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
 	};
 
+	/// Loads the AST of @a _source (named @a _path) from a snapshot provided by
+	/// @a m_astSnapshotCallback, if there is a valid one.
+	void loadFromSnapshot(std::string const& _path, Source& _source);
+	/// @returns true if the sources and imports the snapshot of @a _source refers to are the
+	/// ones of this compilation.
+	bool snapshotMatchesSources(Source const& _source) const;
+
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
@@ -322,6 +373,11 @@ private:
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
+	/// Runs the type checker on all contracts concurrently, each with its own error reporter,
+	/// and reports the errors in source order.
+	/// @returns false if there were errors.
+	bool typeCheckConcurrently();
+
 	/// @returns true if the source is requested to be compiled.
 	bool isRequestedSource(std::string const& _sourceName) const;
 
@@ -392,7 +448,9 @@ private:
 	) const;
 
 	ReadCallback::Callback m_readFile;
+	ASTSnapshotCallback m_astSnapshotCallback;
 	OptimiserSettings m_optimiserSettings;
+	ModelCheckerSettings m_modelCheckerSettings;
 	langutil::EVMVersion m_evmVersion;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateIR;
@@ -402,17 +460,21 @@ private:
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings;
 	std::map<std::string const, Source> m_sources;
+	/// Character streams of all sources in m_sources and of the code generated
+	/// during compilation, by source ID.
+	langutil::SourceRegistry m_sourceRegistry;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	/// This is updated during compilation.
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	std::map<std::string const, Contract> m_contracts;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
 	bool m_parserErrorRecovery = false;
+	bool m_parallelAnalysis = false;
 	State m_stackState = Empty;
 	bool m_release = VersionIsRelease;
 };
@@ -78,9 +78,12 @@ struct OptimiserSettings
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
+			runBlockLayout == _other.runBlockLayout &&
+			runTagRelaxation == _other.runTagRelaxation &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			constantOptimiserMaxSteps == _other.constantOptimiserMaxSteps;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -97,6 +100,12 @@ struct OptimiserSettings
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
+	/// Jump threading and basic block re-ordering, which replaces jumps by falling through
+	/// to the next block where possible.
+	bool runBlockLayout = false;
+	/// Assembler mode that chooses the push width of each jump tag reference separately
+	/// based on the final position of the tag (branch relaxation).
+	bool runTagRelaxation = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
@@ -104,6 +113,9 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Maximum number of decompositions the constant optimiser tries for each constant.
+	/// Larger values can result in cheaper code at the expense of compilation time.
+	size_t constantOptimiserMaxSteps = 10000;
 };
 
 }
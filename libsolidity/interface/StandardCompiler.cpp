@@ -23,6 +23,8 @@
 #include <libsolidity/interface/StandardCompiler.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <libevmasm/Instruction.h>
@@ -33,6 +35,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/optional.hpp>
 #include <algorithm>
+#include <sstream>
 
 using namespace std;
 using namespace dev;
@@ -74,12 +77,12 @@ Json::Value formatFatalError(string const& _type, string const& _message)
 	return output;
 }
 
-Json::Value formatSourceLocation(SourceLocation const* location)
+Json::Value formatSourceLocation(SourceLocation const* location, SourceRegistry const& _sources)
 {
 	Json::Value sourceLocation;
-	if (location && location->source && !location->source->name().empty())
+	if (location && !_sources.name(location->sourceId).empty())
 	{
-		sourceLocation["file"] = location->source->name();
+		sourceLocation["file"] = _sources.name(location->sourceId);
 		sourceLocation["start"] = location->start;
 		sourceLocation["end"] = location->end;
 	}
@@ -87,7 +90,10 @@ Json::Value formatSourceLocation(SourceLocation const* location)
 	return sourceLocation;
 }
 
-Json::Value formatSecondarySourceLocation(SecondarySourceLocation const* _secondaryLocation)
+Json::Value formatSecondarySourceLocation(
+	SecondarySourceLocation const* _secondaryLocation,
+	SourceRegistry const& _sources
+)
 {
 	if (!_secondaryLocation)
 		return {};
@@ -95,7 +101,7 @@ Json::Value formatSecondarySourceLocation(SecondarySourceLocation const* _second
 	Json::Value secondarySourceLocation = Json::arrayValue;
 	for (auto const& location: _secondaryLocation->infos)
 	{
-		Json::Value msg = formatSourceLocation(&location.second);
+		Json::Value msg = formatSourceLocation(&location.second, _sources);
 		msg["message"] = location.first;
 		secondarySourceLocation.append(msg);
 	}
@@ -103,6 +109,7 @@ Json::Value formatSecondarySourceLocation(SecondarySourceLocation const* _second
 }
 
 Json::Value formatErrorWithException(
+	SourceRegistry const& _sources,
 	Exception const& _exception,
 	bool const& _warning,
 	string const& _type,
@@ -111,7 +118,7 @@ Json::Value formatErrorWithException(
 )
 {
 	string message;
-	string formattedMessage = SourceReferenceFormatter::formatExceptionInformation(_exception, _type);
+	string formattedMessage = SourceReferenceFormatter::formatExceptionInformation(_exception, _type, _sources);
 
 	if (string const* description = boost::get_error_info<errinfo_comment>(_exception))
 		message = ((_message.length() > 0) ? (_message + ":") : "") + *description;
@@ -124,8 +131,8 @@ Json::Value formatErrorWithException(
 		_component,
 		message,
 		formattedMessage,
-		formatSourceLocation(boost::get_error_info<errinfo_sourceLocation>(_exception)),
-		formatSecondarySourceLocation(boost::get_error_info<errinfo_secondarySourceLocation>(_exception))
+		formatSourceLocation(boost::get_error_info<errinfo_sourceLocation>(_exception), _sources),
+		formatSecondarySourceLocation(boost::get_error_info<errinfo_secondarySourceLocation>(_exception), _sources)
 	);
 }
 
@@ -317,6 +324,38 @@ Json::Value collectEVMObject(eth::LinkerObject const& _object, string const* _so
 	return output;
 }
 
+Json::Value statisticsJson(
+	TypeQueryStatistics const& _typeQueries,
+	smt::ModelCheckerStatistics const& _modelChecker,
+	SourceRegistry const& _sources
+)
+{
+	auto counters = [](TypeQueryStatistics::Counters const& _counters) {
+		Json::Value output = Json::objectValue;
+		output["hits"] = Json::UInt64(_counters.hits);
+		output["misses"] = Json::UInt64(_counters.misses);
+		return output;
+	};
+	Json::Value output = Json::objectValue;
+	output["typeQueries"]["implicitConversions"] = counters(_typeQueries.implicitConversions);
+	output["typeQueries"]["commonTypes"] = counters(_typeQueries.commonTypes);
+	output["typeQueries"]["binaryOperators"] = counters(_typeQueries.binaryOperators);
+	output["modelChecker"]["targets"] = Json::arrayValue;
+	for (auto const& target: _modelChecker.targets)
+	{
+		Json::Value targetJson = Json::objectValue;
+		targetJson["engine"] = target.engine;
+		targetJson["sourceLocation"] = formatSourceLocation(&target.location, _sources);
+		targetJson["target"] = target.description;
+		targetJson["result"] = smt::checkResultName(target.result);
+		targetJson["solver"] = target.solver;
+		targetJson["solveTime"] = Json::UInt64(target.solveTime.count());
+		targetJson["querySize"] = Json::UInt64(target.querySize);
+		output["modelChecker"]["targets"].append(targetJson);
+	}
+	return output;
+}
+
 boost::optional<Json::Value> checkKeys(Json::Value const& _input, set<string> const& _keys, string const& _name)
 {
 	if (!!_input && !_input.isObject())
@@ -349,10 +388,16 @@ boost::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 boost::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "statistics"};
 	return checkKeys(_input, keys, "settings");
 }
 
+boost::optional<Json::Value> checkModelCheckerKeys(Json::Value const& _input)
+{
+	static set<string> keys{"cache", "portfolio", "resourceLimit", "threads", "timeBudget", "totalResourceLimit"};
+	return checkKeys(_input, keys, "settings.modelChecker");
+}
+
 boost::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
 	static set<string> keys{"details", "enabled", "runs"};
@@ -361,7 +406,7 @@ boost::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 
 boost::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "constantOptimizerMaxSteps", "blockLayout", "tagRelaxation", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -470,6 +515,16 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
+		if (details.isMember("constantOptimizerMaxSteps"))
+		{
+			if (!details["constantOptimizerMaxSteps"].isUInt())
+				return formatFatalError("JSONError", "\"settings.optimizer.details.constantOptimizerMaxSteps\" must be an unsigned number");
+			settings.constantOptimiserMaxSteps = details["constantOptimizerMaxSteps"].asUInt();
+		}
+		if (auto error = checkOptimizerDetail(details, "blockLayout", settings.runBlockLayout))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "tagRelaxation", settings.runTagRelaxation))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
 			return *error;
 		if (settings.runYulOptimiser)
@@ -488,6 +543,65 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 	return { std::move(settings) };
 }
 
+boost::variant<ModelCheckerSettings, Json::Value> parseModelCheckerSettings(
+	Json::Value const& _jsonInput,
+	shared_ptr<smt::SMTQueryCache> const& _queryCache
+)
+{
+	if (auto result = checkModelCheckerKeys(_jsonInput))
+		return *result;
+
+	ModelCheckerSettings settings;
+
+	if (_jsonInput.isMember("portfolio"))
+	{
+		if (!_jsonInput["portfolio"].isString())
+			return formatFatalError("JSONError", "\"settings.modelChecker.portfolio\" must be a string.");
+		boost::optional<smt::PortfolioMode> portfolio = ModelCheckerSettings::portfolioFromString(_jsonInput["portfolio"].asString());
+		if (!portfolio)
+			return formatFatalError("JSONError", "Invalid model checker portfolio mode requested.");
+		settings.portfolio = *portfolio;
+	}
+
+	if (_jsonInput.isMember("threads"))
+	{
+		if (!_jsonInput["threads"].isUInt() || _jsonInput["threads"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.modelChecker.threads\" must be a positive integer.");
+		settings.threads = _jsonInput["threads"].asUInt();
+	}
+
+	if (_jsonInput.isMember("cache"))
+	{
+		if (!_jsonInput["cache"].isBool())
+			return formatFatalError("JSONError", "\"settings.modelChecker.cache\" must be a Boolean.");
+		if (_jsonInput["cache"].asBool())
+			settings.queryCache = _queryCache;
+	}
+
+	if (_jsonInput.isMember("resourceLimit"))
+	{
+		if (!_jsonInput["resourceLimit"].isUInt() || _jsonInput["resourceLimit"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.modelChecker.resourceLimit\" must be a positive integer.");
+		settings.queryResourceLimit = _jsonInput["resourceLimit"].asUInt();
+	}
+
+	if (_jsonInput.isMember("totalResourceLimit"))
+	{
+		if (!_jsonInput["totalResourceLimit"].isUInt64() || _jsonInput["totalResourceLimit"].asUInt64() == 0)
+			return formatFatalError("JSONError", "\"settings.modelChecker.totalResourceLimit\" must be a positive integer.");
+		settings.totalResourceLimit = _jsonInput["totalResourceLimit"].asUInt64();
+	}
+
+	if (_jsonInput.isMember("timeBudget"))
+	{
+		if (!_jsonInput["timeBudget"].isUInt() || _jsonInput["timeBudget"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.modelChecker.timeBudget\" must be a positive integer.");
+		settings.timeBudget = _jsonInput["timeBudget"].asUInt();
+	}
+
+	return { std::move(settings) };
+}
+
 }
 
 boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
@@ -663,6 +777,15 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 			ret.optimiserSettings = boost::get<OptimiserSettings>(std::move(optimiserSettings));
 	}
 
+	if (settings.isMember("modelChecker"))
+	{
+		auto modelCheckerSettings = parseModelCheckerSettings(settings["modelChecker"], m_smtQueryCache);
+		if (modelCheckerSettings.type() == typeid(Json::Value))
+			return boost::get<Json::Value>(std::move(modelCheckerSettings)); // was an error
+		else
+			ret.modelCheckerSettings = boost::get<ModelCheckerSettings>(std::move(modelCheckerSettings));
+	}
+
 	Json::Value jsonLibraries = settings.get("libraries", Json::Value(Json::objectValue));
 	if (!jsonLibraries.isObject())
 		return formatFatalError("JSONError", "\"libraries\" is not a JSON object.");
@@ -711,6 +834,15 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 
 	ret.metadataLiteralSources = metadataSettings.get("useLiteralContent", Json::Value(false)).asBool();
 
+	if (settings.isMember("statistics"))
+	{
+		if (!settings["statistics"].isBool())
+			return formatFatalError("JSONError", "\"settings.statistics\" must be a Boolean.");
+		ret.statistics = settings["statistics"].asBool();
+		if (ret.statistics)
+			ret.modelCheckerSettings.statistics = make_shared<smt::ModelCheckerStatistics>();
+	}
+
 	Json::Value outputSelection = settings.get("outputSelection", Json::Value());
 
 	if (auto jsonError = checkOutputSelection(outputSelection))
@@ -733,6 +865,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(_inputsAndSettings.remappings);
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
@@ -757,6 +890,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			Error const& err = dynamic_cast<Error const&>(*error);
 
 			errors.append(formatErrorWithException(
+				compilerStack.sourceRegistry(),
 				*error,
 				err.type() == Error::Type::Warning,
 				err.typeName(),
@@ -769,6 +903,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (Error const& _error)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack.sourceRegistry(),
 			_error,
 			false,
 			_error.typeName(),
@@ -789,6 +924,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (CompilerError const& _exception)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack.sourceRegistry(),
 			_exception,
 			false,
 			"CompilerError",
@@ -799,6 +935,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (InternalCompilerError const& _exception)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack.sourceRegistry(),
 			_exception,
 			false,
 			"InternalCompilerError",
@@ -809,6 +946,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (UnimplementedFeatureError const& _exception)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack.sourceRegistry(),
 			_exception,
 			false,
 			"UnimplementedFeatureError",
@@ -869,10 +1007,10 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		Json::Value sourceResult = Json::objectValue;
 		sourceResult["id"] = sourceIndex++;
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			sourceResult["ast"] = astJson(compilerStack, sourceName, false);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
-			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		output["sources"][sourceName] = sourceResult;
+			sourceResult["legacyAST"] = astJson(compilerStack, sourceName, true);
+		output["sources"][sourceName] = std::move(sourceResult);
 	}
 
 	Json::Value contractsOutput = Json::objectValue;
@@ -952,6 +1090,13 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (_inputsAndSettings.statistics)
+		output["statistics"] = statisticsJson(
+			TypeProvider::queryStatistics(),
+			*_inputsAndSettings.modelCheckerSettings.statistics,
+			compilerStack.sourceRegistry()
+		);
+
 	return output;
 }
 
@@ -989,6 +1134,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 			auto err = dynamic_pointer_cast<Error const>(error);
 
 			errors.append(formatErrorWithException(
+				stack.sourceRegistry(),
 				*error,
 				err->type() == Error::Type::Warning,
 				err->typeName(),
@@ -1032,6 +1178,20 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 }
 
 
+Json::Value StandardCompiler::astJson(CompilerStack const& _compilerStack, string const& _sourceName, bool _legacy)
+{
+	ASTJsonConverter converter(_legacy, _compilerStack.sourceIndicesByID());
+	if (m_astPlaceholderPrefix.empty())
+		return converter.toJson(_compilerStack.ast(_sourceName));
+
+	ostringstream json;
+	JsonWriter writer(json, JsonWriter::Format::Compact);
+	converter.write(writer, _compilerStack.ast(_sourceName));
+	string placeholder = m_astPlaceholderPrefix + to_string(m_streamedASTs.size());
+	m_streamedASTs[placeholder] = json.str();
+	return placeholder;
+}
+
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
 	YulStringRepository::reset();
@@ -1081,13 +1241,27 @@ string StandardCompiler::compile(string const& _input) noexcept
 		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
 	}
 
+	// The ASTs are serialised directly and inserted when printing the output. The placeholders
+	// include the hash of the input, so they cannot be part of the output otherwise.
+	m_astPlaceholderPrefix = string(1, '\0') + "ast:" + keccak256(_input).hex() + ":";
+	m_streamedASTs.clear();
 	// cout << "Input: " << input.toStyledString() << endl;
 	Json::Value output = compile(input);
 	// cout << "Output: " << output.toStyledString() << endl;
+	m_astPlaceholderPrefix.clear();
 
 	try
 	{
-		return jsonCompactPrint(output);
+		ostringstream result;
+		JsonWriter writer(result, JsonWriter::Format::Compact);
+		for (auto& ast: m_streamedASTs)
+			writer.replace(ast.first, [&](JsonWriter& _writer) {
+				_writer.compactValue(ast.second);
+				ast.second = string();
+			});
+		writer.value(output);
+		m_streamedASTs.clear();
+		return result.str();
 	}
 	catch (...)
 	{
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
@@ -66,8 +67,10 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
+		ModelCheckerSettings modelCheckerSettings;
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
+		bool statistics = false;
 		Json::Value outputSelection;
 	};
 
@@ -78,7 +81,18 @@ private:
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// @returns the AST of the given source in JSON format or, if the output is serialised
+	/// by this class, a placeholder for it.
+	Json::Value astJson(CompilerStack const& _compilerStack, std::string const& _sourceName, bool _legacy);
+
 	ReadCallback::Callback m_readFile;
+	/// Answers of the SMT solvers that are reused across calls if requested by the input.
+	std::shared_ptr<smt::SMTQueryCache> m_smtQueryCache = std::make_shared<smt::SMTQueryCache>();
+	/// Prefix of the placeholders for ASTs in the output, which is empty if the ASTs are
+	/// to be included in the output directly.
+	std::string m_astPlaceholderPrefix;
+	/// The ASTs in the output by their placeholders, in compact JSON format.
+	std::map<std::string, std::string> m_streamedASTs;
 };
 
 }
@@ -22,6 +22,7 @@
 
 #include <libsolidity/parsing/Parser.h>
 
+#include <libsolidity/ast/ASTArena.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/AsmParser.h>
 #include <libyul/backends/evm/EVMDialect.h>
@@ -47,7 +48,7 @@ class Parser::ASTNodeFactory
 {
 public:
 	explicit ASTNodeFactory(Parser const& _parser):
-		m_parser(_parser), m_location{_parser.position(), -1, _parser.source()} {}
+		m_parser(_parser), m_location{_parser.position(), -1, _parser.sourceId()} {}
 	ASTNodeFactory(Parser const& _parser, ASTPointer<ASTNode> const& _childNode):
 		m_parser(_parser), m_location{_childNode->location()} {}
 
@@ -60,9 +61,11 @@ public:
 	template <class NodeType, typename... Args>
 	ASTPointer<NodeType> createNode(Args&& ... _args)
 	{
-		solAssert(m_location.source, "");
+		solAssert(m_location.hasSource(), "");
 		if (m_location.end < 0)
 			markEndPosition();
+		if (m_parser.m_arena)
+			return m_parser.m_arena->createNode<NodeType>(m_location, std::forward<Args>(_args)...);
 		return make_shared<NodeType>(m_location, std::forward<Args>(_args)...);
 	}
 
@@ -1087,7 +1090,7 @@ ASTPointer<Statement> Parser::parseStatement()
 ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> const& _docString)
 {
 	RecursionGuard recursionGuard(*this);
-	SourceLocation location{position(), -1, source()};
+	SourceLocation location{position(), -1, sourceId()};
 
 	expectToken(Token::Assembly);
 	yul::Dialect const& dialect = yul::EVMDialect::looseAssemblyForEVM(m_evmVersion);
@@ -1104,8 +1107,10 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 	if (block == nullptr)
 		BOOST_THROW_EXCEPTION(FatalError());
 
+	ASTNodeFactory nodeFactory(*this);
 	location.end = block->location.end;
-	return make_shared<InlineAssembly>(location, _docString, dialect, block);
+	nodeFactory.setLocation(location);
+	return nodeFactory.createNode<InlineAssembly>(_docString, dialect, block);
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -1618,7 +1623,7 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 		// Inside expressions "type" is the name of a special, globally-available function.
 		nodeFactory.markEndPosition();
 		m_scanner->next();
-		expression = nodeFactory.createNode<Identifier>(make_shared<ASTString>("type"));
+		expression = nodeFactory.createNode<Identifier>(createString("type"));
 		break;
 	case Token::LParen:
 	case Token::LBrack:
@@ -1843,7 +1848,7 @@ ASTPointer<Expression> Parser::expressionFromIndexAccessStructure(
 		Identifier const& identifier = dynamic_cast<Identifier const&>(*_iap.path[i]);
 		expression = nodeFactory.createNode<MemberAccess>(
 			expression,
-			make_shared<ASTString>(identifier.name())
+			createString(identifier.name())
 		);
 	}
 	for (auto const& index: _iap.indices)
@@ -1871,10 +1876,17 @@ ASTPointer<ASTString> Parser::expectIdentifierToken()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier = createString(m_scanner->currentLiteral());
 	m_scanner->next();
 	return identifier;
 }
 
+ASTPointer<ASTString> Parser::createString(string const& _string)
+{
+	if (m_arena)
+		return m_arena->intern(_string);
+	return make_shared<ASTString>(_string);
+}
+
 }
 }
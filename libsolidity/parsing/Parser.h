@@ -39,13 +39,17 @@ namespace solidity
 class Parser: public langutil::ParserBase
 {
 public:
+	/// @param _arena if given, the nodes are allocated in this arena and the identifiers
+	/// are interned in it, otherwise they are allocated on the heap.
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::EVMVersion _evmVersion,
-		bool _errorRecovery = false
+		bool _errorRecovery = false,
+		std::shared_ptr<ASTArena> _arena = nullptr
 	):
 		ParserBase(_errorReporter, _errorRecovery),
-		m_evmVersion(_evmVersion)
+		m_evmVersion(_evmVersion),
+		m_arena(std::move(_arena))
 	{}
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
@@ -182,6 +186,8 @@ private:
 
 	ASTPointer<ASTString> expectIdentifierToken();
 	ASTPointer<ASTString> getLiteralAndAdvance();
+	/// @returns @a _string as an AST string, interned in the arena if there is one.
+	ASTPointer<ASTString> createString(std::string const& _string);
 	///@}
 
 	/// Creates an empty ParameterList at the current location (used if parameters can be omitted).
@@ -190,6 +196,7 @@ private:
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
 	langutil::EVMVersion m_evmVersion;
+	std::shared_ptr<ASTArena> m_arena;
 };
 
 }
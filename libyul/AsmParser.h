@@ -68,11 +68,11 @@ protected:
 			r.location.start = position();
 			r.location.end = endPosition();
 		}
-		if (!r.location.source)
-			r.location.source = m_scanner->charStream();
+		if (!r.location.hasSource())
+			r.location.sourceId = m_scanner->sourceId();
 		return r;
 	}
-	langutil::SourceLocation location() const { return {position(), endPosition(), m_scanner->charStream()}; }
+	langutil::SourceLocation location() const { return {position(), endPosition(), m_scanner->sourceId()}; }
 
 	Block parseBlock();
 	Statement parseStatement();
@@ -66,7 +66,7 @@ Dialect const& languageToDialect(AssemblyStack::Language _language, EVMVersion _
 	case AssemblyStack::Language::EWasm:
 		return WasmDialect::instance();
 	case AssemblyStack::Language::LLVMIR:
-		return LLVMIRDialect();
+		return LLVMIRDialect::instance();
 	}
 	solAssert(false, "");
 	return Dialect::yul();
@@ -86,6 +86,7 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	m_errors.clear();
 	m_analysisSuccessful = false;
 	m_scanner = make_shared<Scanner>(CharStream(_source, _sourceName));
+	m_sourceRegistry = SourceRegistry(m_scanner->charStream());
 	m_parserResult = ObjectParser(m_errorReporter, languageToDialect(m_language, m_evmVersion)).parse(m_scanner, false);
 	if (!m_errorReporter.errors().empty())
 		return false;
@@ -188,7 +189,7 @@ MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 		EthAssemblyAdapter adapter(assembly);
 		compileEVM(adapter, false, m_optimiserSettings.optimizeStackAllocation);
 		object.bytecode = make_shared<dev::eth::LinkerObject>(assembly.assemble());
-		object.assembly = assembly.assemblyString();
+		object.assembly = assembly.assemblyString({}, &m_sourceRegistry);
 		return object;
 	}
 	case Machine::EVM15:
@@ -209,9 +210,16 @@ MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 		object.assembly = EWasmObjectCompiler::compile(*m_parserResult, dialect);
 		return object;
 	}
-    case Machine::LLVMIR:
-    {
+	case Machine::LLVMIR:
+	{
+		solAssert(m_language == Language::StrictAssembly || m_language == Language::LLVMIR, "");
+		Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+
 		MachineAssemblyObject object;
+		auto result = LLVMIRObjectCompiler::compile(*m_parserResult, dialect, m_optimiserSettings.runYulOptimiser);
+		object.assembly = move(result.first);
+		object.bytecode = make_shared<dev::eth::LinkerObject>();
+		object.bytecode->bytecode = move(result.second);
 		return object;
 	}
 	}
@@ -15,14 +15,15 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 /**
- * Full assembly stack that can support EVM-assembly and Yul as input and EVM, EVM1.5 and
- * eWasm as output.
+ * Full assembly stack that can support EVM-assembly and Yul as input and EVM, EVM1.5,
+ * eWasm or LLVM IR as output.
  */
 
 #pragma once
 
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceRegistry.h>
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
@@ -51,8 +52,8 @@ struct MachineAssemblyObject
 };
 
 /*
- * Full assembly stack that can support EVM-assembly and Yul as input and EVM, EVM1.5 and
- * eWasm as output.
+ * Full assembly stack that can support EVM-assembly and Yul as input and EVM, EVM1.5,
+ * eWasm or LLVM IR as output.
  */
 class AssemblyStack
 {
@@ -73,6 +74,9 @@ public:
 	/// @returns the scanner used during parsing
 	langutil::Scanner const& scanner() const;
 
+	/// @returns the registry of the parsed source, used to look up the sources of source locations.
+	langutil::SourceRegistry const& sourceRegistry() const { return m_sourceRegistry; }
+
 	/// Runs parsing and analysis steps, returns false if input cannot be assembled.
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
@@ -106,6 +110,7 @@ private:
 	dev::solidity::OptimiserSettings m_optimiserSettings;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
+	langutil::SourceRegistry m_sourceRegistry;
 
 	bool m_analysisSuccessful = false;
 	std::shared_ptr<yul::Object> m_parserResult;
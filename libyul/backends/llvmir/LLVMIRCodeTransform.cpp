@@ -1,5 +1,5 @@
 /*
-rThis file is part of solidity.
+	This file is part of solidity.
 
 	solidity is free software: you can redistribute it and/or modify
 	it under the terms of the GNU General Public License as published by
@@ -20,7 +20,9 @@ rThis file is part of solidity.
 
 #include <libyul/backends/llvmir/LLVMIRCodeTransform.h>
 
-#include <libyul/optimiser/NameCollector.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libyul/optimiser/ASTWalker.h>
 
 #include <libyul/AsmData.h>
 #include <libyul/Dialect.h>
@@ -29,75 +31,131 @@ rThis file is part of solidity.
 
 #include <liblangutil/Exceptions.h>
 
-#include <boost/range/adaptor/reversed.hpp>
-#include <boost/range/adaptor/transformed.hpp>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
 
 using namespace std;
 using namespace dev;
 using namespace yul;
 
-string LLVMIRCodeTransform::run(Dialect const& _dialect, yul::Block const& _ast)
+namespace
 {
-	LLVMIRCodeTransform transform(_dialect, _ast);
 
-	for (auto const& s: _ast.statements) {
-		yulAssert(s.type() == typeid(yul::FunctionDefinition),
-		"Expected only function definitions at highest level"
-		);
-		if (s.type() == typeid(yul::FunctionDefinition)) {
-			transform.translateFunction(boost::get<yul::FunctionDefinition>(s));
-		}
-		// TODO: Insert builtin funcs
+/// @returns true if the builtin @a _name does not return to the caller.
+bool terminates(YulString _name)
+{
+	static set<string> const terminatingBuiltins{
+		"stop",
+		"return",
+		"revert",
+		"invalid",
+		"selfdestruct",
+		"eth.finish",
+		"eth.revert",
+		"eth.selfDestruct"
+	};
+	return terminatingBuiltins.count(_name.str());
+}
+
+/**
+ * Collects all function definitions, including nested ones.
+ */
+class FunctionCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override
+	{
+		m_functions.emplace_back(&_function);
+		ASTWalker::operator()(_function);
 	}
-	//return &transform.m_module; // FIXME: return properly
+
+	vector<FunctionDefinition const*> m_functions;
+};
+
 }
 
-void LLVMIRCodeTransform::generateMultiAssignment(
-	unique_ptr<llvm::Value*> _firstValue
+unique_ptr<llvm::Module> LLVMIRCodeTransform::run(
+	llvm::LLVMContext& _context,
+	Dialect const& _dialect,
+	yul::Block const& _ast,
+	string const& _moduleName,
+	bool _countSteps
 )
 {
-	// NOTE: We expect the caller to have correctly positioned the builder before generating assignments.
-	// if (_variableNames.size() == 1) {
-	// 	llvm::Value* alloca = m_builder.CreateAlloca(*_firstValue->getType());
-	// 	m_builder.CreateStore(*_firstValue, alloca);
-	// }
-	llvm::Value* alloca = m_builder.CreateAlloca((*_firstValue)->getType());
-	m_builder.CreateStore(*_firstValue, alloca);
+	LLVMIRCodeTransform transform(_context, _dialect, _moduleName, _countSteps);
+
+	// Since names are unique and functions cannot access variables of enclosing scopes,
+	// nested functions are translated to functions of the module without moving them,
+	// which keeps the blocks that are entered the same as in the Yul code.
+	FunctionCollector collector;
+	collector(_ast);
+
+	// Functions are declared first, since they can be called before their definition.
+	llvm::Function* main = llvm::Function::Create(
+		llvm::FunctionType::get(llvm::Type::getVoidTy(_context), false),
+		llvm::Function::ExternalLinkage,
+		"main",
+		transform.m_module.get()
+	);
+	for (FunctionDefinition const* function: collector.m_functions)
+		transform.declareFunction(*function);
+
+	transform.translateFunction(main, {}, {}, _ast);
+	for (FunctionDefinition const* function: collector.m_functions)
+		transform.translateFunction(
+			transform.m_functions.at(function->name),
+			function->parameters,
+			function->returnVariables,
+			function->body
+		);
 
-	// TODO: multi assignments
-	//for (size_t i = 1; i < _variableNames.size(); i++) {
-	//	llvm::Value* alloca = m_builder.CreateAlloca(/* type of index i of var decls */);
-	//	m_builder.createStore(/* Value of ith expression*/, alloca);
-	//}
+	return move(transform.m_module);
 }
 
-// Creates a basic block containing a set of allocas + stores to append to another block
-llvm::Value* LLVMIRCodeTransform::operator()(VariableDeclaration const& _varDecl)
+void LLVMIRCodeTransform::generateMultiAssignment(
+	vector<YulString> const& _variableNames,
+	llvm::Value* _value
+)
 {
-	// Init declaration block
-	llvm::BasicBlock* ret = llvm::BasicBlock::Create(m_context);
-	m_builder.SetInsertPoint(ret);
-
-	for (auto const& v: _varDecl.variables) {
-		// Create alloca for variable.
-		auto alloca = m_builder.CreateAlloca(m_types.from_yul(v.type), nullptr, v.name.str());
-		m_localVariables.emplace_back(alloca);
+	yulAssert(_value, "Expected a value.");
+	if (_variableNames.size() == 1)
+	{
+		m_builder.CreateStore(_value, m_variables.at(_variableNames.front()));
+		return;
 	}
+	for (size_t i = 0; i < _variableNames.size(); ++i)
+		m_builder.CreateStore(
+			m_builder.CreateExtractValue(_value, {unsigned(i)}),
+			m_variables.at(_variableNames[i])
+		);
+}
 
-	// If a value is assigned, then generate assignment code as well.
-	if (_varDecl.value) {
-		llvm::Value* init_expr = *LLVMIRCodeTransform::visit(*_varDecl.value);
-		generateMultiAssignment(std::make_unique<llvm::Value*>(&*init_expr));
+llvm::Value* LLVMIRCodeTransform::operator()(VariableDeclaration const& _varDecl)
+{
+	llvm::Value* value = _varDecl.value ? visit(*_varDecl.value) : nullptr;
+
+	vector<YulString> variableNames;
+	for (auto const& v: _varDecl.variables)
+	{
+		llvm::AllocaInst* slot = allocateVariable(v.name);
+		// Variables are initialised to zero, also if the declaration is executed repeatedly in a loop.
+		if (!value)
+			m_builder.CreateStore(llvm::ConstantInt::get(m_word, 0), slot);
+		variableNames.emplace_back(v.name);
 	}
-	return ret;
+
+	if (value)
+		generateMultiAssignment(variableNames, value);
+	return {};
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(Assignment const& _assignment)
 {
-	// NOTE: Assumes caller has positioned the builder correctly.
-	auto const& idents = _assignment.variableNames;
-	llvm::Value* init_expr = *LLVMIRCodeTransform::visit(*_assignment.value);
-
+	vector<YulString> variableNames;
+	for (auto const& v: _assignment.variableNames)
+		variableNames.emplace_back(v.name);
+	generateMultiAssignment(variableNames, visit(*_assignment.value));
 	return {};
 }
 
@@ -109,7 +167,8 @@ llvm::Value* LLVMIRCodeTransform::operator()(StackAssignment const&)
 
 llvm::Value* LLVMIRCodeTransform::operator()(ExpressionStatement const& _statement)
 {
-	return visitReturnByValue(_statement.expression);
+	visit(_statement.expression);
+	return {};
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(Label const&)
@@ -126,38 +185,30 @@ llvm::Value* LLVMIRCodeTransform::operator()(FunctionalInstruction const& _f)
 
 llvm::Value* LLVMIRCodeTransform::operator()(FunctionCall const& _call)
 {
-	// TODO: builtin funcs
-	// if (BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name)) {
-	// 	if (_call.functionName.name.str().substr(0, 4) == "eth.") {
-	// 		yulAssert(builtin->returns.size() <= 1, "");
-	// 		if 
-
-	// 	} else if (builtin->literalArguments) {
-
-	// 	}
-	// }
-	
-	// Could be null. 
-	auto func = m_module.getFunction(_call.functionName.name.str());
-	if func {
-		auto prototype = func.getFunctionType();
-		//wip
-	} else {
-		// TODO: pre-insert functions so we know the prototype ahead of time and don't need getOrInsert
-		yulAssert(false, "couldn't find function in module.");
+	vector<llvm::Value*> arguments = visit(_call.arguments);
+
+	if (BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name))
+	{
+		if (builtin->name == "pop"_yulstring)
+			return {};
+		if (llvm::Value* value = builtinInstructions(builtin->name, arguments))
+			return value;
+		return externalCall(*builtin, arguments);
 	}
-	
-	return {};
+
+	yulAssert(m_functions.count(_call.functionName.name), "Function " + _call.functionName.name.str() + " not found.");
+	return m_builder.CreateCall(m_functions.at(_call.functionName.name), arguments);
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(Identifier const& _identifier)
 {
-	return {};
+	yulAssert(m_variables.count(_identifier.name), "Variable " + _identifier.name.str() + " not found.");
+	return m_builder.CreateLoad(m_word, m_variables.at(_identifier.name), _identifier.name.str());
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(Literal const& _literal)
 {
-	return {};
+	return llvm::ConstantInt::get(m_context, llvm::APInt(256, valueOfLiteral(_literal).str(), 10));
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(yul::Instruction const&)
@@ -168,80 +219,485 @@ llvm::Value* LLVMIRCodeTransform::operator()(yul::Instruction const&)
 
 llvm::Value* LLVMIRCodeTransform::operator()(If const& _if)
 {
+	llvm::Value* condition = m_builder.CreateICmpNE(visit(*_if.condition), llvm::ConstantInt::get(m_word, 0));
+	llvm::BasicBlock* body = createBlock("if.body");
+	llvm::BasicBlock* end = createBlock("if.end");
+	m_builder.CreateCondBr(condition, body, end);
+
+	emitBlock(body);
+	(*this)(_if.body);
+	m_builder.CreateBr(end);
+
+	emitBlock(end);
 	return {};
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(Switch const& _switch)
 {
+	llvm::Value* value = visit(*_switch.expression);
+	llvm::BasicBlock* end = createBlock("switch.end");
+	llvm::SwitchInst* switchInstruction = m_builder.CreateSwitch(value, end, _switch.cases.size());
+
+	vector<llvm::BasicBlock*> caseBlocks;
+	for (auto const& c: _switch.cases)
+	{
+		caseBlocks.emplace_back(createBlock(c.value ? "switch.case" : "switch.default"));
+		if (c.value)
+			switchInstruction->addCase(llvm::cast<llvm::ConstantInt>((*this)(*c.value)), caseBlocks.back());
+		else
+			switchInstruction->setDefaultDest(caseBlocks.back());
+	}
+	for (size_t i = 0; i < _switch.cases.size(); ++i)
+	{
+		emitBlock(caseBlocks[i]);
+		(*this)(_switch.cases[i].body);
+		m_builder.CreateBr(end);
+	}
+
+	emitBlock(end);
 	return {};
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(FunctionDefinition const&)
 {
-	yulAssert(false, "Should not have visited here.");
+	// Translated separately by run().
 	return {};
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(ForLoop const& _for)
 {
-
-	return { };
+	visit(_for.pre.statements);
+
+	llvm::BasicBlock* condition = createBlock("for.condition");
+	llvm::BasicBlock* body = createBlock("for.body");
+	llvm::BasicBlock* post = createBlock("for.post");
+	llvm::BasicBlock* end = createBlock("for.end");
+	m_builder.CreateBr(condition);
+
+	emitBlock(condition);
+	m_builder.CreateCondBr(
+		m_builder.CreateICmpNE(visit(*_for.condition), llvm::ConstantInt::get(m_word, 0)),
+		body,
+		end
+	);
+
+	emitBlock(body);
+	m_breakContinueTargets.push({end, post});
+	(*this)(_for.body);
+	m_breakContinueTargets.pop();
+	m_builder.CreateBr(post);
+
+	emitBlock(post);
+	(*this)(_for.post);
+	m_builder.CreateBr(condition);
+
+	emitBlock(end);
+	return {};
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(Break const&)
 {
+	yulAssert(!m_breakContinueTargets.empty(), "");
+	m_builder.CreateBr(m_breakContinueTargets.top().first);
+	startUnreachableBlock();
 	return {};
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(Continue const&)
 {
-	return {}; 
+	yulAssert(!m_breakContinueTargets.empty(), "");
+	m_builder.CreateBr(m_breakContinueTargets.top().second);
+	startUnreachableBlock();
+	return {};
 }
 
 llvm::Value* LLVMIRCodeTransform::operator()(Block const& _block)
 {
+	if (m_countSteps)
+		m_builder.CreateCall(externalFunction(
+			"yul.step",
+			llvm::FunctionType::get(llvm::Type::getVoidTy(m_context), false),
+			false
+		));
+	visit(_block.statements);
 	return {};
 }
 
-unique_ptr<llvm::Value*> LLVMIRCodeTransform::visit(yul::Expression const& _expression)
-{
-	return std::make_unique<llvm::Value*>(boost::apply_visitor(*this, _expression));
-}
-
-llvm::Value* LLVMIRCodeTransform::visitReturnByValue(yul::Expression const& _expression)
+llvm::Value* LLVMIRCodeTransform::visit(yul::Expression const& _expression)
 {
 	return boost::apply_visitor(*this, _expression);
 }
 
 vector<llvm::Value*> LLVMIRCodeTransform::visit(vector<yul::Expression> const& _expressions)
 {
-	vector<llvm::Value*> ret;
-	for (auto const& e: _expressions)
-		ret.emplace_back(visitReturnByValue(e));
+	vector<llvm::Value*> ret(_expressions.size());
+	for (size_t i = _expressions.size(); i > 0; --i)
+		ret[i - 1] = visit(_expressions[i - 1]);
 	return ret;
 }
 
-llvm::Value* LLVMIRCodeTransform::visit(yul::Statement const& _statement)
+void LLVMIRCodeTransform::visit(yul::Statement const& _statement)
 {
-	return boost::apply_visitor(*this, _statement);
+	boost::apply_visitor(*this, _statement);
 }
 
-vector<llvm::Value*> LLVMIRCodeTransform::visit(vector<yul::Statement> const& _statements)
+void LLVMIRCodeTransform::visit(vector<yul::Statement> const& _statements)
 {
-	vector<llvm::Value*> ret;
 	for (auto const& s: _statements)
-		ret.emplace_back(visit(s));
-	return ret;
+		visit(s);
+}
+
+void LLVMIRCodeTransform::declareFunction(yul::FunctionDefinition const& _fun)
+{
+	yulAssert(!m_functions.count(_fun.name), "Function " + _fun.name.str() + " defined twice.");
+	llvm::FunctionType* type = llvm::FunctionType::get(
+		returnType(_fun.returnVariables.size()),
+		vector<llvm::Type*>(_fun.parameters.size(), m_word),
+		false
+	);
+	// A function called "main" is renamed by LLVM to avoid a clash with the entry point.
+	m_functions[_fun.name] = llvm::Function::Create(
+		type,
+		llvm::Function::InternalLinkage,
+		_fun.name.str(),
+		m_module.get()
+	);
 }
 
-void LLVMIRCodeTransform::translateFunction(yul::FunctionDefinition const& _fun)
+void LLVMIRCodeTransform::translateFunction(
+	llvm::Function* _function,
+	TypedNameList const& _parameters,
+	TypedNameList const& _returnVariables,
+	Block const& _body
+)
 {
+	m_currentFunction = _function;
+	m_variables.clear();
+	m_argumentSlots.clear();
+	emitBlock(createBlock("entry"));
+
+	auto argument = m_currentFunction->arg_begin();
+	for (auto const& parameter: _parameters)
+	{
+		argument->setName(parameter.name.str());
+		m_builder.CreateStore(&*argument, allocateVariable(parameter.name));
+		++argument;
+	}
+	for (auto const& returnVariable: _returnVariables)
+		m_builder.CreateStore(llvm::ConstantInt::get(m_word, 0), allocateVariable(returnVariable.name));
+
+	(*this)(_body);
+
+	vector<llvm::Value*> returnValues;
+	for (auto const& returnVariable: _returnVariables)
+		returnValues.emplace_back((*this)(Identifier{returnVariable.location, returnVariable.name}));
+	if (returnValues.empty())
+		m_builder.CreateRetVoid();
+	else if (returnValues.size() == 1)
+		m_builder.CreateRet(returnValues.front());
+	else
+		m_builder.CreateAggregateRet(returnValues.data(), returnValues.size());
+
+	yulAssert(m_breakContinueTargets.empty(), "");
+	m_currentFunction = nullptr;
+}
 
+llvm::Value* LLVMIRCodeTransform::builtinInstructions(YulString _name, vector<llvm::Value*> const& _arguments)
+{
+	string const& name = _name.str();
+	auto arg = [&](size_t _index) { return _arguments.at(_index); };
+	auto constant = [&](uint64_t _value) { return llvm::ConstantInt::get(m_word, _value); };
+	auto fromBool = [&](llvm::Value* _condition) { return m_builder.CreateZExt(_condition, m_word); };
+	auto isZero = [&](llvm::Value* _value) { return m_builder.CreateICmpEQ(_value, constant(0)); };
+
+	if (name == "add")
+		return m_builder.CreateAdd(arg(0), arg(1));
+	else if (name == "sub")
+		return m_builder.CreateSub(arg(0), arg(1));
+	else if (name == "mul")
+		return m_builder.CreateMul(arg(0), arg(1));
+	else if (name == "div" || name == "mod")
+	{
+		// Division by zero results in zero in EVM, but is undefined behaviour in LLVM.
+		llvm::Value* divisorIsZero = isZero(arg(1));
+		llvm::Value* divisor = m_builder.CreateSelect(divisorIsZero, constant(1), arg(1));
+		llvm::Value* result = name == "div" ?
+			m_builder.CreateUDiv(arg(0), divisor) :
+			m_builder.CreateURem(arg(0), divisor);
+		return m_builder.CreateSelect(divisorIsZero, constant(0), result);
+	}
+	else if (name == "sdiv" || name == "smod")
+	{
+		// Dividing the smallest integer by -1 overflows, which is undefined behaviour in LLVM.
+		llvm::Value* divisorIsZero = isZero(arg(1));
+		llvm::Value* divisorIsMinusOne = m_builder.CreateICmpEQ(arg(1), llvm::ConstantInt::getAllOnesValue(m_word));
+		llvm::Value* trivialDivisor = m_builder.CreateOr(divisorIsZero, divisorIsMinusOne);
+		llvm::Value* divisor = m_builder.CreateSelect(trivialDivisor, constant(1), arg(1));
+		if (name == "smod")
+			return m_builder.CreateSelect(trivialDivisor, constant(0), m_builder.CreateSRem(arg(0), divisor));
+		return m_builder.CreateSelect(
+			divisorIsZero,
+			constant(0),
+			m_builder.CreateSelect(divisorIsMinusOne, m_builder.CreateNeg(arg(0)), m_builder.CreateSDiv(arg(0), divisor))
+		);
+	}
+	else if (name == "addmod" || name == "mulmod")
+	{
+		// The intermediate result is not truncated to 256 bits.
+		llvm::IntegerType* wide = llvm::IntegerType::get(m_context, 512);
+		llvm::Value* modulusIsZero = isZero(arg(2));
+		llvm::Value* modulus = m_builder.CreateSelect(modulusIsZero, constant(1), arg(2));
+		llvm::Value* a = m_builder.CreateZExt(arg(0), wide);
+		llvm::Value* b = m_builder.CreateZExt(arg(1), wide);
+		llvm::Value* result = m_builder.CreateURem(
+			name == "addmod" ? m_builder.CreateAdd(a, b) : m_builder.CreateMul(a, b),
+			m_builder.CreateZExt(modulus, wide)
+		);
+		return m_builder.CreateSelect(modulusIsZero, constant(0), m_builder.CreateTrunc(result, m_word));
+	}
+	else if (name == "exp")
+		return m_builder.CreateCall(expFunction(), {arg(0), arg(1)});
+	else if (name == "signextend")
+	{
+		// Extends the sign bit of the byte at position arg(0), counted from the least significant byte.
+		llvm::Value* inRange = m_builder.CreateICmpULT(arg(0), constant(31));
+		llvm::Value* shift = m_builder.CreateSub(
+			constant(248),
+			m_builder.CreateMul(m_builder.CreateSelect(inRange, arg(0), constant(0)), constant(8))
+		);
+		return m_builder.CreateSelect(
+			inRange,
+			m_builder.CreateAShr(m_builder.CreateShl(arg(1), shift), shift),
+			arg(1)
+		);
+	}
+	else if (name == "lt")
+		return fromBool(m_builder.CreateICmpULT(arg(0), arg(1)));
+	else if (name == "gt")
+		return fromBool(m_builder.CreateICmpUGT(arg(0), arg(1)));
+	else if (name == "slt")
+		return fromBool(m_builder.CreateICmpSLT(arg(0), arg(1)));
+	else if (name == "sgt")
+		return fromBool(m_builder.CreateICmpSGT(arg(0), arg(1)));
+	else if (name == "eq")
+		return fromBool(m_builder.CreateICmpEQ(arg(0), arg(1)));
+	else if (name == "iszero")
+		return fromBool(isZero(arg(0)));
+	else if (name == "not")
+		return m_builder.CreateNot(arg(0));
+	else if (name == "and")
+		return m_builder.CreateAnd(arg(0), arg(1));
+	else if (name == "or")
+		return m_builder.CreateOr(arg(0), arg(1));
+	else if (name == "xor")
+		return m_builder.CreateXor(arg(0), arg(1));
+	else if (name == "byte")
+	{
+		// Byte zero is the most significant byte.
+		llvm::Value* inRange = m_builder.CreateICmpULT(arg(0), constant(32));
+		llvm::Value* shift = m_builder.CreateSub(
+			constant(248),
+			m_builder.CreateMul(m_builder.CreateSelect(inRange, arg(0), constant(0)), constant(8))
+		);
+		return m_builder.CreateSelect(
+			inRange,
+			m_builder.CreateAnd(m_builder.CreateLShr(arg(1), shift), constant(0xff)),
+			constant(0)
+		);
+	}
+	// Shifting by the bit width or more results in poison in LLVM, which is not selected.
+	else if (name == "shl")
+		return m_builder.CreateSelect(
+			m_builder.CreateICmpULT(arg(0), constant(256)),
+			m_builder.CreateShl(arg(1), arg(0)),
+			constant(0)
+		);
+	else if (name == "shr")
+		return m_builder.CreateSelect(
+			m_builder.CreateICmpULT(arg(0), constant(256)),
+			m_builder.CreateLShr(arg(1), arg(0)),
+			constant(0)
+		);
+	else if (name == "sar")
+		return m_builder.CreateAShr(
+			arg(1),
+			m_builder.CreateSelect(m_builder.CreateICmpULT(arg(0), constant(256)), arg(0), constant(255))
+		);
+	return nullptr;
+}
+
+llvm::Value* LLVMIRCodeTransform::externalCall(BuiltinFunction const& _builtin, vector<llvm::Value*> const& _arguments)
+{
+	string const& name = _builtin.name.str();
+	yulAssert(_builtin.returns.size() <= 1, "Builtin " + name + " has multiple return values.");
+	bool terminating = terminates(_builtin.name);
+	llvm::Value* result = nullptr;
+
+	if (name.substr(0, 4) == "eth.")
+	{
+		vector<llvm::Type*> parameterTypes;
+		vector<llvm::Value*> arguments;
+		for (size_t i = 0; i < _arguments.size(); ++i)
+		{
+			parameterTypes.emplace_back(m_types.from_yul(_builtin.parameters.at(i)));
+			arguments.emplace_back(m_builder.CreateTrunc(_arguments[i], parameterTypes.back()));
+		}
+		llvm::Type* returnType = _builtin.returns.empty() ?
+			llvm::Type::getVoidTy(m_context) :
+			m_types.from_yul(_builtin.returns.front());
+		llvm::Value* call = m_builder.CreateCall(
+			externalFunction(name, llvm::FunctionType::get(returnType, parameterTypes, false), terminating),
+			arguments
+		);
+		if (!_builtin.returns.empty())
+			result = m_builder.CreateZExt(call, m_word);
+	}
+	else
+	{
+		yulAssert(
+			dynamic_cast<EVMDialect const*>(&m_dialect),
+			"Builtin " + name + " not supported by the LLVM IR backend."
+		);
+		vector<llvm::Value*> arguments;
+		for (size_t i = 0; i < _arguments.size(); ++i)
+		{
+			arguments.emplace_back(argumentSlot(i));
+			m_builder.CreateStore(_arguments[i], arguments.back());
+		}
+		if (!_builtin.returns.empty())
+			arguments.emplace_back(argumentSlot(_arguments.size()));
+		m_builder.CreateCall(
+			externalFunction(
+				"evm." + name,
+				llvm::FunctionType::get(
+					llvm::Type::getVoidTy(m_context),
+					vector<llvm::Type*>(arguments.size(), m_word->getPointerTo()),
+					false
+				),
+				terminating
+			),
+			arguments
+		);
+		if (!_builtin.returns.empty())
+			result = m_builder.CreateLoad(m_word, arguments.back(), name);
+	}
+
+	if (terminating)
+	{
+		m_builder.CreateUnreachable();
+		startUnreachableBlock();
+	}
+	return result;
+}
+
+llvm::Function* LLVMIRCodeTransform::externalFunction(string const& _name, llvm::FunctionType* _type, bool _terminates)
+{
+	llvm::Function* function = m_module->getFunction(_name);
+	if (function && function->isDeclaration())
+		return function;
+	if (function)
+		// Yul functions are only referenced by pointer, so they can make room for the external function.
+		function->setName(_name + ".yul");
+
+	function = llvm::Function::Create(_type, llvm::Function::ExternalLinkage, _name, m_module.get());
+	if (_terminates)
+		function->setDoesNotReturn();
+	return function;
+}
+
+llvm::Function* LLVMIRCodeTransform::expFunction()
+{
+	if (m_expFunction)
+		return m_expFunction;
+
+	m_expFunction = llvm::Function::Create(
+		llvm::FunctionType::get(m_word, {m_word, m_word}, false),
+		llvm::Function::InternalLinkage,
+		"exp",
+		m_module.get()
+	);
+	llvm::BasicBlock* entry = llvm::BasicBlock::Create(m_context, "entry", m_expFunction);
+	llvm::BasicBlock* loop = llvm::BasicBlock::Create(m_context, "loop", m_expFunction);
+	llvm::BasicBlock* body = llvm::BasicBlock::Create(m_context, "body", m_expFunction);
+	llvm::BasicBlock* end = llvm::BasicBlock::Create(m_context, "end", m_expFunction);
+	llvm::Argument* base = m_expFunction->getArg(0);
+	llvm::Argument* exponent = m_expFunction->getArg(1);
+	base->setName("base");
+	exponent->setName("exponent");
+
+	// Square-and-multiply over the bits of the exponent, starting with the least significant one.
+	llvm::IRBuilder<> builder(entry);
+	builder.CreateBr(loop);
+
+	builder.SetInsertPoint(loop);
+	llvm::PHINode* result = builder.CreatePHI(m_word, 2, "result");
+	llvm::PHINode* factor = builder.CreatePHI(m_word, 2, "factor");
+	llvm::PHINode* remaining = builder.CreatePHI(m_word, 2, "remaining");
+	builder.CreateCondBr(builder.CreateICmpEQ(remaining, llvm::ConstantInt::get(m_word, 0)), end, body);
+
+	builder.SetInsertPoint(body);
+	llvm::Value* nextResult = builder.CreateSelect(
+		builder.CreateTrunc(remaining, m_types.bool_type()),
+		builder.CreateMul(result, factor),
+		result
+	);
+	llvm::Value* nextFactor = builder.CreateMul(factor, factor);
+	llvm::Value* nextRemaining = builder.CreateLShr(remaining, 1);
+	builder.CreateBr(loop);
+
+	result->addIncoming(llvm::ConstantInt::get(m_word, 1), entry);
+	result->addIncoming(nextResult, body);
+	factor->addIncoming(base, entry);
+	factor->addIncoming(nextFactor, body);
+	remaining->addIncoming(exponent, entry);
+	remaining->addIncoming(nextRemaining, body);
+
+	builder.SetInsertPoint(end);
+	builder.CreateRet(result);
+
+	return m_expFunction;
+}
+
+llvm::Type* LLVMIRCodeTransform::returnType(size_t _returns)
+{
+	if (_returns == 0)
+		return llvm::Type::getVoidTy(m_context);
+	else if (_returns == 1)
+		return m_word;
+	else
+		return llvm::StructType::get(m_context, vector<llvm::Type*>(_returns, m_word));
+}
+
+llvm::AllocaInst* LLVMIRCodeTransform::allocateVariable(YulString _name)
+{
+	yulAssert(!m_variables.count(_name), "Variable " + _name.str() + " declared twice.");
+	llvm::BasicBlock& entry = m_currentFunction->getEntryBlock();
+	llvm::IRBuilder<> entryBuilder(&entry, entry.begin());
+	return m_variables[_name] = entryBuilder.CreateAlloca(m_word, nullptr, _name.str());
+}
+
+llvm::AllocaInst* LLVMIRCodeTransform::argumentSlot(size_t _index)
+{
+	llvm::BasicBlock& entry = m_currentFunction->getEntryBlock();
+	llvm::IRBuilder<> entryBuilder(&entry, entry.begin());
+	while (m_argumentSlots.size() <= _index)
+		m_argumentSlots.emplace_back(entryBuilder.CreateAlloca(m_word, nullptr, "arg" + to_string(m_argumentSlots.size())));
+	return m_argumentSlots[_index];
+}
+
+llvm::BasicBlock* LLVMIRCodeTransform::createBlock(string const& _name)
+{
+	return llvm::BasicBlock::Create(m_context, _name);
+}
+
+void LLVMIRCodeTransform::emitBlock(llvm::BasicBlock* _block)
+{
+	yulAssert(m_currentFunction, "");
+	m_currentFunction->getBasicBlockList().push_back(_block);
+	m_builder.SetInsertPoint(_block);
 }
 
-void LLVMIRCodeTransform::allocateGlobals(size_t _amount)
+void LLVMIRCodeTransform::startUnreachableBlock()
 {
-	// while (m_globalVariables.size() < _amount) {
-	// 	m_globalVariables.emplace_back(
-	// }
+	emitBlock(createBlock("unreachable"));
 }
@@ -36,8 +36,10 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <libyul/Exceptions.h>
 
+#include <memory>
 #include <stack>
 #include <map>
+#include <vector>
 
 namespace yul
 {
@@ -70,11 +72,11 @@ public:
 			return u8_type();
 		if (type.str() == std::string("s8"))
 			return s8_type();
-		if (type.str() == std::string("u32"))
+		if (type.str() == std::string("u32") || type.str() == std::string("i32"))
 			return u32_type();
 		if (type.str() == std::string("s32"))
 			return s32_type();
-		if (type.str() == std::string("u64"))
+		if (type.str() == std::string("u64") || type.str() == std::string("i64"))
 			return u64_type();
 		if (type.str() == std::string("s64"))
 			return s64_type();
@@ -87,6 +89,7 @@ public:
 		if (type.str() == std::string("s256"))
 			return s256_type();
 		yulAssert(false, "Invalid type");
+		return nullptr;
 	}
 
 	llvm::IntegerType* bool_type() {
@@ -149,10 +152,36 @@ private:
 	llvm::IntegerType* m_s256;
 };
 
+/**
+ * Translates a disambiguated Yul AST into an LLVM module.
+ *
+ * All Yul values are 256 bit integers that live in stack slots of the function they are declared in,
+ * which LLVM promotes to registers. Functions with multiple return variables return a structure.
+ * The code outside of functions is translated to the function "main", which is the only function
+ * of the module that is visible from the outside.
+ *
+ * Arithmetic and comparison builtins of EVM are translated to LLVM instructions. The remaining
+ * builtins of EVM are declared as external functions "evm.<name>" that take pointers to their
+ * arguments followed by a pointer to their result (if any), such that the host does not have to
+ * pass 256 bit integers by value. The builtins "stop", "return", "revert", "invalid" and
+ * "selfdestruct" must not return to the caller. The Ethereum environment interface functions
+ * "eth.<name>" of LLVMIRDialect are declared with their native integer types.
+ *
+ * Optionally, the external function "yul.step" is called whenever a block is entered, which allows
+ * hosts to limit the execution in the same way as the Yul interpreter.
+ */
 class LLVMIRCodeTransform: public boost::static_visitor<llvm::Value*>
 {
 public:
-	static std::string run(Dialect const& _dialect, yul::Block const& _ast);
+	/// Translates @a _ast into a new module in @a _context.
+	/// @param _countSteps if true, "yul.step" is called at the start of every block.
+	static std::unique_ptr<llvm::Module> run(
+		llvm::LLVMContext& _context,
+		Dialect const& _dialect,
+		yul::Block const& _ast,
+		std::string const& _moduleName,
+		bool _countSteps = false
+	);
 
 public:
 	llvm::Value* operator()(yul::Instruction const& _instruction);
@@ -175,46 +204,81 @@ public:
 
 private:
 	LLVMIRCodeTransform(
+		llvm::LLVMContext& _context,
 		Dialect const& _dialect,
-		Block const& _ast
+		std::string const& _moduleName,
+		bool _countSteps
 	):
 		m_dialect(_dialect),
-		m_context(),
-		m_module(llvm::StringRef(std::string("yul")), m_context),
-		m_builder(m_context),
-		m_types(m_context)
+		m_countSteps(_countSteps),
+		m_context(_context),
+		m_module(std::make_unique<llvm::Module>(_moduleName, _context)),
+		m_builder(_context),
+		m_types(_context),
+		m_word(m_types.u256_type())
 	{
 	}
 
-	std::unique_ptr<llvm::Value*> visit(yul::Expression const& _expression);
-	llvm::Value* visitReturnByValue(yul::Expression const& _expression);
+	llvm::Value* visit(yul::Expression const& _expression);
+	/// Visits the expressions in reverse order, which is the evaluation order of function arguments.
 	std::vector<llvm::Value*> visit(std::vector<yul::Expression> const& _expressions);
-	llvm::Value* visit(yul::Statement const& _statement);
-	std::vector<llvm::Value*> visit(std::vector<yul::Statement> const& _statements);
-
-	/// Appends assignments to the current block.
-	/// @param _firstValue the value to be assigned to the first variable. If there
-	///        is more than one variable, the values are taken from m_globalVariables.
-	void generateMultiAssignment(
-		std::unique_ptr<llvm::Value*> _firstValue
+	void visit(yul::Statement const& _statement);
+	void visit(std::vector<yul::Statement> const& _statements);
+
+	/// Stores @a _value in the given variables. If there is more than one variable, @a _value
+	/// is the structure returned by a function.
+	void generateMultiAssignment(std::vector<YulString> const& _variableNames, llvm::Value* _value);
+
+	void declareFunction(yul::FunctionDefinition const& _funDef);
+	/// Generates the body of @a _function from the Yul function with the given parameters,
+	/// return variables and body.
+	void translateFunction(
+		llvm::Function* _function,
+		std::vector<yul::TypedName> const& _parameters,
+		std::vector<yul::TypedName> const& _returnVariables,
+		yul::Block const& _body
 	);
 
-	void translateFunction(yul::FunctionDefinition const& _funDef);
+	/// @returns the value of the builtin @a _name applied to @a _arguments if it can be
+	/// translated to instructions and nullptr otherwise.
+	llvm::Value* builtinInstructions(YulString _name, std::vector<llvm::Value*> const& _arguments);
+	/// Calls the external function implementing the builtin @a _builtin.
+	llvm::Value* externalCall(BuiltinFunction const& _builtin, std::vector<llvm::Value*> const& _arguments);
+	/// @returns the external function @a _name of type @a _type, declaring it if needed.
+	llvm::Function* externalFunction(std::string const& _name, llvm::FunctionType* _type, bool _terminates);
+	/// @returns the function computing the exponentiation of 256 bit integers, generating it if needed.
+	llvm::Function* expFunction();
 
-	/// Makes sure that there are at least @a _amount global variables.
-	void allocateGlobals(size_t _amount);
+	/// @returns the type of a function with @a _returns return variables.
+	llvm::Type* returnType(size_t _returns);
+	/// Creates a zero-initialised stack slot in the entry block of the current function.
+	llvm::AllocaInst* allocateVariable(YulString _name);
+	/// @returns the @a _index th stack slot for the arguments of external functions.
+	llvm::AllocaInst* argumentSlot(size_t _index);
+	/// Creates a block that is added to the current function by emitBlock.
+	llvm::BasicBlock* createBlock(std::string const& _name);
+	/// Appends @a _block to the current function and continues code generation in it.
+	void emitBlock(llvm::BasicBlock* _block);
+	/// Continues code generation after a terminator in a new block without predecessors.
+	void startUnreachableBlock();
 
 	Dialect const& m_dialect;
-
-	std::vector<llvm::Value*> m_localVariables;
-	std::vector<llvm::Value*> m_globalVariables;
-	std::map<YulString, llvm::Value*> m_functionsToImport;
-	std::stack<std::pair<std::string, std::string>> m_breakContinueLabelNames;
-	
-	llvm::LLVMContext m_context;
-	llvm::Module m_module;
+	bool m_countSteps = false;
+	llvm::LLVMContext& m_context;
+	std::unique_ptr<llvm::Module> m_module;
 	llvm::IRBuilder<> m_builder;
 	YulTypeProvider m_types;
+	llvm::IntegerType* m_word = nullptr;
+
+	std::map<YulString, llvm::Function*> m_functions;
+	llvm::Function* m_expFunction = nullptr;
+
+	/// The function being translated, its stack slots and its return variables.
+	llvm::Function* m_currentFunction = nullptr;
+	std::map<YulString, llvm::AllocaInst*> m_variables;
+	std::vector<llvm::AllocaInst*> m_argumentSlots;
+	/// Targets of break and continue in the enclosing for loops.
+	std::stack<std::pair<llvm::BasicBlock*, llvm::BasicBlock*>> m_breakContinueTargets;
 };
 
 }
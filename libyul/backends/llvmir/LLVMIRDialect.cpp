@@ -26,6 +26,36 @@ using namespace yul;
 LLVMIRDialect::LLVMIRDialect():
 	Dialect{AsmFlavour::Strict}
 {
+	for (auto const& name: {
+		"add",
+		"sub",
+		"mul",
+		"div",
+		"sdiv",
+		"mod",
+		"smod",
+		"exp",
+		"signextend",
+		"lt",
+		"gt",
+		"slt",
+		"sgt",
+		"eq",
+		"and",
+		"or",
+		"xor",
+		"byte",
+		"shl",
+		"shr",
+		"sar"
+	})
+		addFunction(name, 2, 1);
+
+	addFunction("iszero", 1, 1);
+	addFunction("not", 1, 1);
+	addFunction("addmod", 3, 1);
+	addFunction("mulmod", 3, 1);
+	addFunction("pop", 1, 0);
 
 	addEthereumExternals();
 }
@@ -35,8 +35,9 @@ struct Object;
 /**
  * Yul dialect for LLVMIR as a backend.
  *
- * Builtin functions are a subset of the llvmir instructions, always implicitly assuming
- * unsigned 64 bit types.
+ * Builtin functions are the arithmetic and comparison operations of EVM on 256 bit words,
+ * which are lowered to LLVM instructions, and the Ethereum environment interface functions,
+ * which are declared as external functions.
  *
  * !This is subject to changes!
  */
@@ -45,8 +46,8 @@ struct LLVMIRDialect: public Dialect
 	LLVMIRDialect();
 
 	BuiltinFunction const* builtin(YulString _name) const override;
-	BuiltinFunction const* discardFunction() const override { return builtin("drop"_yulstring); }
-	BuiltinFunction const* equalityFunction() const override { return builtin("i64.eq"_yulstring); }
+	BuiltinFunction const* discardFunction() const override { return builtin("pop"_yulstring); }
+	BuiltinFunction const* equalityFunction() const override { return builtin("eq"_yulstring); }
 
 	std::set<YulString> fixedFunctionNames() const override { return {"main"_yulstring}; }
 
@@ -15,38 +15,101 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 /**
- * Compiler that transforms Yul Objects to LLVMIR text representation.
+ * Compiler that transforms Yul Objects to LLVM IR.
  */
 
 #include <libyul/backends/llvmir/LLVMIRObjectCompiler.h>
 
 #include <libyul/backends/llvmir/LLVMIRCodeTransform.h>
 
+#include <libyul/optimiser/Disambiguator.h>
+
+#include <libyul/AsmData.h>
 #include <libyul/Object.h>
 #include <libyul/Exceptions.h>
 
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/raw_ostream.h>
+
 using namespace yul;
 using namespace std;
 
-string LLVMIRObjectCompiler::compile(Object& _object, Dialect const& _dialect)
+pair<string, dev::bytes> LLVMIRObjectCompiler::compile(Object const& _object, Dialect const& _dialect, bool _optimize)
 {
-	LLVMIRObjectCompiler compiler(_dialect);
+	LLVMIRObjectCompiler compiler(_dialect, _optimize);
 	return compiler.run(_object);
 }
 
-string LLVMIRObjectCompiler::run(Object& _object)
+unique_ptr<llvm::Module> LLVMIRObjectCompiler::compileModule(
+	llvm::LLVMContext& _context,
+	Object const& _object,
+	Dialect const& _dialect,
+	bool _optimize,
+	bool _countSteps
+)
+{
+	yulAssert(_object.analysisInfo, "No analysis info.");
+	yulAssert(_object.code, "No code.");
+
+	// The code transform expects unique names.
+	Block ast = boost::get<Block>(Disambiguator(_dialect, *_object.analysisInfo)(*_object.code));
+
+	unique_ptr<llvm::Module> module = LLVMIRCodeTransform::run(
+		_context,
+		_dialect,
+		ast,
+		_object.name.str(),
+		_countSteps
+	);
+
+	string errors;
+	llvm::raw_string_ostream errorStream(errors);
+	yulAssert(!llvm::verifyModule(*module, &errorStream), "Invalid LLVM IR generated:\n" + errorStream.str());
+
+	if (_optimize)
+		optimise(*module);
+	return module;
+}
+
+void LLVMIRObjectCompiler::optimise(llvm::Module& _module)
+{
+	llvm::LoopAnalysisManager loopAnalyses;
+	llvm::FunctionAnalysisManager functionAnalyses;
+	llvm::CGSCCAnalysisManager cgsccAnalyses;
+	llvm::ModuleAnalysisManager moduleAnalyses;
+
+	llvm::PassBuilder passBuilder;
+	passBuilder.registerModuleAnalyses(moduleAnalyses);
+	passBuilder.registerCGSCCAnalyses(cgsccAnalyses);
+	passBuilder.registerFunctionAnalyses(functionAnalyses);
+	passBuilder.registerLoopAnalyses(loopAnalyses);
+	passBuilder.crossRegisterProxies(loopAnalyses, functionAnalyses, cgsccAnalyses, moduleAnalyses);
+
+	llvm::ModulePassManager passes = passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+	passes.run(_module, moduleAnalyses);
+}
+
+pair<string, dev::bytes> LLVMIRObjectCompiler::run(Object const& _object)
 {
-	string ret;
+	string text;
 
+	// Data is accessed through the external functions implementing datasize, dataoffset and datacopy.
 	for (auto& subNode: _object.subObjects)
-		if (Object* subObject = dynamic_cast<Object*>(subNode.get()))
-			ret += compile(*subObject, m_dialect);
-		else
-			yulAssert(false, "Data is not yet supported for LLVMIR.");
+		if (Object const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			text += compile(*subObject, m_dialect, m_optimize).first;
 
-	yulAssert(_object.analysisInfo, "No analysis info.");
-	yulAssert(_object.code, "No code.");
-	ret += LLVMIRCodeTransform::run(m_dialect, *_object.code);
+	llvm::LLVMContext context;
+	unique_ptr<llvm::Module> module = compileModule(context, _object, m_dialect, m_optimize);
+
+	llvm::raw_string_ostream textStream(text);
+	module->print(textStream, nullptr);
+	textStream.flush();
+
+	llvm::SmallVector<char, 0> bitcode;
+	llvm::raw_svector_ostream bitcodeStream(bitcode);
+	llvm::WriteBitcodeToFile(*module, bitcodeStream);
 
-	return ret;
+	return {text, dev::bytes(bitcode.begin(), bitcode.end())};
 }
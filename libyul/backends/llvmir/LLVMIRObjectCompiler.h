@@ -15,12 +15,22 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 /**
- * Compiler that transforms Yul Objects to LLVMIR text representation.
+ * Compiler that transforms Yul Objects to LLVM IR.
  */
 
 #pragma once
 
+#include <libdevcore/Common.h>
+
+#include <memory>
 #include <string>
+#include <utility>
+
+namespace llvm
+{
+class LLVMContext;
+class Module;
+}
 
 namespace yul
 {
@@ -30,15 +40,32 @@ struct Dialect;
 class LLVMIRObjectCompiler
 {
 public:
-	static std::string compile(Object& _object, Dialect const& _dialect);
+	/// Translates the code of @a _object and its sub-objects to LLVM IR, optimised by LLVM's
+	/// standard -O2 pipeline if @a _optimize is set.
+	/// @returns the textual representation of all modules and the bitcode of the module of @a _object.
+	static std::pair<std::string, dev::bytes> compile(Object const& _object, Dialect const& _dialect, bool _optimize);
+	/// Translates the code of @a _object (without its sub-objects) into a module in @a _context
+	/// whose function "main" executes the code.
+	/// @param _countSteps if true, the code calls the external function "yul.step" at the start of every block.
+	static std::unique_ptr<llvm::Module> compileModule(
+		llvm::LLVMContext& _context,
+		Object const& _object,
+		Dialect const& _dialect,
+		bool _optimize,
+		bool _countSteps = false
+	);
+	/// Runs the standard -O2 pipeline of LLVM on @a _module.
+	static void optimise(llvm::Module& _module);
 private:
-	LLVMIRObjectCompiler(Dialect const& _dialect):
-		m_dialect(_dialect)
+	LLVMIRObjectCompiler(Dialect const& _dialect, bool _optimize):
+		m_dialect(_dialect),
+		m_optimize(_optimize)
 	{}
 
-	std::string run(Object& _object);
+	std::pair<std::string, dev::bytes> run(Object const& _object);
 
 	Dialect const& m_dialect;
+	bool m_optimize = false;
 };
 
 }
@@ -660,7 +660,7 @@ Object EVMToEWasmTranslator::run(Object const& _object)
 		// TODO the errors here are "wrong" because they have invalid source references!
 		string message;
 		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err, SourceRegistry{});
 		yulAssert(false, message);
 	}
 
@@ -684,7 +684,7 @@ void EVMToEWasmTranslator::parsePolyfill()
 	{
 		string message;
 		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err, SourceRegistry(scanner->charStream()));
 		yulAssert(false, message);
 	}
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <boost/variant.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -33,6 +33,7 @@
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
+#include <libsolidity/formal/SolverProcess.h>
 
 #include <libyul/AssemblyStack.h>
 
@@ -48,6 +49,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
 
 #include <memory>
 
@@ -107,6 +109,7 @@ static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strAstSnapshotDir = "ast-snapshot-dir";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCombinedJson = "combined-json";
@@ -127,9 +130,17 @@ static string const g_strEWasm = "ewasm";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
 static string const g_strLink = "link";
+static string const g_strLLVMIR = "llvmir";
 static string const g_strMachine = "machine";
 static string const g_strMetadata = "metadata";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
+static string const g_strModelCheckerPortfolio = "model-checker-portfolio";
+static string const g_strModelCheckerResourceLimit = "model-checker-resource-limit";
+static string const g_strModelCheckerSolver = "model-checker-solver";
+static string const g_strModelCheckerThreads = "model-checker-threads";
+static string const g_strModelCheckerTimeBudget = "model-checker-time-budget";
+static string const g_strModelCheckerTotalResourceLimit = "model-checker-total-resource-limit";
 static string const g_strNatspecDev = "devdoc";
 static string const g_strNatspecUser = "userdoc";
 static string const g_strOpcodes = "opcodes";
@@ -138,6 +149,7 @@ static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
+static string const g_strParallelAnalysis = "parallel-analysis";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -161,6 +173,7 @@ static string const g_argAssemble = g_strAssemble;
 static string const g_argAst = g_strAst;
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
+static string const g_argAstSnapshotDir = g_strAstSnapshotDir;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
 static string const g_argCombinedJson = g_strCombinedJson;
@@ -177,12 +190,20 @@ static string const g_argLink = g_strLink;
 static string const g_argMachine = g_strMachine;
 static string const g_argMetadata = g_strMetadata;
 static string const g_argMetadataLiteral = g_strMetadataLiteral;
+static string const g_argModelCheckerCacheDir = g_strModelCheckerCacheDir;
+static string const g_argModelCheckerPortfolio = g_strModelCheckerPortfolio;
+static string const g_argModelCheckerResourceLimit = g_strModelCheckerResourceLimit;
+static string const g_argModelCheckerSolver = g_strModelCheckerSolver;
+static string const g_argModelCheckerThreads = g_strModelCheckerThreads;
+static string const g_argModelCheckerTimeBudget = g_strModelCheckerTimeBudget;
+static string const g_argModelCheckerTotalResourceLimit = g_strModelCheckerTotalResourceLimit;
 static string const g_argNatspecDev = g_strNatspecDev;
 static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argParallelAnalysis = g_strParallelAnalysis;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
@@ -217,7 +238,8 @@ static set<string> const g_machineArgs
 {
 	g_strEVM,
 	g_strEVM15,
-	g_streWasm
+	g_streWasm,
+	g_strLLVMIR
 };
 
 static void version()
@@ -708,6 +730,54 @@ Allowed options)",
 		(g_argNoColor.c_str(), "Explicitly disable colored output, disabling terminal auto-detection.")
 		(g_argNewReporter.c_str(), "Enables new diagnostics reporter.")
 		(g_argErrorRecovery.c_str(), "Enables additional parser error recovery.")
+		(g_argParallelAnalysis.c_str(), "Type check the contracts concurrently.")
+		(
+			g_argModelCheckerCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Reuse the answers of the SMT solvers to the queries of the SMTChecker that are stored in "
+			"the given directory and store the answers to new queries there."
+		)
+		(
+			g_argModelCheckerPortfolio.c_str(),
+			po::value<string>()->value_name("mode"),
+			"Select how the SMTChecker queries the available SMT solvers. Either sequential (default), "
+			"first (concurrently, using the first answer) or all (concurrently, using all answers)."
+		)
+		(
+			g_argModelCheckerSolver.c_str(),
+			po::value<string>()->value_name("command"),
+			"Start an SMT solver that reads SMT-LIB2 from its standard input with the given command line, "
+			"e.g. \"z3 -in\", and stream the queries of the SMTChecker to it, keeping it running across queries."
+		)
+		(
+			g_argModelCheckerThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Set how many solver instances the SMTChecker uses to check verification targets concurrently."
+		)
+		(
+			g_argModelCheckerResourceLimit.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Limit the resources the SMT solvers may spend on each query of the SMTChecker, "
+			"instead of limiting the time. Unlike time, resources do not depend on the load of the machine."
+		)
+		(
+			g_argModelCheckerTotalResourceLimit.c_str(),
+			po::value<uint64_t>()->value_name("n"),
+			"Limit the resources the SMT solvers may spend on all queries of each engine of the SMTChecker. "
+			"The remaining verification targets are reported as unknown."
+		)
+		(
+			g_argModelCheckerTimeBudget.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Limit the time in milliseconds each engine of the SMTChecker may spend on all queries. "
+			"The remaining verification targets are reported as unknown."
+		)
+		(
+			g_argAstSnapshotDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Load the analysed ASTs of unchanged source files from snapshots in the given directory "
+			"and store snapshots of the other source files there."
+		)
 		(g_argIgnoreMissingFiles.c_str(), "Ignore missing files.");
 	po::options_description outputComponents("Output Components");
 	outputComponents.add_options()
@@ -878,6 +948,57 @@ bool CommandLineInterface::processInput()
 		m_evmVersion = *versionOption;
 	}
 
+	if (m_args.count(g_argModelCheckerPortfolio))
+	{
+		string portfolioOptionStr = m_args[g_argModelCheckerPortfolio].as<string>();
+		boost::optional<smt::PortfolioMode> portfolioOption = ModelCheckerSettings::portfolioFromString(portfolioOptionStr);
+		if (!portfolioOption)
+		{
+			serr() << "Invalid option for --" << g_argModelCheckerPortfolio << ": " << portfolioOptionStr << endl;
+			return false;
+		}
+		m_modelCheckerSettings.portfolio = *portfolioOption;
+	}
+
+	m_modelCheckerSettings.threads = m_args[g_argModelCheckerThreads].as<unsigned>();
+	if (m_modelCheckerSettings.threads == 0)
+	{
+		serr() << "Invalid option for --" << g_argModelCheckerThreads << ": 0" << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argModelCheckerResourceLimit))
+		m_modelCheckerSettings.queryResourceLimit = m_args[g_argModelCheckerResourceLimit].as<unsigned>();
+	if (m_args.count(g_argModelCheckerTotalResourceLimit))
+		m_modelCheckerSettings.totalResourceLimit = m_args[g_argModelCheckerTotalResourceLimit].as<uint64_t>();
+	if (m_args.count(g_argModelCheckerTimeBudget))
+		m_modelCheckerSettings.timeBudget = m_args[g_argModelCheckerTimeBudget].as<unsigned>();
+	for (auto const& limit: {
+		make_pair(g_argModelCheckerResourceLimit, uint64_t(m_modelCheckerSettings.queryResourceLimit.value_or(1))),
+		make_pair(g_argModelCheckerTotalResourceLimit, m_modelCheckerSettings.totalResourceLimit.value_or(1)),
+		make_pair(g_argModelCheckerTimeBudget, uint64_t(m_modelCheckerSettings.timeBudget.value_or(1)))
+	})
+		if (limit.second == 0)
+		{
+			serr() << "Invalid option for --" << limit.first << ": 0" << endl;
+			return false;
+		}
+
+	if (m_args.count(g_argModelCheckerSolver))
+	{
+		m_modelCheckerSettings.solverCommand = m_args[g_argModelCheckerSolver].as<string>();
+		if (!smt::SolverProcess::available(m_modelCheckerSettings.solverCommand))
+		{
+			serr() << "Invalid option for --" << g_argModelCheckerSolver << ": SMT solver not found." << endl;
+			return false;
+		}
+	}
+
+	if (m_args.count(g_argModelCheckerCacheDir))
+		m_modelCheckerSettings.queryCache = make_shared<smt::SMTQueryCache>(
+			m_args[g_argModelCheckerCacheDir].as<string>()
+		);
+
 	if (m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul))
 	{
 		// switch to assembly mode
@@ -896,6 +1017,8 @@ bool CommandLineInterface::processInput()
 				targetMachine = Machine::EVM15;
 			else if (machine == g_streWasm)
 				targetMachine = Machine::eWasm;
+			else if (machine == g_strLLVMIR)
+				targetMachine = Machine::LLVMIR;
 			else
 			{
 				serr() << "Invalid option for --machine: " << machine << endl;
@@ -930,9 +1053,9 @@ bool CommandLineInterface::processInput()
 
 	unique_ptr<SourceReferenceFormatter> formatter;
 	if (m_args.count(g_argNewReporter))
-		formatter = make_unique<SourceReferenceFormatterHuman>(serr(false), m_coloredOutput);
+		formatter = make_unique<SourceReferenceFormatterHuman>(serr(false), m_compiler->sourceRegistry(), m_coloredOutput);
 	else
-		formatter = make_unique<SourceReferenceFormatter>(serr(false));
+		formatter = make_unique<SourceReferenceFormatter>(serr(false), m_compiler->sourceRegistry());
 
 	try
 	{
@@ -945,7 +1068,21 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		if (m_args.count(g_argErrorRecovery))
 			m_compiler->setParserErrorRecovery(true);
+		if (m_args.count(g_argParallelAnalysis))
+			m_compiler->setParallelAnalysis(true);
+		boost::filesystem::path snapshotDir;
+		if (m_args.count(g_argAstSnapshotDir))
+		{
+			snapshotDir = m_args[g_argAstSnapshotDir].as<string>();
+			m_compiler->setASTSnapshotCallback([=](h256 const& _sourceHash) {
+				boost::filesystem::path snapshotPath = snapshotDir / (_sourceHash.hex() + ".snapshot");
+				if (!boost::filesystem::is_regular_file(snapshotPath))
+					return bytes();
+				return asBytes(readFileAsString(snapshotPath.string()));
+			});
+		}
 		m_compiler->setEVMVersion(m_evmVersion);
+		m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
 		// TODO: Perhaps we should not compile unless requested
 
 		m_compiler->enableIRGeneration(m_args.count(g_argIR));
@@ -967,6 +1104,21 @@ bool CommandLineInterface::processInput()
 
 		if (!successful)
 			return false;
+
+		if (!snapshotDir.empty())
+		{
+			boost::filesystem::create_directories(snapshotDir);
+			for (auto const& sourceName: m_compiler->sourceNames())
+				if (!m_compiler->loadedFromSnapshot(sourceName))
+				{
+					bytes snapshot = m_compiler->astSnapshot(sourceName);
+					string snapshotName = keccak256(m_compiler->scanner(sourceName).source()).hex() + ".snapshot";
+					ofstream outFile((snapshotDir / snapshotName).string(), ios::binary);
+					outFile.write(reinterpret_cast<char const*>(snapshot.data()), snapshot.size());
+					if (!outFile)
+						serr() << "Could not write AST snapshot of " << sourceName << "." << endl;
+				}
+		}
 	}
 	catch (CompilerError const& _exception)
 	{
@@ -1080,24 +1232,40 @@ void CommandLineInterface::handleCombinedJSON()
 			output[g_strSourceList].append(source);
 	}
 
+	ostringstream json;
+	bool toFile = m_args.count(g_argOutputDir);
+	JsonWriter writer(
+		toFile ? json : sout(),
+		m_args.count(g_argPrettyJson) ? JsonWriter::Format::Pretty : JsonWriter::Format::Compact
+	);
 	if (requests.count(g_strAst))
 	{
+		// The ASTs are written to the output directly instead of placeholders, which include
+		// the hash of the sources and thus cannot be part of the output otherwise.
+		string sources;
+		for (auto const& sourceCode: m_sourceCodes)
+			sources += keccak256(sourceCode.first).hex() + keccak256(sourceCode.second).hex();
+		string placeholderPrefix = string(1, '\0') + "ast:" + keccak256(sources).hex() + ":";
 		bool legacyFormat = !requests.count(g_strCompactJSON);
 		output[g_strSources] = Json::Value(Json::objectValue);
 		for (auto const& sourceCode: m_sourceCodes)
 		{
-			ASTJsonConverter converter(legacyFormat, m_compiler->sourceIndices());
+			string placeholder = placeholderPrefix + sourceCode.first;
 			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			output[g_strSources][sourceCode.first]["AST"] = placeholder;
+			string const& sourceName = sourceCode.first;
+			writer.replace(placeholder, [=](JsonWriter& _writer) {
+				ASTJsonConverter(legacyFormat, m_compiler->sourceIndicesByID()).write(_writer, m_compiler->ast(sourceName));
+			});
 		}
 	}
 
-	string json = m_args.count(g_argPrettyJson) ? dev::jsonPrettyPrint(output) : dev::jsonCompactPrint(output);
+	writer.value(output);
 
-	if (m_args.count(g_argOutputDir))
-		createJson("combined", json);
+	if (toFile)
+		createJson("combined", json.str());
 	else
-		sout() << json << endl;
+		sout() << endl;
 }
 
 void CommandLineInterface::handleAst(string const& _argStr)
@@ -1145,7 +1313,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 				}
 				else
 				{
-					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first));
+					ASTJsonConverter(legacyFormat, m_compiler->sourceIndicesByID()).print(data, m_compiler->ast(sourceCode.first));
 					postfix += "_json";
 				}
 				boost::filesystem::path path(sourceCode.first);
@@ -1168,7 +1336,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 					printer.print(sout());
 				}
 				else
-					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceCode.first));
+					ASTJsonConverter(legacyFormat, m_compiler->sourceIndicesByID()).print(sout(), m_compiler->ast(sourceCode.first));
 			}
 		}
 	}
@@ -1321,9 +1489,9 @@ bool CommandLineInterface::assemble(
 		auto const& stack = sourceAndStack.second;
 		unique_ptr<SourceReferenceFormatter> formatter;
 		if (m_args.count(g_argNewReporter))
-			formatter = make_unique<SourceReferenceFormatterHuman>(serr(false), m_coloredOutput);
+			formatter = make_unique<SourceReferenceFormatterHuman>(serr(false), stack.sourceRegistry(), m_coloredOutput);
 		else
-			formatter = make_unique<SourceReferenceFormatter>(serr(false));
+			formatter = make_unique<SourceReferenceFormatter>(serr(false), stack.sourceRegistry());
 
 		for (auto const& error: stack.errors())
 		{
@@ -1342,6 +1510,7 @@ bool CommandLineInterface::assemble(
 		string machine =
 			_targetMachine == yul::AssemblyStack::Machine::EVM ? "EVM" :
 			_targetMachine == yul::AssemblyStack::Machine::EVM15 ? "EVM 1.5" :
+			_targetMachine == yul::AssemblyStack::Machine::LLVMIR ? "LLVM IR" :
 			"eWasm";
 		sout() << endl << "======= " << src.first << " (" << machine << ") =======" << endl;
 		yul::AssemblyStack& stack = assemblyStacks[src.first];
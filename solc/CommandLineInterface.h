@@ -111,6 +111,8 @@ private:
 	std::unique_ptr<dev::solidity::CompilerStack> m_compiler;
 	/// EVM version to use
 	langutil::EVMVersion m_evmVersion;
+	/// Settings of the model checking engines
+	ModelCheckerSettings m_modelCheckerSettings;
 	/// Whether or not to colorize diagnostics output.
 	bool m_coloredOutput = true;
 };
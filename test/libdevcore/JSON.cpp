@@ -23,6 +23,8 @@
 
 #include <test/Options.h>
 
+#include <sstream>
+
 using namespace std;
 
 namespace dev
@@ -145,6 +147,63 @@ BOOST_AUTO_TEST_CASE(parse_json_strict)
 	BOOST_CHECK(json[0] == "\x80\xec\x80");
 }
 
+BOOST_AUTO_TEST_CASE(json_writer)
+{
+	Json::Value json;
+	json["1"] = 1;
+	json["2"] = "2 \" \\ \n ä \x7f";
+	json["3"]["3.1"] = Json::arrayValue;
+	json["3"]["3.2"] = Json::objectValue;
+	json["3"]["3.3"] = Json::Value(string("a\0b", 3));
+	json["4"].append(Json::nullValue);
+	json["4"].append(-1);
+	json["4"].append(true);
+	json["4"].append(Json::arrayValue);
+	json["4"][3].append("x");
+	json["4"][3].append(Json::objectValue);
+	json["4"].append(json["3"]);
+	json["aa"] = Json::UInt64(-1);
+	json["a"] = "";
+
+	auto print = [&](JsonWriter::Format _format) {
+		stringstream output;
+		JsonWriter writer(output, _format);
+		writer.value(json);
+		return output.str();
+	};
+	stringstream styled;
+	styled << json;
+	BOOST_CHECK_EQUAL(print(JsonWriter::Format::Compact), jsonCompactPrint(json));
+	BOOST_CHECK_EQUAL(print(JsonWriter::Format::Pretty), jsonPrettyPrint(json));
+	BOOST_CHECK_EQUAL(print(JsonWriter::Format::Styled), styled.str());
+}
+
+BOOST_AUTO_TEST_CASE(json_writer_replace)
+{
+	Json::Value json;
+	json["a"] = "placeholder";
+	json["b"].append("placeholder");
+	json["c"] = "other";
+
+	stringstream output;
+	JsonWriter writer(output, JsonWriter::Format::Pretty);
+	writer.replace("placeholder", [](JsonWriter& _writer) {
+		_writer.beginObject();
+		_writer.key("x");
+		_writer.beginArray();
+		_writer.value(1);
+		_writer.endArray();
+		_writer.endObject();
+	});
+	writer.value(json);
+
+	Json::Value replaced;
+	replaced["x"].append(1);
+	json["a"] = replaced;
+	json["b"][0] = replaced;
+	BOOST_CHECK_EQUAL(output.str(), jsonPrettyPrint(json));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the parallelFor function
+ */
+
+#include <libdevcore/Parallel.h>
+
+#include <test/Options.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(Parallel)
+
+BOOST_AUTO_TEST_CASE(empty_input)
+{
+	size_t calls = 0;
+	parallelFor(0, [&](size_t) { ++calls; });
+	BOOST_CHECK_EQUAL(calls, 0);
+}
+
+BOOST_AUTO_TEST_CASE(all_indices_visited_once)
+{
+	vector<size_t> results(1000, 0);
+	parallelFor(results.size(), [&](size_t _index) { results[_index] += _index * 2; });
+	for (size_t i = 0; i < results.size(); ++i)
+		BOOST_CHECK_EQUAL(results[i], i * 2);
+}
+
+BOOST_AUTO_TEST_CASE(exception_is_rethrown)
+{
+	BOOST_CHECK_THROW(
+		parallelFor(100, [](size_t _index) { if (_index == 42) throw runtime_error("fail"); }),
+		runtime_error
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -56,13 +56,16 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 {
 	Assembly _assembly;
 	auto root_asm = make_shared<CharStream>("", "root.asm");
-	_assembly.setSourceLocation({1, 3, root_asm});
+	_assembly.setSourceLocation({1, 3, root_asm->sourceId()});
 
 	Assembly _subAsm;
 	auto sub_asm = make_shared<CharStream>("", "sub.asm");
-	_subAsm.setSourceLocation({6, 8, sub_asm});
+	_subAsm.setSourceLocation({6, 8, sub_asm->sourceId()});
 	_subAsm.append(Instruction::INVALID);
 	shared_ptr<Assembly> _subAsmPtr = make_shared<Assembly>(_subAsm);
+	SourceRegistry sources;
+	sources.add(root_asm);
+	sources.add(sub_asm);
 
 	// Tag
 	auto tag = _assembly.newTag();
@@ -103,7 +106,7 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 		"fe010203044266eeaa"
 	);
 	BOOST_CHECK_EQUAL(
-		_assembly.assemblyString(),
+		_assembly.assemblyString({}, &sources),
 		"    /* \"root.asm\":1:3   */\n"
 		"tag_1:\n"
 		"  keccak256(0x02, 0x01)\n"
@@ -148,6 +151,30 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(tag_relaxation)
+{
+	auto assembleTail = [](bool _relax)
+	{
+		Assembly assembly;
+		AssemblyItem early = assembly.newTag();
+		AssemblyItem late = assembly.newTag();
+		assembly.append(early);
+		for (size_t i = 0; i < 300; ++i)
+			assembly.append(Instruction::STOP);
+		assembly.appendJump(early);
+		assembly.appendJump(late);
+		assembly.append(late);
+		Assembly::OptimiserSettings settings;
+		settings.runTagRelaxation = _relax;
+		assembly.optimise(settings);
+		return assembly.assemble().toHex().substr(2 * 301);
+	};
+	// All tags use the width needed by the largest position.
+	BOOST_CHECK_EQUAL(assembleTail(false), "61000056610135565b");
+	// Each tag uses the width needed by its own position.
+	BOOST_CHECK_EQUAL(assembleTail(true), "600056610134565b");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -27,6 +27,7 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/BlockLayoutOptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -53,7 +54,7 @@ namespace
 		// add dummy locations to each item so that we can check that they are not deleted
 		AssemblyItems input = _input;
 		for (AssemblyItem& item: input)
-			item.setLocation({1, 3, nullptr});
+			item.setLocation({1, 3, -1});
 		return input;
 	}
 
@@ -1158,6 +1159,207 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(block_layout_single_predecessor)
+{
+	AssemblyItems items{
+		u256(1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(3),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	AssemblyItems expectation{
+		u256(1),
+		u256(2),
+		u256(3),
+		Instruction::STOP
+	};
+	BlockLayoutOptimiser layout(items, false, 200);
+	BOOST_REQUIRE(layout.optimise({}));
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!layout.optimise({}));
+}
+
+BOOST_AUTO_TEST_CASE(block_layout_tag_referenced_from_outside)
+{
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		Instruction::STOP
+	};
+	BlockLayoutOptimiser layout(items, false, 200);
+	BOOST_REQUIRE(layout.optimise({1}));
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(block_layout_jump_threading)
+{
+	AssemblyItems items{
+		u256(7),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(5),
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		u256(7),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(Tag, 2),
+		u256(5),
+		Instruction::STOP
+	};
+	BlockLayoutOptimiser layout(items, false, 200);
+	BOOST_REQUIRE(layout.optimise({}));
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(block_layout_jump_threading_cycle)
+{
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	// The jumps are not threaded, but tag 2 is placed after tag 1.
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	BlockLayoutOptimiser layout(items, false, 200);
+	BOOST_REQUIRE(layout.optimise({}));
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!layout.optimise({}));
+}
+
+BOOST_AUTO_TEST_CASE(block_layout_prefers_loop)
+{
+	// Both the entry and the loop body jump to tag 1. Since the loop
+	// is executed more often, tag 1 is placed after the loop body.
+	AssemblyItems items{
+		u256(0),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		u256(0),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		AssemblyItem(Tag, 1),
+		u256(1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		Instruction::STOP
+	};
+	BlockLayoutOptimiser layout(items, false, 200);
+	BOOST_REQUIRE(layout.optimise({}));
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(block_layout_tail_duplication)
+{
+	AssemblyItems items{
+		u256(1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		AssemblyItem(PushTag, 9),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		AssemblyItem(PushTag, 9),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 9),
+		u256(0x20),
+		u256(0),
+		Instruction::MSTORE,
+		u256(0x20),
+		u256(0),
+		Instruction::REVERT
+	};
+	AssemblyItems const revertBlock{u256(0x20), u256(0), Instruction::MSTORE, u256(0x20), u256(0), Instruction::REVERT};
+
+	// Many runs: the block is copied to the second jump.
+	AssemblyItems runtimeItems = items;
+	AssemblyItems expectation{u256(1), AssemblyItem(PushTag, 2), Instruction::JUMPI};
+	expectation += revertBlock;
+	expectation += AssemblyItems{AssemblyItem(Tag, 2), u256(2)};
+	expectation += revertBlock;
+	BlockLayoutOptimiser runtimeLayout(runtimeItems, false, 200);
+	BOOST_REQUIRE(runtimeLayout.optimise({}));
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		runtimeItems.begin(), runtimeItems.end(),
+		expectation.begin(), expectation.end()
+	);
+
+	// Creation code is only run once: the block is not copied.
+	AssemblyItems creationItems = items;
+	expectation = AssemblyItems{u256(1), AssemblyItem(PushTag, 2), Instruction::JUMPI, AssemblyItem(Tag, 9)};
+	expectation += revertBlock;
+	expectation += AssemblyItems{AssemblyItem(Tag, 2), u256(2), AssemblyItem(PushTag, 9), Instruction::JUMP};
+	BlockLayoutOptimiser creationLayout(creationItems, true, 200);
+	BOOST_REQUIRE(creationLayout.optimise({}));
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		creationItems.begin(), creationItems.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -25,6 +25,10 @@
 
 #include <test/Options.h>
 
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
 namespace langutil
 {
 namespace test
@@ -47,6 +51,86 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(bulk_advance)
+{
+	std::string const whitespace = " \t\r\n  \n\t \r  \t \n  \t ";
+	std::string const identifier = "identifier_$09AbcdefghijklmnopqrstuvwxyZ";
+	std::string const text = "text with 'quote' and \\ backslash \xc2\x85";
+	CharStream source(whitespace + identifier + "+" + text + "*", "source");
+
+	BOOST_CHECK_EQUAL(source.advancePastWhitespace(), 'i');
+	BOOST_CHECK_EQUAL(source.position(), int(whitespace.size()));
+	BOOST_CHECK_EQUAL(source.advancePastWhitespace(), 'i');
+	BOOST_CHECK_EQUAL(source.advancePastIdentifierPart(), '+');
+	BOOST_CHECK_EQUAL(source.position(), int(whitespace.size() + identifier.size()));
+	BOOST_CHECK_EQUAL(source.advanceAndGet(), 't');
+	BOOST_CHECK_EQUAL(source.advanceToLineBreakOr('\'', '\\'), '\'');
+	BOOST_CHECK_EQUAL(source.advanceToLineBreakOr('"', '\\'), '\\');
+	BOOST_CHECK_EQUAL(uint8_t(source.advanceToLineBreakOr('"', '"')), 0xc2);
+	BOOST_CHECK_EQUAL(source.advanceTo('*'), '*');
+	BOOST_CHECK_EQUAL(source.advanceTo('#'), 0);
+	BOOST_CHECK(source.isPastEndOfInput());
+	BOOST_CHECK_EQUAL(source.advancePastWhitespace(), 0);
+	BOOST_CHECK_EQUAL(source.advancePastIdentifierPart(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(memory_mapped)
+{
+	boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	std::string const content = "contract C {}\n";
+	{
+		std::ofstream file(path.string(), std::ios::binary);
+		file << content;
+	}
+	CharStream source = CharStream::fromFile(path.string(), "source");
+	BOOST_CHECK_EQUAL(source.name(), "source");
+	BOOST_CHECK_EQUAL(std::string(source.data(), source.size()), content);
+	BOOST_CHECK_EQUAL(source.source(), content);
+	BOOST_CHECK_EQUAL(source.setPosition(content.size()), 0);
+	CharStream copy = source;
+	BOOST_CHECK_EQUAL(copy.data(), source.data());
+	boost::filesystem::remove(path);
+
+	CharStream missing = CharStream::fromFile(path.string(), "missing");
+	BOOST_CHECK_EQUAL(missing.size(), 0);
+	BOOST_CHECK_EQUAL(missing.get(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(line_column)
+{
+	CharStream source("\nfirst line\n\nsecond\r\nlast", "source");
+	BOOST_CHECK(source.translatePositionToLineColumn(0) == std::make_tuple(0, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(1) == std::make_tuple(1, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(6) == std::make_tuple(1, 5));
+	BOOST_CHECK(source.translatePositionToLineColumn(11) == std::make_tuple(1, 10));
+	BOOST_CHECK(source.translatePositionToLineColumn(12) == std::make_tuple(2, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(20) == std::make_tuple(3, 7));
+	BOOST_CHECK(source.translatePositionToLineColumn(23) == std::make_tuple(4, 2));
+	BOOST_CHECK(source.translatePositionToLineColumn(1000) == std::make_tuple(4, 4));
+
+	BOOST_CHECK_EQUAL(source.lineAtPosition(0), "first line");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(1), "first line");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(2), "first line");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(12), "");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(13), "second\r");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(15), "second\r");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(1000), "last");
+
+	std::vector<int> positions;
+	for (int i = 25; i >= 0; i -= 3)
+		positions.push_back(i);
+	for (int i = 0; i < 25; i += 2)
+		positions.push_back(i);
+	auto lineColumns = source.translatePositionsToLineColumns(positions);
+	BOOST_REQUIRE_EQUAL(lineColumns.size(), positions.size());
+	for (size_t i = 0; i < positions.size(); ++i)
+		BOOST_CHECK(lineColumns[i] == source.translatePositionToLineColumn(positions[i]));
+
+	CharStream empty;
+	BOOST_CHECK(empty.translatePositionToLineColumn(3) == std::make_tuple(0, 0));
+	BOOST_CHECK_EQUAL(empty.lineAtPosition(3), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
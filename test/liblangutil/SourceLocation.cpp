@@ -21,6 +21,7 @@
  */
 
 #include <liblangutil/SourceLocation.h>
+#include <liblangutil/SourceRegistry.h>
 
 #include <test/Options.h>
 
@@ -33,9 +34,9 @@ BOOST_AUTO_TEST_SUITE(SourceLocationTest)
 
 BOOST_AUTO_TEST_CASE(test_fail)
 {
-	auto const source = std::make_shared<CharStream>("", "source");
-	auto const sourceA = std::make_shared<CharStream>("", "sourceA");
-	auto const sourceB = std::make_shared<CharStream>("", "sourceB");
+	int const source = 0;
+	int const sourceA = 1;
+	int const sourceB = 2;
 
 	BOOST_CHECK(SourceLocation{} == SourceLocation{});
 	BOOST_CHECK((SourceLocation{0, 3, sourceA} != SourceLocation{0, 3, sourceB}));
@@ -45,6 +46,25 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	BOOST_CHECK((SourceLocation{3, 7, sourceA} < SourceLocation{4, 6, sourceB}));
 }
 
+BOOST_AUTO_TEST_CASE(registry)
+{
+	auto const sourceA = std::make_shared<CharStream>("contract A {}", "sourceA");
+	auto const sourceB = std::make_shared<CharStream>("contract B {}", "sourceB");
+	BOOST_CHECK(sourceA->sourceId() >= 0);
+	BOOST_CHECK(sourceA->sourceId() != sourceB->sourceId());
+	BOOST_CHECK_EQUAL(CharStream(*sourceA).sourceId(), sourceA->sourceId());
+	BOOST_CHECK_EQUAL(CharStream().sourceId(), -1);
+
+	SourceRegistry registry(sourceA);
+	BOOST_CHECK(registry.charStream(sourceA->sourceId()) == sourceA.get());
+	BOOST_CHECK(registry.charStream(sourceB->sourceId()) == nullptr);
+	BOOST_CHECK(registry.charStream(SourceLocation{}) == nullptr);
+	registry.add(sourceB);
+	BOOST_CHECK(registry.charStream(SourceLocation{0, 8, sourceB->sourceId()}) == sourceB.get());
+	BOOST_CHECK_EQUAL(registry.name(sourceB->sourceId()), "sourceB");
+	BOOST_CHECK_EQUAL(registry.name(-1), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
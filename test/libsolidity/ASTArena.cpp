@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the memory area of AST nodes.
+ */
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <test/Options.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace langutil;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ASTArenaTest)
+
+BOOST_AUTO_TEST_CASE(allocation_alignment)
+{
+	auto arena = ASTArena::create();
+	for (size_t alignment: {1, 2, 4, 8, 16, 32})
+	{
+		void* memory = arena->allocate(3, alignment);
+		BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(memory) % alignment, 0);
+	}
+	// Larger than a block.
+	void* large = arena->allocate(1024 * 1024, 8);
+	BOOST_CHECK(large);
+	BOOST_CHECK(arena->bytesReserved() >= arena->bytesUsed());
+	BOOST_CHECK(arena->bytesUsed() >= 1024 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	auto arena = ASTArena::create();
+	ASTPointer<ASTString> a = arena->intern("x");
+	ASTPointer<ASTString> b = arena->intern(string("x"));
+	ASTPointer<ASTString> c = arena->intern("y");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK_EQUAL(*a, "x");
+	BOOST_CHECK_EQUAL(*c, "y");
+}
+
+BOOST_AUTO_TEST_CASE(parse_into_arena)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	auto scanner = make_shared<Scanner>(CharStream(
+		"contract C { uint x; function f(uint y) public returns (uint) { return x + y; } }",
+		""
+	));
+	auto arena = ASTArena::create();
+	ASTPointer<SourceUnit> ast = Parser(errorReporter, EVMVersion(), false, arena).parse(scanner);
+	BOOST_REQUIRE(ast);
+	BOOST_CHECK(errors.empty());
+
+	auto const* contract = dynamic_cast<ContractDefinition const*>(ast->nodes().front().get());
+	BOOST_REQUIRE(contract);
+	BOOST_CHECK(contract->name() == "C");
+	BOOST_CHECK(arena->intern("C").get() == &contract->name());
+	BOOST_REQUIRE_EQUAL(contract->definedFunctions().size(), 1);
+	FunctionDefinition const& function = *contract->definedFunctions().front();
+	function.annotation().superFunction = &function;
+	BOOST_CHECK(function.annotation().superFunction == &function);
+	BOOST_CHECK(arena->bytesUsed() > 0);
+
+	// The nodes keep the arena alive.
+	arena.reset();
+	BOOST_CHECK(function.name() == "f");
+	BOOST_CHECK(function.annotation().superFunction == &function);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -18,6 +18,7 @@
 #include <test/libsolidity/ASTJSONTest.h>
 #include <test/Options.h>
 #include <libdevcore/AnsiColorized.h>
+#include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatterHuman.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -95,19 +96,18 @@ TestCase::TestResult ASTJSONTest::run(ostream& _stream, string const& _linePrefi
 	CompilerStack c;
 
 	StringMap sources;
-	map<string, unsigned> sourceIndices;
 	for (size_t i = 0; i < m_sources.size(); i++)
-	{
 		sources[m_sources[i].first] = m_sources[i].second;
-		sourceIndices[m_sources[i].first] = i + 1;
-	}
 	c.setSources(sources);
+	map<int, unsigned> sourceIndices;
+	for (size_t i = 0; i < m_sources.size(); i++)
+		sourceIndices[c.scanner(m_sources[i].first).sourceId()] = i + 1;
 	c.setEVMVersion(dev::test::Options::get().evmVersion());
 	if (c.parse())
 		c.analyze();
 	else
 	{
-		SourceReferenceFormatterHuman formatter(_stream, _formatted);
+		SourceReferenceFormatterHuman formatter(_stream, c.sourceRegistry(), _formatted);
 		for (auto const& error: c.errors())
 			formatter.printErrorInformation(*error);
 		return TestResult::FatalError;
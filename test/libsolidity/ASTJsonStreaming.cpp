@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests that writing the JSON AST to a stream produces the same output as serialising it
+ * after converting it to Json::Value.
+ */
+
+#include <test/Options.h>
+
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ASTJsonStreaming)
+
+BOOST_AUTO_TEST_CASE(syntax_tests)
+{
+	boost::filesystem::path path = dev::test::Options::get().testPath / "libsolidity" / "syntaxTests";
+	size_t files = 0;
+	for (auto const& entry: boost::filesystem::recursive_directory_iterator(path))
+	{
+		if (!boost::filesystem::is_regular_file(entry.path()) || entry.path().extension() != ".sol")
+			continue;
+		CompilerStack compiler;
+		compiler.setSources({{"", readFileAsString(entry.path().string())}});
+		compiler.setEVMVersion(dev::test::Options::get().evmVersion());
+		if (!compiler.parseAndAnalyze())
+			continue;
+		for (bool legacy: {false, true})
+		{
+			Json::Value json = ASTJsonConverter(legacy, compiler.sourceIndicesByID()).toJson(compiler.ast(""));
+			stringstream styled;
+			styled << json;
+			vector<pair<JsonWriter::Format, string>> expectations{
+				{JsonWriter::Format::Compact, jsonCompactPrint(json)},
+				{JsonWriter::Format::Pretty, jsonPrettyPrint(json)},
+				{JsonWriter::Format::Styled, styled.str()}
+			};
+			for (auto const& expectation: expectations)
+			{
+				stringstream streamed;
+				JsonWriter writer(streamed, expectation.first);
+				ASTJsonConverter(legacy, compiler.sourceIndicesByID()).write(writer, compiler.ast(""));
+				BOOST_CHECK_MESSAGE(
+					streamed.str() == expectation.second,
+					"Different output for " + entry.path().string()
+				);
+			}
+		}
+		files++;
+	}
+	BOOST_CHECK(files > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
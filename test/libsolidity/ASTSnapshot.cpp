@@ -0,0 +1,237 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests that compiling sources loaded from AST snapshots produces the same output as compiling
+ * the sources themselves.
+ */
+
+#include <test/Options.h>
+
+#include <libsolidity/ast/ASTSnapshot.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Scanner.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// Snapshots by the hash of the source they were made of.
+using SnapshotStore = map<h256, bytes>;
+
+struct CompilationResult
+{
+	/// Creation and runtime bytecode and metadata by contract name.
+	map<string, tuple<bytes, bytes, string>> contracts;
+	set<string> sourcesFromSnapshots;
+	/// Snapshots of all sources.
+	SnapshotStore snapshots;
+};
+
+/// Compiles @a _sources, loading snapshots from @a _store if present.
+CompilationResult compile(StringMap const& _sources, SnapshotStore const* _store = nullptr)
+{
+	CompilerStack compiler;
+	compiler.setSources(_sources);
+	compiler.setEVMVersion(dev::test::Options::get().evmVersion());
+	if (_store)
+		compiler.setASTSnapshotCallback([=](h256 const& _hash) {
+			auto snapshot = _store->find(_hash);
+			return snapshot == _store->end() ? bytes() : snapshot->second;
+		});
+	BOOST_REQUIRE(compiler.compile());
+
+	CompilationResult result;
+	for (string const& contract: compiler.contractNames())
+		result.contracts[contract] = make_tuple(
+			compiler.object(contract).bytecode,
+			compiler.runtimeObject(contract).bytecode,
+			compiler.metadata(contract)
+		);
+	for (string const& sourceName: compiler.sourceNames())
+	{
+		if (compiler.loadedFromSnapshot(sourceName))
+			result.sourcesFromSnapshots.insert(sourceName);
+		result.snapshots[keccak256(compiler.scanner(sourceName).source())] = compiler.astSnapshot(sourceName);
+	}
+	return result;
+}
+
+void checkSameOutput(CompilationResult const& _expectation, CompilationResult const& _result)
+{
+	BOOST_REQUIRE_EQUAL(_result.contracts.size(), _expectation.contracts.size());
+	for (auto const& contract: _expectation.contracts)
+		BOOST_CHECK_MESSAGE(
+			_result.contracts.count(contract.first) && _result.contracts.at(contract.first) == contract.second,
+			"Different output for " + contract.first
+		);
+}
+
+StringMap const c_sources{
+	{"a", R"(
+		pragma solidity >=0.0;
+		library L { function double(uint x) internal pure returns (uint) { return 2 * x; } }
+		/// @title A
+		contract A {
+			using L for uint;
+			event E(uint indexed value, string text);
+			struct S { uint a; bytes b; uint[3] c; }
+			enum Kind { X, Y }
+			mapping(address => S) internal m_values;
+			uint constant c = 0x1234 * 2 ** 8;
+			modifier nonZero(uint x) { require(x != 0, "zero"); _; }
+			constructor(uint x) public { m_values[msg.sender].a = x; }
+			/// @dev Doubles y.
+			function f(uint y) public nonZero(y) returns (uint r) {
+				emit E(y, "f");
+				r = y.double() + c;
+				assembly { r := add(r, sload(m_values_slot)) }
+				m_values[msg.sender].c[1] = r;
+			}
+			function g(Kind k) public view returns (bytes memory) {
+				return k == Kind.X ? m_values[msg.sender].b : abi.encode(this, now);
+			}
+			function() external payable {}
+		}
+	)"},
+	{"b", R"(
+		pragma solidity >=0.0;
+		import "a" as a;
+		contract B is a.A(7) {
+			function f(uint y) public returns (uint) { return super.f(y + 1); }
+			function h() public returns (address) { return address(new C()); }
+		}
+		contract C { function() external {} }
+	)"}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ASTSnapshot)
+
+BOOST_AUTO_TEST_CASE(roundtrip)
+{
+	CompilationResult expectation = compile(c_sources);
+	CompilationResult result = compile(c_sources, &expectation.snapshots);
+	BOOST_CHECK(result.sourcesFromSnapshots == (set<string>{"a", "b"}));
+	checkSameOutput(expectation, result);
+	// Snapshots of sources loaded from snapshots are the same.
+	BOOST_CHECK(result.snapshots == expectation.snapshots);
+}
+
+BOOST_AUTO_TEST_CASE(partial)
+{
+	CompilationResult expectation = compile(c_sources);
+	SnapshotStore store = expectation.snapshots;
+	store.erase(keccak256(c_sources.at("b")));
+	CompilationResult result = compile(c_sources, &store);
+	BOOST_CHECK(result.sourcesFromSnapshots == set<string>{"a"});
+	checkSameOutput(expectation, result);
+}
+
+BOOST_AUTO_TEST_CASE(changed_dependency)
+{
+	SnapshotStore store = compile(c_sources).snapshots;
+	StringMap sources = c_sources;
+	sources["a"] += "\ncontract D {}";
+	CompilationResult expectation = compile(sources);
+	CompilationResult result = compile(sources, &store);
+	BOOST_CHECK(result.sourcesFromSnapshots.empty());
+	checkSameOutput(expectation, result);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_snapshots)
+{
+	CompilationResult expectation = compile(c_sources);
+	SnapshotStore store = expectation.snapshots;
+	for (auto& snapshot: store)
+		snapshot.second[snapshot.second.size() / 2] ^= 0x20;
+	CompilationResult result = compile(c_sources, &store);
+	BOOST_CHECK(result.sourcesFromSnapshots.empty());
+	checkSameOutput(expectation, result);
+
+	for (auto& snapshot: store)
+		snapshot.second = bytes{1, 2, 3};
+	result = compile(c_sources, &store);
+	BOOST_CHECK(result.sourcesFromSnapshots.empty());
+	checkSameOutput(expectation, result);
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_header)
+{
+	CompilationResult result = compile(c_sources);
+	ASTSnapshotReader reader(result.snapshots.at(keccak256(c_sources.at("b"))));
+	BOOST_CHECK_EQUAL(reader.sourceName(), "b");
+	BOOST_CHECK(reader.sourceHash() == keccak256(c_sources.at("b")));
+	BOOST_CHECK(reader.dependencies() == (map<string, h256>{{"a", keccak256(c_sources.at("a"))}}));
+	BOOST_CHECK(reader.importPaths() == vector<string>{"a"});
+	BOOST_CHECK_THROW(ASTSnapshotReader(bytes{}), ASTSnapshotError);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_tests)
+{
+	boost::filesystem::path path = dev::test::Options::get().testPath / "compilationTests";
+	size_t projects = 0;
+	for (auto const& project: boost::filesystem::directory_iterator(path))
+	{
+		if (!boost::filesystem::is_directory(project.path()))
+			continue;
+		StringMap sources;
+		set<string> sourceNames;
+		for (auto const& entry: boost::filesystem::recursive_directory_iterator(project.path()))
+			if (boost::filesystem::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+			{
+				string sourceName = boost::filesystem::relative(entry.path(), project.path()).generic_string();
+				sources[sourceName] = readFileAsString(entry.path().string());
+				sourceNames.insert(sourceName);
+			}
+		CompilationResult expectation = compile(sources);
+		CompilationResult result = compile(sources, &expectation.snapshots);
+		BOOST_CHECK_MESSAGE(
+			result.sourcesFromSnapshots == sourceNames,
+			"Snapshots not used for " + project.path().string()
+		);
+		checkSameOutput(expectation, result);
+		projects++;
+	}
+	BOOST_CHECK(projects > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -62,7 +62,7 @@ eth::AssemblyItems compileContract(std::shared_ptr<CharStream> _sourceCode)
 	BOOST_REQUIRE_NO_THROW(sourceUnit = parser.parse(make_shared<Scanner>(_sourceCode)));
 	BOOST_CHECK(!!sourceUnit);
 
-	map<ASTNode const*, shared_ptr<DeclarationContainer>> scopes;
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>> scopes;
 	GlobalContext globalContext;
 	NameAndTypeResolver resolver(globalContext, scopes, errorReporter);
 	solAssert(Error::containsOnlyWarnings(errorReporter.errors()), "");
@@ -108,9 +108,9 @@ void printAssemblyLocations(AssemblyItems const& _items)
 			_loc.start <<
 			", " <<
 			_loc.end <<
-			", make_shared<string>(\"" <<
-			_loc.source->name() <<
-			"\"))) +" << endl;
+			", " <<
+			_loc.sourceId <<
+			")) +" << endl;
 	};
 
 	vector<SourceLocation> locations;
@@ -172,32 +172,32 @@ BOOST_AUTO_TEST_CASE(location_test)
 	vector<SourceLocation> locations;
 	if (dev::test::Options::get().optimize)
 		locations =
-			vector<SourceLocation>(4, SourceLocation{2, 82, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{8, 17, codegenCharStream}) +
-			vector<SourceLocation>(3, SourceLocation{5, 7, codegenCharStream}) +
-			vector<SourceLocation>(1, SourceLocation{30, 31, codegenCharStream}) +
-			vector<SourceLocation>(1, SourceLocation{27, 28, codegenCharStream}) +
-			vector<SourceLocation>(1, SourceLocation{20, 32, codegenCharStream}) +
-			vector<SourceLocation>(1, SourceLocation{5, 7, codegenCharStream}) +
-			vector<SourceLocation>(19, SourceLocation{2, 82, sourceCode}) +
-			vector<SourceLocation>(21, SourceLocation{20, 79, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{72, 74, sourceCode}) +
-			vector<SourceLocation>(2, SourceLocation{20, 79, sourceCode});
+			vector<SourceLocation>(4, SourceLocation{2, 82, sourceCode->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{8, 17, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(3, SourceLocation{5, 7, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{30, 31, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{27, 28, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{20, 32, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{5, 7, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(19, SourceLocation{2, 82, sourceCode->sourceId()}) +
+			vector<SourceLocation>(21, SourceLocation{20, 79, sourceCode->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{72, 74, sourceCode->sourceId()}) +
+			vector<SourceLocation>(2, SourceLocation{20, 79, sourceCode->sourceId()});
 	else
 		locations =
-			vector<SourceLocation>(4, SourceLocation{2, 82, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{8, 17, codegenCharStream}) +
-			vector<SourceLocation>(3, SourceLocation{5, 7, codegenCharStream}) +
-			vector<SourceLocation>(1, SourceLocation{30, 31, codegenCharStream}) +
-			vector<SourceLocation>(1, SourceLocation{27, 28, codegenCharStream}) +
-			vector<SourceLocation>(1, SourceLocation{20, 32, codegenCharStream}) +
-			vector<SourceLocation>(1, SourceLocation{5, 7, codegenCharStream}) +
-			vector<SourceLocation>(hasShifts ? 19 : 20, SourceLocation{2, 82, sourceCode}) +
-			vector<SourceLocation>(24, SourceLocation{20, 79, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{49, 58, sourceCode}) +
-			vector<SourceLocation>(1, SourceLocation{72, 74, sourceCode}) +
-			vector<SourceLocation>(2, SourceLocation{65, 74, sourceCode}) +
-			vector<SourceLocation>(2, SourceLocation{20, 79, sourceCode});
+			vector<SourceLocation>(4, SourceLocation{2, 82, sourceCode->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{8, 17, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(3, SourceLocation{5, 7, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{30, 31, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{27, 28, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{20, 32, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{5, 7, codegenCharStream->sourceId()}) +
+			vector<SourceLocation>(hasShifts ? 19 : 20, SourceLocation{2, 82, sourceCode->sourceId()}) +
+			vector<SourceLocation>(24, SourceLocation{20, 79, sourceCode->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{49, 58, sourceCode->sourceId()}) +
+			vector<SourceLocation>(1, SourceLocation{72, 74, sourceCode->sourceId()}) +
+			vector<SourceLocation>(2, SourceLocation{65, 74, sourceCode->sourceId()}) +
+			vector<SourceLocation>(2, SourceLocation{20, 79, sourceCode->sourceId()});
 	checkAssemblyLocations(items, locations);
 }
 
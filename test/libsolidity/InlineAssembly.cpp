@@ -84,7 +84,7 @@ boost::optional<Error> parseAndReturnFirstError(
 		{
 			string errors;
 			for (auto const& err: stack.errors())
-				errors += SourceReferenceFormatter::formatErrorInformation(*err);
+				errors += SourceReferenceFormatter::formatErrorInformation(*err, stack.sourceRegistry());
 			BOOST_FAIL("Found more than one error:\n" + errors);
 		}
 		error = e;
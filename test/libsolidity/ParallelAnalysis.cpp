@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests that concurrent type checking reports the same errors as sequential type checking.
+ */
+
+#include <test/Options.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Exceptions.h>
+#include <libdevcore/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace langutil;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// @returns a textual representation of the errors reported when analysing @a _sources.
+/// Source IDs differ between compilations, so only the offsets of locations are included.
+vector<string> analysisErrors(StringMap const& _sources, bool _parallel)
+{
+	CompilerStack compiler;
+	compiler.setSources(_sources);
+	compiler.setEVMVersion(dev::test::Options::get().evmVersion());
+	compiler.setParallelAnalysis(_parallel);
+	compiler.parseAndAnalyze();
+	vector<string> errors;
+	for (auto const& error: compiler.errors())
+	{
+		string description = error->typeName();
+		if (string const* comment = boost::get_error_info<errinfo_comment>(*error))
+			description += ": " + *comment;
+		if (SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error))
+			description += " @" + to_string(location->start) + ":" + to_string(location->end);
+		errors.push_back(description);
+	}
+	return errors;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ParallelAnalysis)
+
+BOOST_AUTO_TEST_CASE(errors_in_source_order)
+{
+	StringMap sources{
+		{"a", "pragma solidity >=0.0; contract A { function f() public { uint x = true; } }"},
+		{"b", "pragma solidity >=0.0; import \"a\"; contract B is A { function g() public { bool y = 1; } }"},
+		{"c", "pragma solidity >=0.0; contract C { function h() public { uint z; z(); } } contract D { function i() public { string memory s = 2; } }"}
+	};
+	vector<string> sequential = analysisErrors(sources, false);
+	// One error per contract and the pre-release warning.
+	BOOST_CHECK_EQUAL(sequential.size(), 5);
+	BOOST_CHECK(analysisErrors(sources, true) == sequential);
+}
+
+BOOST_AUTO_TEST_CASE(syntax_tests)
+{
+	boost::filesystem::path path = dev::test::Options::get().testPath / "libsolidity" / "syntaxTests";
+	size_t files = 0;
+	for (auto const& entry: boost::filesystem::recursive_directory_iterator(path))
+	{
+		if (!boost::filesystem::is_regular_file(entry.path()) || entry.path().extension() != ".sol")
+			continue;
+		StringMap sources{{"", readFileAsString(entry.path().string())}};
+		BOOST_CHECK_MESSAGE(
+			analysisErrors(sources, true) == analysisErrors(sources, false),
+			"Different errors for " + entry.path().string()
+		);
+		files++;
+	}
+	BOOST_CHECK(files > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
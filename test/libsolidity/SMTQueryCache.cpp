@@ -0,0 +1,163 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the cache of SMT solver answers.
+ */
+
+#include <test/Options.h>
+
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace langutil;
+using namespace dev::solidity::smt;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// Temporary directory that is removed at the end of the test.
+struct TemporaryDirectory
+{
+	TemporaryDirectory():
+		path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solidity-smt-cache-%%%%-%%%%"))
+	{}
+	~TemporaryDirectory() { boost::filesystem::remove_all(path); }
+
+	boost::filesystem::path path;
+};
+
+/// @returns the messages of the errors reported by the SMTChecker when compiling @a _source
+/// with @a _queryCache.
+vector<string> modelCheckerErrors(string const& _source, shared_ptr<SMTQueryCache> _queryCache)
+{
+	static set<string> const otherMessages{
+		"Experimental features are turned on. Do not use experimental features on live deployments.",
+		"This is a pre-release compiler version, please do not use it in production."
+	};
+
+	ModelCheckerSettings settings;
+	settings.queryCache = move(_queryCache);
+	CompilerStack compiler;
+	compiler.setSources({{"", "pragma solidity >=0.0;\npragma experimental SMTChecker;\n" + _source}});
+	compiler.setEVMVersion(dev::test::Options::get().evmVersion());
+	compiler.setModelCheckerSettings(settings);
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+	vector<string> errors;
+	for (auto const& error: compiler.errors())
+		if (string const* comment = boost::get_error_info<errinfo_comment>(*error))
+			if (!otherMessages.count(*comment))
+				errors.push_back(*comment);
+	return errors;
+}
+
+string const c_source = R"(
+	contract C {
+		uint8 x;
+		function f(uint8 a, uint8 b) public {
+			x = a + b;
+			assert(x != 7);
+		}
+		function g(uint8 a) public pure {
+			require(a < 100);
+			assert(a < 200);
+		}
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTQueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(in_memory)
+{
+	SMTQueryCache cache;
+	h256 key = SMTQueryCache::key("solver", "(check-sat)");
+	BOOST_CHECK(key != SMTQueryCache::key("other solver", "(check-sat)"));
+	BOOST_CHECK(!cache.lookup(key));
+
+	cache.store(key, {CheckResult::SATISFIABLE, {"1", "(- 2)"}});
+	auto answer = cache.lookup(key);
+	BOOST_REQUIRE(answer);
+	BOOST_CHECK(answer->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(answer->second == (vector<string>{"1", "(- 2)"}));
+
+	h256 errorKey = SMTQueryCache::key("solver", "(assert false)\n(check-sat)");
+	cache.store(errorKey, {CheckResult::ERROR, {}});
+	cache.store(errorKey, {CheckResult::CONFLICTING, {}});
+	BOOST_CHECK(!cache.lookup(errorKey));
+}
+
+BOOST_AUTO_TEST_CASE(persistent)
+{
+	TemporaryDirectory directory;
+	h256 key = SMTQueryCache::key("solver", "(check-sat)");
+	SMTQueryCache(directory.path).store(key, {CheckResult::UNKNOWN, {"multi\nline"}});
+
+	auto answer = SMTQueryCache(directory.path).lookup(key);
+	BOOST_REQUIRE(answer);
+	BOOST_CHECK(answer->first == CheckResult::UNKNOWN);
+	BOOST_CHECK(answer->second == vector<string>{"multi\nline"});
+
+	// Invalid files are ignored.
+	ofstream((directory.path / key.hex()).string()) << "{\"result\": \"maybe\", \"values\": []}";
+	BOOST_CHECK(!SMTQueryCache(directory.path).lookup(key));
+	ofstream((directory.path / key.hex()).string()) << "unsat";
+	BOOST_CHECK(!SMTQueryCache(directory.path).lookup(key));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker)
+{
+	TemporaryDirectory directory;
+	vector<string> errors = modelCheckerErrors(c_source, nullptr);
+	BOOST_CHECK_EQUAL(errors.size(), 2);
+	BOOST_CHECK(modelCheckerErrors(c_source, make_shared<SMTQueryCache>(directory.path)) == errors);
+	BOOST_CHECK(!boost::filesystem::is_empty(directory.path));
+	BOOST_CHECK(modelCheckerErrors(c_source, make_shared<SMTQueryCache>(directory.path)) == errors);
+
+	// The answers are taken from the cache instead of the solvers, so that
+	// neither the condition of the require statement nor its negation is satisfiable.
+	for (auto const& entry: boost::filesystem::directory_iterator(directory.path))
+		ofstream(entry.path().string()) << "{\"result\": \"unsat\", \"values\": []}";
+	BOOST_CHECK(
+		modelCheckerErrors(c_source, make_shared<SMTQueryCache>(directory.path)) ==
+		vector<string>{"Condition unreachable."}
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -62,7 +62,7 @@ bytes SolidityExecutionFramework::compileContract(
 	m_compiler.enableIRGeneration(m_compileViaYul);
 	if (!m_compiler.compile())
 	{
-		langutil::SourceReferenceFormatter formatter(std::cerr);
+		langutil::SourceReferenceFormatter formatter(std::cerr, m_compiler.sourceRegistry());
 
 		for (auto const& error: m_compiler.errors())
 			formatter.printErrorInformation(*error);
@@ -82,7 +82,7 @@ bytes SolidityExecutionFramework::compileContract(
 			_contractName.empty() ? m_compiler.lastContractName() : _contractName
 		)))
 		{
-			langutil::SourceReferenceFormatter formatter(std::cerr);
+			langutil::SourceReferenceFormatter formatter(std::cerr, m_compiler.sourceRegistry());
 
 			for (auto const& error: m_compiler.errors())
 				formatter.printErrorInformation(*error);
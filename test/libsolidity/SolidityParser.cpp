@@ -653,19 +653,23 @@ BOOST_AUTO_TEST_CASE(inline_asm_end_location)
 	class CheckInlineAsmLocation: public ASTConstVisitor
 	{
 	public:
+		explicit CheckInlineAsmLocation(string const& _sourceCode): m_sourceCode(_sourceCode) {}
 		bool visited = false;
 		virtual bool visit(InlineAssembly const& _inlineAsm)
 		{
 			auto loc = _inlineAsm.location();
-			auto asmStr = loc.source->source().substr(loc.start, loc.end - loc.start);
+			auto asmStr = m_sourceCode.substr(loc.start, loc.end - loc.start);
 			BOOST_CHECK_EQUAL(asmStr, "assembly { a := 0x12345678 }");
 			visited = true;
 
 			return false;
 		}
+
+	private:
+		string const& m_sourceCode;
 	};
 
-	CheckInlineAsmLocation visitor;
+	CheckInlineAsmLocation visitor(sourceCode);
 	contract->accept(visitor);
 
 	BOOST_CHECK_MESSAGE(visitor.visited, "No inline asm block found?!");
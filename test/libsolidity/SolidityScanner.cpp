@@ -648,6 +648,37 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_strings)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_tokens)
+{
+	// Longer than the blocks processed at once by the scanner.
+	string const identifier = "a_very_long_identifier_$with_digits_0123456789";
+	string const text = "a long string literal with some \\\"escapes\\\" and \xc2\xa0 non-ascii characters";
+	string const comment = "/* a long comment ** with * stars / and slashes \n\r\t over several lines **/";
+	Scanner scanner(CharStream(
+		"        \n\t\t\t\t        \r\n" + identifier + " " + comment + " \"" + text + "\"" +
+		"// a long single line comment with a NEL\xc2\x85" + identifier,
+		""
+	));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a long string literal with some \"escapes\" and \xc2\xa0 non-ascii characters");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(period_in_long_identifier)
+{
+	Scanner scanner(CharStream("a_long_identifier_before_the_period.and_a_long_one_after_it", ""));
+	scanner.supportPeriodInIdentifier(true);
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a_long_identifier_before_the_period.and_a_long_one_after_it");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -1067,7 +1067,10 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["details"]["yulDetails"].isObject());
 	BOOST_CHECK(optimizer["details"]["yulDetails"].getMemberNames() == vector<string>{"stackAllocation"});
 	BOOST_CHECK(optimizer["details"]["yulDetails"]["stackAllocation"].asBool() == true);
-	BOOST_CHECK_EQUAL(optimizer["details"].getMemberNames().size(), 8);
+	BOOST_CHECK(optimizer["details"]["constantOptimizerMaxSteps"].asUInt() == 10000);
+	BOOST_CHECK(optimizer["details"]["blockLayout"].asBool() == false);
+	BOOST_CHECK(optimizer["details"]["tagRelaxation"].asBool() == false);
+	BOOST_CHECK_EQUAL(optimizer["details"].getMemberNames().size(), 11);
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
@@ -1368,6 +1371,273 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(streamed_ast)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{
+			"A":
+			{
+				"content": "pragma solidity >=0.0; /// ä \"x\"\n contract C { string s = \"\\u0000\\n\\u2603\"; function f(uint[] memory) public { (, uint x) = (1, 2); x; } }"
+			},
+			"B":
+			{
+				"content": "pragma solidity >=0.0; import \"A\"; contract D is C { event E(uint indexed); }"
+			}
+		},
+		"settings":
+		{
+			"outputSelection":
+			{
+				"*": { "": ["ast", "legacyAST"], "*": ["abi", "metadata"] }
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+
+	// The ASTs are written directly when the output is serialised by the compiler.
+	dev::solidity::StandardCompiler compiler;
+	string streamed = compiler.compile(string(input));
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_REQUIRE(result["sources"]["A"]["ast"].isObject());
+	BOOST_REQUIRE(result["sources"]["B"]["legacyAST"].isObject());
+	BOOST_CHECK_EQUAL(streamed, jsonCompactPrint(result));
+}
+
+BOOST_AUTO_TEST_CASE(statistics)
+{
+	auto input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"statistics": 1
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.statistics\" must be a Boolean."));
+
+	input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"statistics": true
+		},
+		"sources": {
+			"A": {
+				"content": "pragma solidity >=0.0; contract C { function f(uint a, uint b) public pure returns (uint) { return a + b + a + b + a; } }"
+			}
+		}
+	}
+	)";
+
+	result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& typeQueries = result["statistics"]["typeQueries"];
+	for (string const& query: {"implicitConversions", "commonTypes", "binaryOperators"})
+	{
+		BOOST_REQUIRE(typeQueries[query]["hits"].isUInt64());
+		BOOST_REQUIRE(typeQueries[query]["misses"].isUInt64());
+	}
+	// The first sum of two uint values is computed, the others are cached.
+	BOOST_CHECK_EQUAL(typeQueries["binaryOperators"]["misses"].asUInt64(), 1);
+	BOOST_CHECK_EQUAL(typeQueries["binaryOperators"]["hits"].asUInt64(), 3);
+
+	// No statistics unless requested.
+	input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A": {
+				"content": "pragma solidity >=0.0; contract C {}"
+			}
+		}
+	}
+	)";
+	result = compile(input);
+	BOOST_CHECK(!result.isMember("statistics"));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_portfolio)
+{
+	auto inputForPortfolio = [](string const& _portfolio)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"A": {
+						"content": "pragma solidity >=0.0; pragma experimental SMTChecker; contract C { function f(uint x, uint y) public pure { require(x < 100 && y < 100); assert(x * y != 391); assert(x + y < 200); } }"
+					}
+				},
+				"settings": {
+					"modelChecker": { "portfolio": )" + _portfolio + R"( }
+				}
+			}
+		)";
+	};
+	Json::Value result = compile(inputForPortfolio("1"));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.modelChecker.portfolio\" must be a string."));
+	result = compile(inputForPortfolio("\"fastest\""));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid model checker portfolio mode requested."));
+	result = compile(R"({ "language": "Solidity", "sources": { "A": { "content": "" } }, "settings": { "modelChecker": { "timeout": 1 } } })");
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"timeout\""));
+
+	// The concurrent modes report the same warnings as the sequential mode.
+	Json::Value sequential = compile(inputForPortfolio("\"sequential\""));
+	BOOST_CHECK(containsAtMostWarnings(sequential));
+	BOOST_CHECK_EQUAL(compile(inputForPortfolio("\"first\""))["errors"], sequential["errors"]);
+	BOOST_CHECK_EQUAL(compile(inputForPortfolio("\"all\""))["errors"], sequential["errors"]);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_threads)
+{
+	auto inputForThreads = [](string const& _threads)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"A": {
+						"content": "pragma solidity >=0.0; pragma experimental SMTChecker; contract C { uint8 x; function f(uint8 a, uint8 b) public { x = a + b; assert(b == 0 || a / b < 200); x = a - b; assert(x != 7); } function g(uint8 a) public pure returns (uint8) { require(a < 100); assert(a < 200); return a + 3 - 10; } }"
+					}
+				},
+				"settings": {
+					"modelChecker": { "threads": )" + _threads + R"( }
+				}
+			}
+		)";
+	};
+	Json::Value result = compile(inputForThreads("0"));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.modelChecker.threads\" must be a positive integer."));
+	result = compile(inputForThreads("\"4\""));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.modelChecker.threads\" must be a positive integer."));
+
+	// The warnings are reported in the same order as with a single solver. The counterexamples
+	// depend on the solver instance that found them, so only the first line of the messages is compared.
+	auto warnings = [](Json::Value const& _output)
+	{
+		vector<pair<string, string>> result;
+		for (auto const& error: _output["errors"])
+		{
+			string message = error["message"].asString();
+			result.emplace_back(message.substr(0, message.find('\n')), dev::jsonCompactPrint(error["sourceLocation"]));
+		}
+		return result;
+	};
+	Json::Value sequential = compile(inputForThreads("1"));
+	BOOST_CHECK(containsAtMostWarnings(sequential));
+	BOOST_CHECK(sequential["errors"].size() > 4);
+	BOOST_CHECK(warnings(compile(inputForThreads("4"))) == warnings(sequential));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache)
+{
+	auto inputForCache = [](string const& _cache)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"A": {
+						"content": "pragma solidity >=0.0; pragma experimental SMTChecker; contract C { function f(uint8 x) public pure { require(x < 100); assert(x + 1 != 7); } }"
+					}
+				},
+				"settings": {
+					"modelChecker": { "cache": )" + _cache + R"( }
+				}
+			}
+		)";
+	};
+	Json::Value result = compile(inputForCache("1"));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.modelChecker.cache\" must be a Boolean."));
+
+	// The second compilation uses the answers of the first one.
+	Json::Value uncached = compile(inputForCache("false"));
+	BOOST_CHECK(containsAtMostWarnings(uncached));
+	dev::solidity::StandardCompiler compiler;
+	for (size_t i = 0; i < 2; ++i)
+	{
+		Json::Value output;
+		BOOST_REQUIRE(jsonParseStrict(compiler.compile(inputForCache("true")), output));
+		BOOST_CHECK_EQUAL(output["errors"], uncached["errors"]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_limits)
+{
+	auto inputForLimits = [](string const& _limits)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"A": {
+						"content": "pragma solidity >=0.0; pragma experimental SMTChecker; contract C { function f(uint8 x, uint8 y) public pure { require(x < 100); assert(x + 1 != 7); assert(y < 100); } }"
+					}
+				},
+				"settings": {
+					"modelChecker": )" + _limits + R"(,
+					"statistics": true
+				}
+			}
+		)";
+	};
+	for (string const& limit: {"resourceLimit", "totalResourceLimit", "timeBudget"})
+		for (string const& value: {"0", "-1", "\"1\""})
+		{
+			Json::Value result = compile(inputForLimits("{ \"" + limit + "\": " + value + " }"));
+			BOOST_CHECK(containsError(result, "JSONError", "\"settings.modelChecker." + limit + "\" must be a positive integer."));
+		}
+
+	// A statistics entry is reported for each query of a target.
+	Json::Value unlimited = compile(inputForLimits("{}"));
+	BOOST_CHECK(containsAtMostWarnings(unlimited));
+	Json::Value const& targets = unlimited["statistics"]["modelChecker"]["targets"];
+	BOOST_REQUIRE(targets.isArray());
+	BOOST_REQUIRE(!targets.empty());
+	size_t violations = 0;
+	for (auto const& target: targets)
+	{
+		BOOST_CHECK_EQUAL(target["engine"], "BMC");
+		BOOST_CHECK_EQUAL(target["sourceLocation"]["file"], "A");
+		BOOST_CHECK(target["solveTime"].isUInt64());
+		BOOST_CHECK(target["querySize"].asUInt64() > 0);
+		if (target["target"] == "Assertion violation" && target["result"] == "sat")
+			++violations;
+	}
+	BOOST_CHECK_EQUAL(violations, 2);
+
+	// A resource limit that suffices for all queries does not change the warnings.
+	Json::Value limited = compile(inputForLimits("{ \"resourceLimit\": 100000000 }"));
+	BOOST_CHECK_EQUAL(limited["errors"], unlimited["errors"]);
+	limited = compile(inputForLimits("{ \"totalResourceLimit\": 100000000, \"timeBudget\": 600000 }"));
+	BOOST_CHECK_EQUAL(limited["errors"], unlimited["errors"]);
+
+	// Once the budget is exhausted, the solvers are not queried anymore.
+	Json::Value exhausted = compile(inputForLimits("{ \"totalResourceLimit\": 1 }"));
+	BOOST_CHECK(containsAtMostWarnings(exhausted));
+	size_t unknown = 0;
+	for (auto const& target: exhausted["statistics"]["modelChecker"]["targets"])
+		if (target["result"] == "unknown")
+		{
+			BOOST_CHECK_EQUAL(target["solver"], "");
+			++unknown;
+		}
+	BOOST_CHECK(unknown + 1 >= exhausted["statistics"]["modelChecker"]["targets"].size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,26 @@
+pragma experimental SMTChecker;
+
+contract C
+{
+	function add(uint8 a, uint8 b) internal pure returns (uint8) {
+		uint8 c = a + b;
+		return c;
+	}
+	function f(uint8 x) public pure {
+		require(x < 100);
+		uint8 y = add(x, 1);
+		uint8 z = add(y, 1);
+		assert(z == x + 2);
+		assert(z > 101);
+	}
+	function g(uint8 x) public pure {
+		require(x < 100);
+		uint8 y = add(x, 1);
+		uint8 z = add(y, 200);
+		assert(z > y);
+	}
+}
+// ----
+// Warning: (122-127): Overflow (resulting value larger than 255) happens here
+// Warning: (269-284): Assertion violation happens here
+// Warning: (394-407): Assertion violation happens here
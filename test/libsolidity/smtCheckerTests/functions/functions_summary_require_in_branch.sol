@@ -0,0 +1,23 @@
+pragma experimental SMTChecker;
+
+contract C
+{
+	function check(uint v) internal pure returns (uint) {
+		require(v > 10);
+		return v;
+	}
+	function f(uint v) public pure {
+		uint r = check(v + 1);
+		assert(r > 10);
+	}
+	function g(uint v, bool c) public pure {
+		uint r = 0;
+		if (c)
+			r = check(v);
+		assert(c || r == 0);
+		assert(!c || v > 10);
+		assert(v > 10);
+	}
+}
+// ----
+// Warning: (346-360): Assertion violation happens here
@@ -0,0 +1,20 @@
+pragma experimental SMTChecker;
+
+contract C
+{
+	uint x;
+	function get() internal view returns (uint) {
+		return x;
+	}
+	function f() public {
+		x = 1;
+		uint a = get();
+		x = 2;
+		uint b = get();
+		assert(a == 1);
+		assert(b == 2);
+		assert(a == b);
+	}
+}
+// ----
+// Warning: (232-246): Assertion violation happens here
@@ -0,0 +1,13 @@
+pragma experimental SMTChecker;
+// The assertion on y does not depend on the constraints on x,
+// but they still have to hold for it to fail.
+contract C {
+	uint x;
+	function f(uint8 y) public {
+		require(x < 10);
+		x = x + 20;
+		assert(y > 0);
+	}
+}
+// ----
+// Warning: (229-242): Assertion violation happens here
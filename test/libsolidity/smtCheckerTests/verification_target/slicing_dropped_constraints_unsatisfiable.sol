@@ -0,0 +1,14 @@
+pragma experimental SMTChecker;
+// The constraints on x contradict each other, so the assertion on y,
+// which does not depend on them, cannot fail.
+contract C {
+	uint x;
+	function f(uint8 y) public {
+		require(x < 10);
+		x = x + 20;
+		require(x < 15);
+		assert(y > 0);
+	}
+}
+// ----
+// Warning: (244-250): Condition is always false.
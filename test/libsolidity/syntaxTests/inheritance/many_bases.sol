@@ -0,0 +1,20 @@
+contract B0 { uint v0; function f0() public pure returns (uint) { return 0; } }
+contract B1 is B0 { uint v1; function f1() public pure returns (uint) { return 1; } }
+contract B2 is B1 { uint v2; function f2() public pure returns (uint) { return 2; } }
+contract B3 is B2 { uint v3; function f3() public pure returns (uint) { return 3; } }
+contract B4 is B3 { uint v4; function f4() public pure returns (uint) { return 4; } }
+contract B5 is B4 { uint v5; function f5() public pure returns (uint) { return 5; } }
+contract B6 is B5 { uint v6; function f6() public pure returns (uint) { return 6; } }
+contract B7 is B6 { uint v7; function f7() public pure returns (uint) { return 7; } }
+contract B8 is B7 { uint v8; function f8() public pure returns (uint) { return 8; } }
+contract B9 is B8 { uint v9; function f9() public pure returns (uint) { return 9; } }
+contract B10 is B9 { uint v10; function f10() public pure returns (uint) { return 10; } }
+contract B11 is B10 { uint v11; function f11() public pure returns (uint) { return 11; } }
+contract X { function f3() public {} event v5(); }
+contract C is X, B11 {
+    function g() public view returns (uint) { return v0 + v11 + f0() + f7() + f11(); }
+    function h() public pure returns (uint) { return vv; }
+}
+// ----
+// DeclarationError: (1072-1083): Identifier already declared.
+// DeclarationError: (1249-1251): Undeclared identifier. Did you mean "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v8" or "v9"?
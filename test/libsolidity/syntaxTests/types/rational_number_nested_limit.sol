@@ -0,0 +1,17 @@
+contract c {
+    function f() public pure {
+        int a;
+        a = (1 << 2000) * (1 << 2000) * (1 << 2000) * (1 << 2000);
+        a = ((3 / 7) ** 512) ** 8;
+        a = (2 ** 2000) ** 2 ** 2;
+        a = ((((1 << 4095) >> 4000) << 4000) - (1 << 4095)) * (1 << 4095) * (1 << 4095);
+    }
+}
+// ----
+// TypeError: (71-110): Operator * not compatible with types int_const 1318...(1197 digits omitted)...9376 and int_const 1148...(595 digits omitted)...9376. Precision of rational constants is limited to 4096 bits.
+// TypeError: (71-124): Operator * not compatible with types int_const 1318...(1197 digits omitted)...9376 and int_const 1148...(595 digits omitted)...9376. Precision of rational constants is limited to 4096 bits.
+// TypeError: (71-124): Type int_const 1318...(1197 digits omitted)...9376 is not implicitly convertible to expected type int256.
+// TypeError: (138-159): Operator ** not compatible with types rational_const 1932...(237 digits omitted)...1441 / 4900...(425 digits omitted)...7201 and int_const 8. Precision of rational constants is limited to 4096 bits.
+// TypeError: (138-159): Type rational_const 1932...(237 digits omitted)...1441 / 4900...(425 digits omitted)...7201 is not implicitly convertible to expected type int256. Try converting to type ufixed8x80 or use an explicit conversion.
+// TypeError: (173-194): Operator ** not compatible with types int_const 1318...(1197 digits omitted)...9376 and int_const 2. Precision of rational constants is limited to 4096 bits.
+// TypeError: (173-194): Type int_const 1318...(1197 digits omitted)...9376 is not implicitly convertible to expected type int256.
@@ -49,9 +49,9 @@ Dialect const& defaultDialect(bool _yul)
 }
 }
 
-void yul::test::printErrors(ErrorList const& _errors)
+void yul::test::printErrors(ErrorList const& _errors, SourceRegistry const& _sources)
 {
-	SourceReferenceFormatter formatter(cout);
+	SourceReferenceFormatter formatter(cout, _sources);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
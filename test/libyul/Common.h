@@ -30,6 +30,7 @@
 namespace langutil
 {
 class Error;
+class SourceRegistry;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
 
@@ -43,7 +44,7 @@ namespace yul
 namespace test
 {
 
-void printErrors(langutil::ErrorList const& _errors);
+void printErrors(langutil::ErrorList const& _errors, langutil::SourceRegistry const& _sources);
 std::pair<std::shared_ptr<Block>, std::shared_ptr<AsmAnalysisInfo>>
 parse(std::string const& _source, bool _yul = true);
 Block disambiguate(std::string const& _source, bool _yul = true);
@@ -53,6 +53,15 @@ ObjectCompilerTest::ObjectCompilerTest(string const& _filename)
 		m_validatedSettings["optimize"] = "true";
 		m_settings.erase("optimize");
 	}
+	if (m_settings.count("machine"))
+	{
+		if (m_settings["machine"] == "llvmir")
+			m_llvmIR = true;
+		else if (m_settings["machine"] != "evm")
+			BOOST_THROW_EXCEPTION(runtime_error("Invalid machine: \"" + m_settings["machine"] + "\"."));
+		m_validatedSettings["machine"] = m_settings["machine"];
+		m_settings.erase("machine");
+	}
 	m_expectation = parseSimpleExpectations(file);
 }
 
@@ -66,24 +75,30 @@ TestCase::TestResult ObjectCompilerTest::run(ostream& _stream, string const& _li
 	if (!stack.parseAndAnalyze("source", m_source))
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Error parsing source." << endl;
-		printErrors(_stream, stack.errors());
+		printErrors(_stream, stack.errors(), stack.sourceRegistry());
 		return TestResult::FatalError;
 	}
 	stack.optimize();
 
-	MachineAssemblyObject obj = stack.assemble(AssemblyStack::Machine::EVM);
-	solAssert(obj.bytecode, "");
-
-	m_obtainedResult = "Assembly:\n" + obj.assembly;
-	if (obj.bytecode->bytecode.empty())
-		m_obtainedResult += "-- empty bytecode --\n";
+	if (m_llvmIR)
+		// The bitcode is not part of the expectation, since it contains the version of LLVM.
+		m_obtainedResult = "LLVM IR:\n" + stack.assemble(AssemblyStack::Machine::LLVMIR).assembly;
 	else
-		m_obtainedResult +=
-			"Bytecode: " +
-			toHex(obj.bytecode->bytecode) +
-			"\nOpcodes: " +
-			boost::trim_copy(dev::eth::disassemble(obj.bytecode->bytecode)) +
-			"\n";
+	{
+		MachineAssemblyObject obj = stack.assemble(AssemblyStack::Machine::EVM);
+		solAssert(obj.bytecode, "");
+
+		m_obtainedResult = "Assembly:\n" + obj.assembly;
+		if (obj.bytecode->bytecode.empty())
+			m_obtainedResult += "-- empty bytecode --\n";
+		else
+			m_obtainedResult +=
+				"Bytecode: " +
+				toHex(obj.bytecode->bytecode) +
+				"\nOpcodes: " +
+				boost::trim_copy(dev::eth::disassemble(obj.bytecode->bytecode)) +
+				"\n";
+	}
 
 	if (m_expectation != m_obtainedResult)
 	{
@@ -119,9 +134,9 @@ void ObjectCompilerTest::printIndented(ostream& _stream, string const& _output,
 			_stream << _linePrefix << line << endl;
 }
 
-void ObjectCompilerTest::printErrors(ostream& _stream, ErrorList const& _errors)
+void ObjectCompilerTest::printErrors(ostream& _stream, ErrorList const& _errors, SourceRegistry const& _sources)
 {
-	SourceReferenceFormatter formatter(_stream);
+	SourceReferenceFormatter formatter(_stream, _sources);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
@@ -18,6 +18,7 @@
 #include <test/libyul/YulInterpreterTest.h>
 
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/JIT.h>
 
 #include <test/Options.h>
 
@@ -25,6 +26,7 @@
 #include <libyul/AsmParser.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Object.h>
 
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/SourceReferenceFormatter.h>
@@ -62,11 +64,12 @@ TestCase::TestResult YulInterpreterTest::run(ostream& _stream, string const& _li
 	if (!parse(_stream, _linePrefix, _formatted))
 		return TestResult::FatalError;
 
-	m_obtainedResult = interpret();
+	m_obtainedResult = interpret(false);
+	string jitResult = interpret(true);
 
+	string nextIndentLevel = _linePrefix + "  ";
 	if (m_expectation != m_obtainedResult)
 	{
-		string nextIndentLevel = _linePrefix + "  ";
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::CYAN}) << _linePrefix << "Expected result:" << endl;
 		// TODO could compute a simple diff with highlighted lines
 		printIndented(_stream, m_expectation, nextIndentLevel);
@@ -74,6 +77,12 @@ TestCase::TestResult YulInterpreterTest::run(ostream& _stream, string const& _li
 		printIndented(_stream, m_obtainedResult, nextIndentLevel);
 		return TestResult::Failure;
 	}
+	if (jitResult != m_obtainedResult)
+	{
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Result of the code compiled by LLVM differs:" << endl;
+		printIndented(_stream, jitResult, nextIndentLevel);
+		return TestResult::Failure;
+	}
 	return TestResult::Success;
 }
 
@@ -104,28 +113,30 @@ bool YulInterpreterTest::parse(ostream& _stream, string const& _linePrefix, bool
 	);
 	if (stack.parseAndAnalyze("", m_source))
 	{
-		m_ast = stack.parserResult()->code;
-		m_analysisInfo = stack.parserResult()->analysisInfo;
+		m_object = stack.parserResult();
 		return true;
 	}
 	else
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Error parsing source." << endl;
-		printErrors(_stream, stack.errors());
+		printErrors(_stream, stack.errors(), stack.sourceRegistry());
 		return false;
 	}
 }
 
-string YulInterpreterTest::interpret()
+string YulInterpreterTest::interpret(bool _jit)
 {
 	InterpreterState state;
 	state.maxTraceSize = 10000;
 	state.maxSteps = 10000;
 	state.maxMemSize = 0x20000000;
-	Interpreter interpreter(state, EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{}));
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{});
 	try
 	{
-		interpreter(*m_ast);
+		if (_jit)
+			JIT(*m_object, dialect).run(state);
+		else
+			Interpreter(state, dialect)(*m_object->code);
 	}
 	catch (InterpreterTerminatedGeneric const&)
 	{
@@ -136,9 +147,9 @@ string YulInterpreterTest::interpret()
 	return result.str();
 }
 
-void YulInterpreterTest::printErrors(ostream& _stream, ErrorList const& _errors)
+void YulInterpreterTest::printErrors(ostream& _stream, ErrorList const& _errors, SourceRegistry const& _sources)
 {
-	SourceReferenceFormatter formatter(_stream);
+	SourceReferenceFormatter formatter(_stream, _sources);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
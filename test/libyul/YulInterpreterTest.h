@@ -23,13 +23,13 @@ namespace langutil
 {
 class Scanner;
 class Error;
+class SourceRegistry;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
 
 namespace yul
 {
-struct AsmAnalysisInfo;
-struct Block;
+struct Object;
 }
 
 namespace yul
@@ -55,15 +55,20 @@ public:
 private:
 	void printIndented(std::ostream& _stream, std::string const& _output, std::string const& _linePrefix = "") const;
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
-	std::string interpret();
+	/// Runs the code in the interpreter or, if @a _jit is set, compiled to native code by LLVM.
+	/// @returns the trace and the final state.
+	std::string interpret(bool _jit);
 
-	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
+	static void printErrors(
+		std::ostream& _stream,
+		langutil::ErrorList const& _errors,
+		langutil::SourceRegistry const& _sources
+	);
 
 	std::string m_source;
 	std::string m_expectation;
 
-	std::shared_ptr<Block> m_ast;
-	std::shared_ptr<AsmAnalysisInfo> m_analysisInfo;
+	std::shared_ptr<Object> m_object;
 	std::string m_obtainedResult;
 };
 
@@ -23,6 +23,7 @@ namespace langutil
 {
 class Scanner;
 class Error;
+class SourceRegistry;
 using ErrorList = std::vector<std::shared_ptr<Error const>>;
 }
 
@@ -59,7 +60,11 @@ private:
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
 	void disambiguate();
 
-	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
+	static void printErrors(
+		std::ostream& _stream,
+		langutil::ErrorList const& _errors,
+		langutil::SourceRegistry const& _sources
+	);
 
 	std::string m_source;
 	bool m_yul = false;
@@ -0,0 +1,205 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Compares the memory used by ASTs allocated on the heap and in an arena.
+ */
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace langutil;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Creates the annotation of every node, as the analysis would.
+class AnnotationCreator: public ASTConstVisitor
+{
+public:
+	size_t nodes = 0;
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		_node.annotation();
+		nodes++;
+		return true;
+	}
+};
+
+/// @returns the number of bytes currently allocated on the heap, including memory-mapped chunks.
+size_t heapUsage()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	auto info = mallinfo2();
+	return info.uordblks + info.hblkhd;
+#else
+	auto info = mallinfo();
+	return size_t(info.uordblks) + size_t(info.hblkhd);
+#endif
+}
+
+vector<string> collectSources(vector<string> const& _paths)
+{
+	vector<string> files;
+	for (auto const& path: _paths)
+		if (boost::filesystem::is_directory(path))
+		{
+			for (auto const& entry: boost::filesystem::recursive_directory_iterator(path))
+				if (boost::filesystem::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+					files.push_back(entry.path().string());
+		}
+		else
+			files.push_back(path);
+	sort(files.begin(), files.end());
+	return files;
+}
+
+struct Measurement
+{
+	size_t nodes = 0;
+	size_t bytes = 0;
+	double seconds = 0;
+};
+
+/// Parses all @a _sources and creates all annotations, keeping the ASTs alive until the
+/// memory is measured.
+Measurement measure(vector<string> const& _sources, bool _useArena)
+{
+	Measurement result;
+	size_t heapBefore = heapUsage();
+	auto start = chrono::steady_clock::now();
+
+	vector<shared_ptr<ASTArena>> arenas;
+	vector<ASTPointer<SourceUnit>> asts;
+	for (auto const& source: _sources)
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		auto scanner = make_shared<Scanner>(CharStream(source, ""));
+		shared_ptr<ASTArena> arena = _useArena ? ASTArena::create() : nullptr;
+		ASTPointer<SourceUnit> ast = Parser(errorReporter, EVMVersion(), false, arena).parse(scanner);
+		if (!ast)
+			continue;
+		AnnotationCreator creator;
+		ast->accept(creator);
+		result.nodes += creator.nodes;
+		asts.push_back(move(ast));
+		if (arena)
+			arenas.push_back(move(arena));
+	}
+
+	result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	result.bytes = heapUsage() - heapBefore;
+	return result;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(astbench, compares the memory used by ASTs allocated on the heap and in an arena.
+Usage: astbench [Options] [paths...]
+Parses all .sol files in the given files and directories (test/compilationTests
+by default) and creates the annotations of all nodes, once with all nodes on the
+heap and once with the nodes in an arena per source, and prints the memory used.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("input-path", po::value<vector<string>>(), "input file or directory");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<string> paths{"test/compilationTests"};
+	if (arguments.count("input-path"))
+		paths = arguments["input-path"].as<vector<string>>();
+	vector<string> files = collectSources(paths);
+	if (files.empty())
+	{
+		cerr << "No input files found." << endl;
+		return 1;
+	}
+
+	vector<string> sources;
+	size_t bytes = 0;
+	for (auto const& file: files)
+	{
+		sources.emplace_back(readFileAsString(file));
+		bytes += sources.back().size();
+	}
+
+	cout << files.size() << " files, " << bytes << " bytes" << endl;
+	for (bool useArena: {false, true})
+	{
+		Measurement measurement = measure(sources, useArena);
+		cout <<
+			(useArena ? "arena" : "heap") << ": " <<
+			measurement.nodes << " nodes, " <<
+			measurement.bytes / 1024 << " KiB, " <<
+			(double(measurement.bytes) / max<size_t>(measurement.nodes, 1)) << " bytes/node, " <<
+			(measurement.seconds * 1000) << " ms" <<
+			endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,134 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Measures the time the analysis spends on pathological constant expressions.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+string repeat(string const& _text, size_t _count, string const& _separator)
+{
+	string result;
+	for (size_t i = 0; i < _count; ++i)
+		result += (i == 0 ? "" : _separator) + _text;
+	return result;
+}
+
+struct Benchmark
+{
+	string name;
+	/// @returns the expression to analyse, scaled by @a _size.
+	function<string(size_t)> expression;
+};
+
+vector<Benchmark> const c_benchmarks{
+	{"huge decimal literals", [](size_t _size) {
+		string literal = "1" + string(_size * 1000, '0');
+		return literal + " * " + literal;
+	}},
+	{"huge hex literals", [](size_t _size) {
+		string literal = "0x" + string(_size * 1000, 'f');
+		return literal + " * " + literal;
+	}},
+	{"long fractional literals", [](size_t _size) {
+		return "0." + string(_size * 1000, '0') + "1 * 2";
+	}},
+	{"product chain", [](size_t _size) {
+		return repeat("(1 << 4000)", _size * 10, " * ");
+	}},
+	{"sum chain", [](size_t _size) {
+		return repeat("(2 ** 4000 - 1)", _size * 100, " + ");
+	}},
+	{"fractional powers", [](size_t _size) {
+		return repeat("((3 / 7) ** 512)", _size * 10, " * ");
+	}},
+	{"shift chain", [](size_t _size) {
+		return repeat("(", _size * 100, "") + "1" + repeat(" << 40) >> 20", _size * 100, "");
+	}},
+	{"exponent tower", [](size_t _size) {
+		return repeat("4", _size * 10, " ** ");
+	}}
+};
+
+/// @returns the number of seconds it takes to parse and analyse a contract using @a _expression.
+double measure(string const& _expression)
+{
+	string source = "contract C { function f() public pure { int a; a = " + _expression + "; } }";
+	auto start = chrono::steady_clock::now();
+	CompilerStack compiler;
+	compiler.setSources({{"", source}});
+	compiler.parseAndAnalyze();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(constbench, measures the time spent on pathological constant expressions.
+Usage: constbench [Options]
+Analyses contracts that evaluate expensive constant expressions and prints the
+time spent on each of them.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("size", po::value<size_t>()->default_value(10), "scale of the expressions");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	size_t size = arguments["size"].as<size_t>();
+	for (auto const& benchmark: c_benchmarks)
+		cout << benchmark.name << ": " << (measure(benchmark.expression(size)) * 1000) << " ms" << endl;
+
+	return 0;
+}
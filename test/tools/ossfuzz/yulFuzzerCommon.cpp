@@ -16,6 +16,8 @@
 */
 #include <test/tools/ossfuzz/yulFuzzerCommon.h>
 
+#include <libyul/Object.h>
+
 using namespace std;
 using namespace yul;
 using namespace yul::test::yul_fuzzer;
@@ -37,3 +39,21 @@ void yulFuzzerUtil::interpret(
 	interpreter(*_ast);
 	state.dumpTraceAndState(_os);
 }
+
+void yulFuzzerUtil::runJIT(
+	ostream& _os,
+	Object const& _object,
+	EVMDialect const& _dialect,
+	size_t _maxSteps,
+	size_t _maxTraceSize,
+	size_t _maxMemory
+)
+{
+	InterpreterState state;
+	state.maxTraceSize = _maxTraceSize;
+	state.maxSteps = _maxSteps;
+	state.maxMemSize = _maxMemory;
+	JIT jit(_object, _dialect);
+	jit.run(state);
+	state.dumpTraceAndState(_os);
+}
@@ -15,6 +15,7 @@
 	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/JIT.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
 namespace yul
@@ -33,6 +34,15 @@ struct yulFuzzerUtil
 		size_t _maxTraceSize = maxTraceSize,
 		size_t _maxMemory = maxMemory
 	);
+	/// Like interpret, but runs the code of @a _object compiled to native code by LLVM.
+	static void runJIT(
+		std::ostream& _os,
+		Object const& _object,
+		EVMDialect const& _dialect,
+		size_t _maxSteps = maxSteps,
+		size_t _maxTraceSize = maxTraceSize,
+		size_t _maxMemory = maxMemory
+	);
 	static size_t constexpr maxSteps = 100;
 	static size_t constexpr maxTraceSize = 75;
 	static size_t constexpr maxMemory = 0x200;
@@ -74,15 +74,24 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 		return;
 	}
 
+	// With libFuzzer binary run this to execute the code compiled to native code
+	// instead of interpreting it:
+	// PROTO_FUZZER_JIT=1 ./a.out proto-input
+	bool const useJIT = getenv("PROTO_FUZZER_JIT");
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion());
+	auto execute = [&](ostream& _os, size_t _maxSteps)
+	{
+		if (useJIT)
+			yulFuzzerUtil::runJIT(_os, *stack.parserResult(), dialect, _maxSteps);
+		else
+			yulFuzzerUtil::interpret(_os, stack.parserResult()->code, dialect, _maxSteps);
+	};
+
 	ostringstream os1;
 	ostringstream os2;
 	try
 	{
-		yulFuzzerUtil::interpret(
-			os1,
-			stack.parserResult()->code,
-			EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion())
-		);
+		execute(os1, yulFuzzerUtil::maxSteps);
 	}
 	catch (yul::test::StepLimitReached const&)
 	{
@@ -95,12 +104,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	stack.optimize();
 	try
 	{
-		yulFuzzerUtil::interpret(
-			os2,
-			stack.parserResult()->code,
-			EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion()),
-			(yul::test::yul_fuzzer::yulFuzzerUtil::maxSteps * 1.5)
-		);
+		execute(os2, yulFuzzerUtil::maxSteps * 1.5);
 	}
 	catch (yul::test::InterpreterTerminatedGeneric const&)
 	{
@@ -0,0 +1,171 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Measures the throughput of the Solidity scanner.
+ */
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace langutil;
+using namespace dev;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Scans the whole stream and @returns the number of tokens.
+/// Also fills @a o_tokens with a textual representation of all tokens if given.
+size_t scan(CharStream _stream, vector<string>* o_tokens = nullptr)
+{
+	size_t tokens = 0;
+	Scanner scanner(std::move(_stream));
+	for (Token token = scanner.currentToken(); token != Token::EOS; token = scanner.next())
+	{
+		tokens++;
+		if (o_tokens)
+			o_tokens->emplace_back(
+				to_string(static_cast<int>(token)) + " " +
+				to_string(scanner.currentLocation().start) + " " +
+				scanner.currentLiteral() + " " +
+				scanner.currentCommentLiteral()
+			);
+	}
+	return tokens;
+}
+
+vector<string> collectSources(vector<string> const& _paths)
+{
+	vector<string> files;
+	for (auto const& path: _paths)
+		if (boost::filesystem::is_directory(path))
+		{
+			for (auto const& entry: boost::filesystem::recursive_directory_iterator(path))
+				if (boost::filesystem::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+					files.push_back(entry.path().string());
+		}
+		else
+			files.push_back(path);
+	sort(files.begin(), files.end());
+	return files;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(scannerbench, measures the throughput of the Solidity scanner.
+Usage: scannerbench [Options] [paths...]
+Scans all .sol files in the given files and directories (test/compilationTests
+by default), once from memory and once from memory-mapped files, checks that
+both produce the same tokens and prints the throughput.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repetitions", po::value<size_t>()->default_value(20), "Number of times each source is scanned.")
+		("input-path", po::value<vector<string>>(), "input file or directory");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<string> paths{"test/compilationTests"};
+	if (arguments.count("input-path"))
+		paths = arguments["input-path"].as<vector<string>>();
+	vector<string> files = collectSources(paths);
+	if (files.empty())
+	{
+		cerr << "No input files found." << endl;
+		return 1;
+	}
+	size_t repetitions = arguments["repetitions"].as<size_t>();
+
+	vector<CharStream> inMemory;
+	vector<CharStream> mapped;
+	size_t bytes = 0;
+	for (auto const& file: files)
+	{
+		inMemory.emplace_back(readFileAsString(file), file);
+		mapped.emplace_back(CharStream::fromFile(file, file));
+		bytes += inMemory.back().size();
+
+		vector<string> tokensInMemory;
+		vector<string> tokensMapped;
+		scan(inMemory.back(), &tokensInMemory);
+		scan(mapped.back(), &tokensMapped);
+		if (tokensInMemory != tokensMapped)
+		{
+			cerr << "Token mismatch in " << file << endl;
+			return 1;
+		}
+	}
+
+	auto measure = [&](vector<CharStream> const& _streams, string const& _name)
+	{
+		size_t tokens = 0;
+		auto start = chrono::steady_clock::now();
+		for (size_t i = 0; i < repetitions; ++i)
+			for (auto const& stream: _streams)
+				tokens += scan(stream);
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		cout <<
+			_name << ": " <<
+			(double(bytes) * repetitions / seconds / 1024 / 1024) << " MiB/s, " <<
+			(double(tokens) / seconds / 1000000) << " million tokens/s" <<
+			endl;
+	};
+
+	cout << files.size() << " files, " << bytes << " bytes, " << repetitions << " repetitions" << endl;
+	measure(inMemory, "in memory");
+	measure(mapped, "memory-mapped");
+
+	return 0;
+}
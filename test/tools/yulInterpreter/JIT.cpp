@@ -0,0 +1,317 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Execution of Yul code compiled to native code by the LLVM IR backend.
+ */
+
+#include <test/tools/yulInterpreter/JIT.h>
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+
+#include <libyul/backends/llvmir/LLVMIRObjectCompiler.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/Object.h>
+#include <libyul/Exceptions.h>
+
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+using namespace yul::test;
+
+namespace
+{
+
+template <class T>
+T checked(llvm::Expected<T> _value)
+{
+	if (!_value)
+		yulAssert(false, "LLVM JIT error: " + llvm::toString(_value.takeError()));
+	return move(*_value);
+}
+
+void checked(llvm::Error _error)
+{
+	if (_error)
+		yulAssert(false, "LLVM JIT error: " + llvm::toString(move(_error)));
+}
+
+/// @returns a constant pointer of type @a _type to the host function or object at @a _address.
+llvm::Constant* hostPointer(uintptr_t _address, llvm::Type* _type)
+{
+	return llvm::ConstantExpr::getIntToPtr(
+		llvm::ConstantInt::get(llvm::Type::getInt64Ty(_type->getContext()), _address),
+		_type
+	);
+}
+
+}
+
+JIT::JIT(Object const& _object, EVMDialect const& _dialect):
+	m_dialect(_dialect)
+{
+	llvm::InitializeNativeTarget();
+	llvm::InitializeNativeTargetAsmPrinter();
+
+	m_jit = checked(llvm::orc::LLJITBuilder().create());
+	m_littleEndian = m_jit->getDataLayout().isLittleEndian();
+	// The generated code might call library functions like memset.
+	m_jit->getMainJITDylib().addGenerator(checked(
+		llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(m_jit->getDataLayout().getGlobalPrefix())
+	));
+
+	auto context = make_unique<llvm::LLVMContext>();
+	unique_ptr<llvm::Module> module = LLVMIRObjectCompiler::compileModule(*context, _object, _dialect, false, true);
+	module->setDataLayout(m_jit->getDataLayout());
+	module->setTargetTriple(m_jit->getTargetTriple().str());
+
+	// The host functions are defined before optimising, such that the calls to them can be inlined.
+	defineExternalFunctions(*module);
+	LLVMIRObjectCompiler::optimise(*module);
+	replaceWideDivisions(*module);
+
+	checked(m_jit->addIRModule(llvm::orc::ThreadSafeModule(move(module), move(context))));
+	m_main = reinterpret_cast<void (*)()>(checked(m_jit->lookup("main")).getAddress());
+}
+
+JIT::~JIT() = default;
+
+void JIT::run(InterpreterState& _state)
+{
+	m_state = &_state;
+	m_exception = nullptr;
+	// The host jumps back here if it has to terminate the execution. The compiled code
+	// does not have to be unwound, since it does not own any resources.
+	if (!setjmp(m_exit))
+		m_main();
+	m_state = nullptr;
+	if (m_exception)
+		rethrow_exception(m_exception);
+}
+
+void JIT::defineExternalFunctions(llvm::Module& _module)
+{
+	llvm::LLVMContext& context = _module.getContext();
+	llvm::Type* bytePointer = llvm::Type::getInt8PtrTy(context);
+	llvm::Type* int64 = llvm::Type::getInt64Ty(context);
+	llvm::Constant* jit = hostPointer(reinterpret_cast<uintptr_t>(this), bytePointer);
+
+	for (llvm::Function& function: _module)
+	{
+		if (!function.isDeclaration())
+			continue;
+		string name = function.getName().str();
+		llvm::IRBuilder<> builder(llvm::BasicBlock::Create(context, "entry", &function));
+
+		if (name == "yul.step")
+		{
+			llvm::FunctionType* type = llvm::FunctionType::get(builder.getVoidTy(), {bytePointer}, false);
+			builder.CreateCall(type, hostPointer(reinterpret_cast<uintptr_t>(&callStep), type->getPointerTo()), {jit});
+		}
+		else
+		{
+			yulAssert(name.substr(0, 4) == "evm.", "Unsupported external function: " + name);
+			BuiltinFunctionForEVM const* builtin = m_dialect.builtin(YulString{name.substr(4)});
+			yulAssert(builtin, "Unknown builtin: " + name);
+
+			// The arguments and the result are passed as an array of pointers.
+			llvm::Value* arguments = builder.CreateAlloca(
+				bytePointer,
+				llvm::ConstantInt::get(int64, max<size_t>(function.arg_size(), 1))
+			);
+			for (llvm::Argument& argument: function.args())
+				builder.CreateStore(
+					builder.CreateBitCast(&argument, bytePointer),
+					builder.CreateConstGEP1_64(bytePointer, arguments, argument.getArgNo())
+				);
+
+			llvm::FunctionType* type = llvm::FunctionType::get(
+				builder.getVoidTy(),
+				{bytePointer, int64, bytePointer->getPointerTo()},
+				false
+			);
+			builder.CreateCall(
+				type,
+				hostPointer(reinterpret_cast<uintptr_t>(&callBuiltin), type->getPointerTo()),
+				{jit, llvm::ConstantInt::get(int64, m_builtins.size()), arguments}
+			);
+			m_builtins.emplace_back(Builtin{builtin, function.doesNotReturn()});
+		}
+
+		if (function.doesNotReturn())
+			builder.CreateUnreachable();
+		else
+			builder.CreateRetVoid();
+		function.setLinkage(llvm::Function::InternalLinkage);
+	}
+}
+
+void JIT::replaceWideDivisions(llvm::Module& _module)
+{
+	llvm::LLVMContext& context = _module.getContext();
+	llvm::Type* bytePointer = llvm::Type::getInt8PtrTy(context);
+	llvm::Type* int64 = llvm::Type::getInt64Ty(context);
+	llvm::FunctionType* type = llvm::FunctionType::get(
+		llvm::Type::getVoidTy(context),
+		{bytePointer, int64, int64, bytePointer, bytePointer, bytePointer},
+		false
+	);
+	llvm::Constant* divide = hostPointer(reinterpret_cast<uintptr_t>(&callDivision), type->getPointerTo());
+
+	for (llvm::Function& function: _module)
+	{
+		vector<llvm::BinaryOperator*> divisions;
+		for (llvm::Instruction& instruction: llvm::instructions(function))
+			if (auto binaryOperator = llvm::dyn_cast<llvm::BinaryOperator>(&instruction))
+				if (
+					binaryOperator->getType()->isIntegerTy() &&
+					binaryOperator->getType()->getIntegerBitWidth() > 128 &&
+					(binaryOperator->getOpcode() == llvm::Instruction::UDiv ||
+					binaryOperator->getOpcode() == llvm::Instruction::URem ||
+					binaryOperator->getOpcode() == llvm::Instruction::SDiv ||
+					binaryOperator->getOpcode() == llvm::Instruction::SRem)
+				)
+					divisions.emplace_back(binaryOperator);
+
+		for (llvm::BinaryOperator* division: divisions)
+		{
+			llvm::Type* operandType = division->getType();
+			llvm::IRBuilder<> entryBuilder(&function.getEntryBlock(), function.getEntryBlock().begin());
+			llvm::Value* a = entryBuilder.CreateAlloca(operandType);
+			llvm::Value* b = entryBuilder.CreateAlloca(operandType);
+			llvm::Value* result = entryBuilder.CreateAlloca(operandType);
+
+			llvm::IRBuilder<> builder(division);
+			builder.CreateStore(division->getOperand(0), a);
+			builder.CreateStore(division->getOperand(1), b);
+			builder.CreateCall(type, divide, {
+				hostPointer(reinterpret_cast<uintptr_t>(this), bytePointer),
+				llvm::ConstantInt::get(int64, division->getOpcode()),
+				llvm::ConstantInt::get(int64, operandType->getIntegerBitWidth()),
+				builder.CreateBitCast(a, bytePointer),
+				builder.CreateBitCast(b, bytePointer),
+				builder.CreateBitCast(result, bytePointer)
+			});
+			division->replaceAllUsesWith(builder.CreateLoad(operandType, result));
+			division->eraseFromParent();
+		}
+	}
+}
+
+void JIT::callBuiltin(JIT* _jit, uint64_t _index, uint8_t** _arguments)
+{
+	if (!_jit->evalBuiltin(_index, _arguments))
+		longjmp(_jit->m_exit, 1);
+}
+
+void JIT::callStep(JIT* _jit)
+{
+	if (!_jit->step())
+		longjmp(_jit->m_exit, 1);
+}
+
+void JIT::callDivision(JIT* _jit, uint64_t _opcode, uint64_t _bits, uint8_t* _a, uint8_t* _b, uint8_t* _result)
+{
+	_jit->divide(_opcode, _bits, _a, _b, _result);
+}
+
+bool JIT::evalBuiltin(uint64_t _index, uint8_t** _arguments)
+{
+	try
+	{
+		Builtin const& builtin = m_builtins.at(_index);
+		vector<u256> arguments;
+		for (size_t i = 0; i < builtin.function->parameters.size(); ++i)
+			arguments.emplace_back(load(_arguments[i], 32));
+		u256 result = EVMInstructionInterpreter(*m_state).evalBuiltin(*builtin.function, arguments);
+		if (!builtin.function->returns.empty())
+			store(result, _arguments[arguments.size()], 32);
+		if (builtin.terminates)
+			BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
+	}
+	catch (...)
+	{
+		m_exception = current_exception();
+		return false;
+	}
+	return true;
+}
+
+bool JIT::step()
+{
+	// Identical to the step counting of the interpreter when entering a block.
+	m_state->numSteps++;
+	if (m_state->maxSteps > 0 && m_state->numSteps >= m_state->maxSteps)
+	{
+		m_state->trace.emplace_back("Interpreter execution step limit reached.");
+		m_exception = make_exception_ptr(StepLimitReached());
+		return false;
+	}
+	return true;
+}
+
+void JIT::divide(uint64_t _opcode, uint64_t _bits, uint8_t const* _a, uint8_t const* _b, uint8_t* _result) const
+{
+	size_t size = _bits / 8;
+	bigint modulus = bigint(1) << _bits;
+	bigint a = load(_a, size);
+	bigint b = load(_b, size);
+	bool isSigned = _opcode == llvm::Instruction::SDiv || _opcode == llvm::Instruction::SRem;
+	if (isSigned)
+	{
+		if (a >= modulus / 2)
+			a -= modulus;
+		if (b >= modulus / 2)
+			b -= modulus;
+	}
+
+	// The compiled code never divides by zero, but the host should not fail if it does.
+	bigint result;
+	// Like LLVM, boost rounds towards zero and the remainder has the sign of the dividend.
+	if (b == 0)
+		result = 0;
+	else if (_opcode == llvm::Instruction::UDiv || _opcode == llvm::Instruction::SDiv)
+		result = a / b;
+	else
+		result = a % b;
+	if (result < 0)
+		result += modulus;
+	store(result % modulus, _result, size);
+}
+
+bigint JIT::load(uint8_t const* _data, size_t _bytes) const
+{
+	bytes data(_data, _data + _bytes);
+	if (m_littleEndian)
+		reverse(data.begin(), data.end());
+	return fromBigEndian<bigint>(data);
+}
+
+void JIT::store(bigint _value, uint8_t* _data, size_t _bytes) const
+{
+	bytes data(_bytes);
+	toBigEndian(_value, data);
+	if (m_littleEndian)
+		reverse(data.begin(), data.end());
+	copy(data.begin(), data.end(), _data);
+}
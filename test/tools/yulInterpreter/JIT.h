@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Execution of Yul code compiled to native code by the LLVM IR backend.
+ */
+
+#pragma once
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <csetjmp>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace llvm
+{
+class Module;
+namespace orc
+{
+class LLJIT;
+}
+}
+
+namespace yul
+{
+struct Object;
+struct EVMDialect;
+struct BuiltinFunctionForEVM;
+
+namespace test
+{
+
+/**
+ * Compiles the code of a Yul object to native code and executes it on an InterpreterState.
+ *
+ * The results are identical to those of the Yul interpreter, including the step limit,
+ * since the builtins that are not translated to instructions by the LLVM IR backend are
+ * evaluated by EVMInstructionInterpreter.
+ */
+class JIT: boost::noncopyable
+{
+public:
+	/// Compiles the code of @a _object (without its sub-objects), optimised by LLVM.
+	JIT(Object const& _object, EVMDialect const& _dialect);
+	~JIT();
+
+	/// Executes the code on @a _state.
+	/// Throws the same exceptions as the interpreter if the execution is terminated.
+	void run(InterpreterState& _state);
+
+private:
+	/// Adds bodies to the declarations of the builtins and of "yul.step" that call the host.
+	void defineExternalFunctions(llvm::Module& _module);
+	/// Replaces divisions that are too wide for the code generator of LLVM by calls to the host.
+	void replaceWideDivisions(llvm::Module& _module);
+
+	/// Called by the compiled code, these terminate the execution by a long jump
+	/// if the host raised an exception.
+	static void callBuiltin(JIT* _jit, uint64_t _index, uint8_t** _arguments);
+	static void callStep(JIT* _jit);
+	static void callDivision(JIT* _jit, uint64_t _opcode, uint64_t _bits, uint8_t* _a, uint8_t* _b, uint8_t* _result);
+
+	/// @returns false if the execution has to be terminated.
+	bool evalBuiltin(uint64_t _index, uint8_t** _arguments);
+	bool step();
+	void divide(uint64_t _opcode, uint64_t _bits, uint8_t const* _a, uint8_t const* _b, uint8_t* _result) const;
+
+	/// Conversion between integers and their representation in the memory of the compiled code.
+	dev::bigint load(uint8_t const* _data, size_t _bytes) const;
+	void store(dev::bigint _value, uint8_t* _data, size_t _bytes) const;
+
+	struct Builtin
+	{
+		BuiltinFunctionForEVM const* function;
+		bool terminates;
+	};
+
+	EVMDialect const& m_dialect;
+	std::unique_ptr<llvm::orc::LLJIT> m_jit;
+	void (*m_main)() = nullptr;
+	bool m_littleEndian = true;
+	std::vector<Builtin> m_builtins;
+
+	InterpreterState* m_state = nullptr;
+	std::exception_ptr m_exception;
+	std::jmp_buf m_exit;
+};
+
+}
+}
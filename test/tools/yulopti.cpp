@@ -80,7 +80,7 @@ class YulOpti
 public:
 	void printErrors()
 	{
-		SourceReferenceFormatter formatter(cout);
+		SourceReferenceFormatter formatter(cout, m_sources);
 
 		for (auto const& error: m_errors)
 			formatter.printErrorInformation(*error);
@@ -90,6 +90,7 @@ public:
 	{
 		ErrorReporter errorReporter(m_errors);
 		shared_ptr<Scanner> scanner = make_shared<Scanner>(CharStream(_input, ""));
+		m_sources = SourceRegistry(scanner->charStream());
 		m_ast = yul::Parser(errorReporter, m_dialect).parse(scanner, false);
 		if (!m_ast || !errorReporter.errors().empty())
 		{
@@ -223,6 +224,7 @@ public:
 
 private:
 	ErrorList m_errors;
+	SourceRegistry m_sources;
 	shared_ptr<yul::Block> m_ast;
 	Dialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
 	shared_ptr<AsmAnalysisInfo> m_analysisInfo;
@@ -19,6 +19,7 @@
  */
 
 #include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/JIT.h>
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmParser.h>
@@ -26,6 +27,7 @@
 #include <libyul/Dialect.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
 
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/ErrorReporter.h>
@@ -52,13 +54,13 @@ namespace po = boost::program_options;
 namespace
 {
 
-void printErrors(ErrorList const& _errors)
+void printErrors(ErrorList const& _errors, SourceRegistry const& _sources)
 {
 	for (auto const& error: _errors)
-		SourceReferenceFormatter(cout).printErrorInformation(*error);
+		SourceReferenceFormatter(cout, _sources).printErrorInformation(*error);
 }
 
-pair<shared_ptr<Block>, shared_ptr<AsmAnalysisInfo>> parse(string const& _source)
+shared_ptr<Object> parse(string const& _source)
 {
 	AssemblyStack stack(
 		langutil::EVMVersion(),
@@ -68,31 +70,31 @@ pair<shared_ptr<Block>, shared_ptr<AsmAnalysisInfo>> parse(string const& _source
 	if (stack.parseAndAnalyze("--INPUT--", _source))
 	{
 		yulAssert(stack.errors().empty(), "Parsed successfully but had errors.");
-		return make_pair(stack.parserResult()->code, stack.parserResult()->analysisInfo);
+		return stack.parserResult();
 	}
 	else
 	{
-		printErrors(stack.errors());
+		printErrors(stack.errors(), stack.sourceRegistry());
 		return {};
 	}
 }
 
-void interpret(string const& _source)
+void interpret(string const& _source, bool _jit)
 {
-	shared_ptr<Block> ast;
-	shared_ptr<AsmAnalysisInfo> analysisInfo;
-	tie(ast, analysisInfo) = parse(_source);
-	if (!ast || !analysisInfo)
+	shared_ptr<Object> object = parse(_source);
+	if (!object || !object->code || !object->analysisInfo)
 		return;
 
 	InterpreterState state;
 	state.maxTraceSize = 10000;
 	state.maxMemSize = 0x20000000;
-	Dialect const& dialect(EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{}));
-	Interpreter interpreter(state, dialect);
+	EVMDialect const& dialect(EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{}));
 	try
 	{
-		interpreter(*ast);
+		if (_jit)
+			JIT(*object, dialect).run(state);
+		else
+			Interpreter(state, dialect)(*object->code);
 	}
 	catch (InterpreterTerminatedGeneric const&)
 	{
@@ -115,6 +117,7 @@ Allowed options)",
 		po::options_description::m_default_line_length - 23);
 	options.add_options()
 		("help", "Show this help screen.")
+		("jit", "Compile the source to native code using LLVM and run it instead of interpreting it.")
 		("input-file", po::value<vector<string>>(), "input file");
 	po::positional_options_description filesPositions;
 	filesPositions.add("input-file", -1);
@@ -144,7 +147,7 @@ Allowed options)",
 		else
 			input = readStandardInput();
 
-		interpret(input);
+		interpret(input, arguments.count("jit"));
 	}
 
 	return 0;